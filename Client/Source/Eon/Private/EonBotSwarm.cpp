@@ -0,0 +1,320 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "EonBotSwarm.h"
+#include "Engine/GameInstance.h"
+
+namespace
+{
+	// Circle each bot walks, in centimetres; bots are spread around it by phase
+	constexpr float BotCircleRadius = 2000.0f;
+	constexpr float BotAngularSpeed = 0.5f;
+	const TCHAR* const BotConsumable = TEXT("health_potion");
+}
+
+FString FEonBotSwarmReport::ToString() const
+{
+	return FString::Printf(TEXT("%.1fs, %d/%d bots connected, %d in instance: %.0f calls/s, %.0f transactions/s, RTT mean %.1f / max %.1f ms; ")
+		TEXT("per client %.1f msgs/s, %.1f player rows/s, %.1f KB/s in, decode %.3f ms/s (%.1f us/msg)"),
+		Seconds, NumConnected, NumBots, NumInInstance, CallsPerSecond, TransactionsPerSecond, MeanRttMs, MaxRttMs,
+		MessagesInPerClientPerSecond, PlayerRowsPerClientPerSecond, BytesInPerClientPerSecond / 1024.0,
+		DecodeMsPerClientPerSecond, DecodeMicrosPerMessage);
+}
+
+FEonBotSwarm::FEonBotSwarm(const FEonBotSwarmConfig& InConfig)
+	: Config(InConfig)
+	, Random(InConfig.Seed)
+{
+	Config.NumBots = FMath::Max(Config.NumBots, 1);
+	Config.Connection.bUseNetworkThread = false;
+	if (Config.InstanceId != 0)
+	{
+		TargetInstance = Config.InstanceId;
+	}
+}
+
+FEonBotSwarm::~FEonBotSwarm()
+{
+	Stop();
+}
+
+void FEonBotSwarm::Start()
+{
+	Stop();
+
+	GameInstance.Reset(NewObject<UGameInstance>(GetTransientPackage()));
+	Bots.SetNum(Config.NumBots);
+	for (int32 i = 0; i < Bots.Num(); ++i)
+	{
+		FBot& Bot = Bots[i];
+		Bot.Manager.Reset(NewObject<USpaceTimeDBManager>(GameInstance.Get()));
+		Bot.Phase = 2.0f * PI * i / Bots.Num();
+
+		if (TransportFactory)
+		{
+			Bot.Manager->SetTransportFactory([this, i](const FSpaceTimeDBTransportParams& Params)
+			{
+				return TransportFactory(i, Params);
+			});
+		}
+		Bot.Manager->OnServerMessage.AddRaw(this, &FEonBotSwarm::HandleServerMessage, i);
+	}
+
+	Now = 0.0;
+	ConnectBudget = 1.0;
+	NextBotToConnect = 0;
+	CallsIssued = 0;
+	IntervalStart = FTotals();
+
+	UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Bot swarm starting %d bots against %s/%s"),
+		Bots.Num(), *USpaceTimeDBManager::ResolveHost(Config.Connection.Host), *Config.Connection.ModuleName);
+}
+
+void FEonBotSwarm::Stop()
+{
+	for (FBot& Bot : Bots)
+	{
+		if (Bot.Manager.IsValid())
+		{
+			Bot.Manager->OnServerMessage.RemoveAll(this);
+			Bot.Manager->Disconnect();
+		}
+	}
+	Bots.Reset();
+	GameInstance.Reset();
+}
+
+void FEonBotSwarm::Tick(float DeltaTime)
+{
+	Now += DeltaTime;
+
+	// Ramp connections up rather than opening every socket in one frame
+	ConnectBudget += DeltaTime * Config.ConnectsPerSecond;
+	while (NextBotToConnect < Bots.Num() && ConnectBudget >= 1.0)
+	{
+		ConnectBudget -= 1.0;
+		ConnectBot(NextBotToConnect++);
+	}
+
+	for (int32 i = 0; i < NextBotToConnect; ++i)
+	{
+		TickBot(i);
+	}
+}
+
+void FEonBotSwarm::ConnectBot(int32 BotIndex)
+{
+	FBot& Bot = Bots[BotIndex];
+	Bot.State = EBotState::Connecting;
+	Bot.StateSince = Now;
+	Bot.Manager->Connect(Config.Connection);
+}
+
+void FEonBotSwarm::TickBot(int32 BotIndex)
+{
+	FBot& Bot = Bots[BotIndex];
+	USpaceTimeDBManager& Manager = *Bot.Manager;
+
+	// A reconnect hands out a new identity, so the bot starts over
+	if (Bot.State != EBotState::Connecting && !Manager.GetIdentity().IsValid())
+	{
+		Bot.State = EBotState::Connecting;
+		Bot.StateSince = Now;
+		Bot.Consumables.Reset();
+	}
+
+	switch (Bot.State)
+	{
+	case EBotState::Idle:
+		break;
+
+	case EBotState::Connecting:
+		if (Manager.GetIdentity().IsValid())
+		{
+			Manager.RegisterPlayer(FString::Printf(TEXT("bot_%04d"), BotIndex));
+			++CallsIssued;
+			if (!TargetInstance.IsSet() && !bCreatedInstance && BotIndex == 0)
+			{
+				Manager.CreateInstance(Config.InstanceName, Config.NumBots, true);
+				++CallsIssued;
+				bCreatedInstance = true;
+			}
+			Bot.State = EBotState::Joining;
+			// Join on the next tick that knows the instance
+			Bot.StateSince = Now - Config.JoinRetrySeconds;
+		}
+		break;
+
+	case EBotState::Joining:
+		if (Manager.IsInInstance())
+		{
+			Bot.State = EBotState::Running;
+			Bot.StateSince = Now;
+			Bot.NextPositionAt = Now;
+			Bot.NextActionAt = Now + Random.FRandRange(0.0f, FMath::Max(Config.ActionInterval, 0.0f));
+		}
+		else if (TargetInstance.IsSet() && Now - Bot.StateSince >= Config.JoinRetrySeconds)
+		{
+			Manager.JoinInstance(static_cast<int64>(TargetInstance.GetValue()));
+			++CallsIssued;
+			Bot.StateSince = Now;
+		}
+		break;
+
+	case EBotState::Running:
+		if (Config.PositionHz > 0.0f && Now >= Bot.NextPositionAt)
+		{
+			const float Angle = Bot.Phase + static_cast<float>(Now) * BotAngularSpeed;
+			const FVector Position(FMath::Cos(Angle) * BotCircleRadius, FMath::Sin(Angle) * BotCircleRadius, 0.0f);
+			const FRotator Rotation(0.0f, FMath::RadiansToDegrees(Angle) + 90.0f, 0.0f);
+			Manager.UpdatePlayerPosition(Position, Rotation);
+			++CallsIssued;
+
+			// Keep the cadence without bursting to catch up after a slow frame
+			Bot.NextPositionAt = FMath::Max(Bot.NextPositionAt + 1.0 / Config.PositionHz, Now);
+		}
+
+		if (Config.ActionInterval > 0.0f && Now >= Bot.NextActionAt)
+		{
+			// Alternate inventory and interactable work; use up what we have before adding more
+			if (Bot.NumActions++ % 2 == 1 && Interactables.Num() > 0)
+			{
+				Manager.ToggleInteractable(Interactables[Random.RandHelper(Interactables.Num())]);
+			}
+			else if (Bot.Consumables.Num() > 0)
+			{
+				Manager.UseConsumable(static_cast<int64>(Bot.Consumables[Random.RandHelper(Bot.Consumables.Num())]));
+			}
+			else
+			{
+				Manager.AddItemToInventory(BotConsumable, 1);
+			}
+			++CallsIssued;
+			Bot.NextActionAt = Now + Config.ActionInterval;
+		}
+		break;
+	}
+}
+
+void FEonBotSwarm::HandleServerMessage(const FSpaceTimeDBServerMessage& Message, int32 BotIndex)
+{
+	FBot& Bot = Bots[BotIndex];
+
+	if (!TargetInstance.IsSet())
+	{
+		for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBInstanceRow>& Update : Message.Instances)
+		{
+			if (Update.Op == ESpaceTimeDBRowOp::Upsert && Update.Row.Name.Equals(Config.InstanceName, ESearchCase::CaseSensitive))
+			{
+				TargetInstance = Update.Row.InstanceId;
+				UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Bot swarm using instance %llu (%s)"), Update.Row.InstanceId, *Update.Row.Name);
+				break;
+			}
+		}
+	}
+
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBInteractableRow>& Update : Message.Interactables)
+	{
+		if (Update.Op == ESpaceTimeDBRowOp::Delete)
+		{
+			Interactables.Remove(Update.Row.InteractableId);
+		}
+		else
+		{
+			Interactables.AddUnique(Update.Row.InteractableId);
+		}
+	}
+
+	// The inventory subscription only carries our own rows
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>& Update : Message.InventoryItems)
+	{
+		if (Update.Op == ESpaceTimeDBRowOp::Delete || Update.Row.Quantity == 0)
+		{
+			Bot.Consumables.Remove(Update.Row.EntryId);
+		}
+		else if (Update.Row.ItemId == BotConsumable)
+		{
+			Bot.Consumables.AddUnique(Update.Row.EntryId);
+		}
+	}
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+FEonBotSwarm::FTotals FEonBotSwarm::GatherTotals() const
+{
+	FTotals Totals;
+	Totals.Seconds = Now;
+	Totals.Calls = CallsIssued;
+	for (const FBot& Bot : Bots)
+	{
+		const FSpaceTimeDBNetStats Stats = Bot.Manager->GetNetStats();
+		Totals.Transactions += Stats.RttSamples;
+		Totals.MessagesIn += Stats.TotalMessagesIn;
+		Totals.BytesIn += Stats.TotalBytesIn;
+		Totals.PlayerRows += Stats.TableRowUpdates.FindRef(FSpaceTimeDBPlayerRow::TableName);
+		Totals.DecodeMs += Stats.TotalDecodeMs;
+	}
+	return Totals;
+}
+
+FEonBotSwarmReport FEonBotSwarm::MakeReport(const FTotals& From, const FTotals& To) const
+{
+	FEonBotSwarmReport Report;
+	Report.Seconds = To.Seconds - From.Seconds;
+	Report.NumBots = Bots.Num();
+
+	double RttSum = 0.0;
+	int32 RttBots = 0;
+	for (const FBot& Bot : Bots)
+	{
+		if (!Bot.Manager->IsConnected())
+		{
+			continue;
+		}
+		++Report.NumConnected;
+		Report.NumInInstance += Bot.Manager->IsInInstance() ? 1 : 0;
+
+		const FSpaceTimeDBNetStats Stats = Bot.Manager->GetNetStats();
+		if (Stats.RttSamples > 0)
+		{
+			RttSum += Stats.SmoothedRttMs;
+			++RttBots;
+			Report.MaxRttMs = FMath::Max<double>(Report.MaxRttMs, Stats.MaxRttMs);
+		}
+	}
+	Report.MeanRttMs = RttBots > 0 ? RttSum / RttBots : 0.0;
+
+	if (Report.Seconds <= 0.0)
+	{
+		return Report;
+	}
+
+	const double PerSecond = 1.0 / Report.Seconds;
+	const double PerClientPerSecond = PerSecond / FMath::Max(Report.NumConnected, 1);
+	const int64 MessagesIn = To.MessagesIn - From.MessagesIn;
+	const double DecodeMs = To.DecodeMs - From.DecodeMs;
+
+	Report.CallsPerSecond = (To.Calls - From.Calls) * PerSecond;
+	Report.TransactionsPerSecond = (To.Transactions - From.Transactions) * PerSecond;
+	Report.MessagesInPerClientPerSecond = MessagesIn * PerClientPerSecond;
+	Report.PlayerRowsPerClientPerSecond = (To.PlayerRows - From.PlayerRows) * PerClientPerSecond;
+	Report.BytesInPerClientPerSecond = (To.BytesIn - From.BytesIn) * PerClientPerSecond;
+	Report.DecodeMsPerClientPerSecond = DecodeMs * PerClientPerSecond;
+	Report.DecodeMicrosPerMessage = MessagesIn > 0 ? DecodeMs * 1000.0 / MessagesIn : 0.0;
+	return Report;
+}
+
+FEonBotSwarmReport FEonBotSwarm::TakeIntervalReport()
+{
+	const FTotals Totals = GatherTotals();
+	const FEonBotSwarmReport Report = MakeReport(IntervalStart, Totals);
+	IntervalStart = Totals;
+	return Report;
+}
+
+FEonBotSwarmReport FEonBotSwarm::GetTotalReport() const
+{
+	return MakeReport(FTotals(), GatherTotals());
+}
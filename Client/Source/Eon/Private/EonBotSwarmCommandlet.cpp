@@ -0,0 +1,99 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "EonBotSwarmCommandlet.h"
+#include "EonBotSwarm.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+	// The swarm and the managers are ticked at this rate
+	constexpr double BotSwarmFrameSeconds = 1.0 / 60.0;
+
+	void PumpGameThread(float DeltaTime)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+	}
+}
+
+UEonBotSwarmCommandlet::UEonBotSwarmCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UEonBotSwarmCommandlet::Main(const FString& Params)
+{
+	FEonBotSwarmConfig Config;
+	float Seconds = 60.0f;
+	float ReportInterval = 5.0f;
+
+	FParse::Value(*Params, TEXT("Bots="), Config.NumBots);
+	FParse::Value(*Params, TEXT("Seconds="), Seconds);
+	FParse::Value(*Params, TEXT("Host="), Config.Connection.Host);
+	FParse::Value(*Params, TEXT("Module="), Config.Connection.ModuleName);
+	FParse::Value(*Params, TEXT("Instance="), Config.InstanceId);
+	FParse::Value(*Params, TEXT("InstanceName="), Config.InstanceName);
+	FParse::Value(*Params, TEXT("PositionHz="), Config.PositionHz);
+	FParse::Value(*Params, TEXT("ActionInterval="), Config.ActionInterval);
+	FParse::Value(*Params, TEXT("ConnectRate="), Config.ConnectsPerSecond);
+	FParse::Value(*Params, TEXT("ReportInterval="), ReportInterval);
+	if (FParse::Param(*Params, TEXT("Binary")))
+	{
+		Config.Connection.Protocol = ESpaceTimeDBProtocol::Binary;
+	}
+
+	FString NetProfile;
+	if (FParse::Value(*Params, TEXT("NetProfile="), NetProfile))
+	{
+		FSpaceTimeDBNetSimSettings Settings;
+		if (!FSpaceTimeDBNetSimSettings::FindProfile(NetProfile, Settings))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SpaceTimeDB: Unknown network profile %s"), *NetProfile);
+			return 1;
+		}
+		FSpaceTimeDBNetSimSettings::ApplyToConsoleVariables(Settings);
+	}
+
+	FEonBotSwarm Swarm(Config);
+	Swarm.Start();
+
+	const double StartTime = FPlatformTime::Seconds();
+	double LastTime = StartTime;
+	double NextReport = ReportInterval;
+	while (!IsEngineExitRequested() && LastTime - StartTime < Seconds)
+	{
+		const double FrameStart = FPlatformTime::Seconds();
+		const float DeltaTime = static_cast<float>(FrameStart - LastTime);
+		LastTime = FrameStart;
+
+		PumpGameThread(DeltaTime);
+		Swarm.Tick(DeltaTime);
+
+		if (ReportInterval > 0.0f && FrameStart - StartTime >= NextReport)
+		{
+			UE_LOG(LogTemp, Display, TEXT("SpaceTimeDB: Bot swarm %s"), *Swarm.TakeIntervalReport().ToString());
+			NextReport += ReportInterval;
+		}
+
+		FPlatformProcess::Sleep(static_cast<float>(FMath::Max(BotSwarmFrameSeconds - (FPlatformTime::Seconds() - FrameStart), 0.0)));
+	}
+
+	const FEonBotSwarmReport Total = Swarm.GetTotalReport();
+	UE_LOG(LogTemp, Display, TEXT("SpaceTimeDB: Bot swarm total %s"), *Total.ToString());
+
+	// Let the sockets close cleanly so the server marks the bots offline
+	Swarm.Stop();
+	for (int32 Frame = 0; Frame < 30; ++Frame)
+	{
+		PumpGameThread(static_cast<float>(BotSwarmFrameSeconds));
+		FPlatformProcess::Sleep(static_cast<float>(BotSwarmFrameSeconds));
+	}
+
+	return Total.TransactionsPerSecond > 0.0 ? 0 : 1;
+}
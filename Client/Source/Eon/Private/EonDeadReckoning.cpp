@@ -0,0 +1,59 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "EonDeadReckoning.h"
+
+// ============================================================================
+// DEAD RECKONING
+// ============================================================================
+
+void FEonDeadReckoning::AddSample(const FVector& InPosition, const FRotator& InRotation, double InTime)
+{
+	if (bHasSample && InTime > 0.0 && InTime <= Time)
+	{
+		return;
+	}
+
+	const double Gap = InTime - Time;
+	Velocity = bHasSample && Time > 0.0 && InTime > 0.0 && Gap <= MaxVelocityGapSeconds
+		? (InPosition - Position) / Gap
+		: FVector::ZeroVector;
+
+	Position = InPosition;
+	Rotation = InRotation;
+	Time = InTime;
+	bHasSample = true;
+}
+
+FVector FEonDeadReckoning::PredictLocation(double Now) const
+{
+	if (Time <= 0.0)
+	{
+		return Position;
+	}
+	return Position + Velocity * FMath::Clamp(Now - Time, 0.0, MaxExtrapolationSeconds);
+}
+
+// ============================================================================
+// SYNC GATE
+// ============================================================================
+
+bool FEonPositionSyncGate::ShouldSend(const FVector& Position, const FRotator& Rotation, double Time)
+{
+	bool bSend = !Remote.HasSample() || (KeepaliveInterval > 0.0 && Time - LastSendTime >= KeepaliveInterval);
+	if (!bSend)
+	{
+		bSend = FVector::DistSquared(Remote.PredictLocation(Time), Position) > FMath::Square(PositionTolerance) ||
+			!(Rotation - Remote.GetRotation()).GetNormalized().IsNearlyZero(RotationTolerance);
+	}
+
+	if (!bSend)
+	{
+		++NumSuppressed;
+		return false;
+	}
+
+	Remote.AddSample(Position, Rotation, Time);
+	LastSendTime = Time;
+	++NumSent;
+	return true;
+}
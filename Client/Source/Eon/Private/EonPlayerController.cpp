@@ -21,9 +21,15 @@ void AEonPlayerController::BeginPlay()
 	DetectPlatform();
 
 	// Get SpaceTimeDB manager and connect (only if enabled)
-	if (bEnableSpaceTimeDB)
+	if (USpaceTimeDBManager* Manager = GetSpaceTimeDBManager())
 	{
-		if (USpaceTimeDBManager* Manager = GetSpaceTimeDBManager())
+		// Solo play, or no server at all: reducers run in process, and sync once connected
+		if (bSoloLocalAuthority || !bEnableSpaceTimeDB)
+		{
+			Manager->SetLocalAuthority(true);
+		}
+
+		if (bEnableSpaceTimeDB)
 		{
 			Manager->OnConnected.AddDynamic(this, &AEonPlayerController::OnSpaceTimeDBConnected);
 			FSpaceTimeDBConfig Config;
@@ -80,7 +86,15 @@ void AEonPlayerController::SyncPlayerPosition()
 			{
 				FVector Location = ControlledPawn->GetActorLocation();
 				FRotator Rotation = ControlledPawn->GetActorRotation();
-				Manager->UpdatePlayerPosition(Location, Rotation);
+
+				// Server time, as other clients date our row by its last_seen
+				PositionSyncGate.PositionTolerance = PositionSyncTolerance;
+				PositionSyncGate.RotationTolerance = RotationSyncTolerance;
+				PositionSyncGate.KeepaliveInterval = PositionKeepaliveInterval;
+				if (PositionSyncGate.ShouldSend(Location, Rotation, Manager->GetServerTime()))
+				{
+					Manager->UpdatePlayerPosition(Location, Rotation);
+				}
 			}
 		}
 	}
@@ -108,6 +122,9 @@ void AEonPlayerController::OnSpaceTimeDBConnected()
 		Manager->RegisterPlayer(Username);
 		Manager->SetPlayerOnline(true);
 	}
+
+	// Our row may be anywhere after a reconnect; the next sample goes out regardless
+	PositionSyncGate.Reset();
 }
 
 void AEonPlayerController::ShowInventoryUI(bool bShow)
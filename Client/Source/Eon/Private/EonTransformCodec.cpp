@@ -0,0 +1,65 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "EonTransformCodec.h"
+
+namespace
+{
+	// Value / Step rounded into a Bits-wide signed field, stored offset binary
+	uint64 PackSigned(double Value, double Step, int32 Bits)
+	{
+		const int64 Half = int64(1) << (Bits - 1);
+		const int64 Steps = FMath::Clamp<int64>(FMath::RoundToInt64(Value / Step), -Half, Half - 1);
+		return static_cast<uint64>(Steps + Half);
+	}
+
+	double UnpackSigned(uint64 Word, int32 Shift, int32 Bits, double Step)
+	{
+		const uint64 Field = (Word >> Shift) & ((uint64(1) << Bits) - 1);
+		return (static_cast<int64>(Field) - (int64(1) << (Bits - 1))) * Step;
+	}
+}
+
+FEonCompactTransform FEonTransformCodec::Encode(const FVector& Position, const FRotator& Rotation, const FVector& Origin)
+{
+	FEonCompactTransform Transform;
+	Transform.Position = EncodePosition(Position - Origin);
+	Transform.Orientation = EncodeOrientation(Rotation);
+	return Transform;
+}
+
+void FEonTransformCodec::Decode(const FEonCompactTransform& Transform, FVector& OutPosition, FRotator& OutRotation, const FVector& Origin)
+{
+	OutPosition = Origin + DecodePosition(Transform.Position);
+	OutRotation = DecodeOrientation(Transform.Orientation);
+}
+
+uint64 FEonTransformCodec::EncodePosition(const FVector& Offset)
+{
+	return PackSigned(Offset.X, PositionStepCm, PositionBitsXY) |
+		PackSigned(Offset.Y, PositionStepCm, PositionBitsXY) << PositionBitsXY |
+		PackSigned(Offset.Z, PositionStepCm, PositionBitsZ) << (2 * PositionBitsXY);
+}
+
+FVector FEonTransformCodec::DecodePosition(uint64 Packed)
+{
+	return FVector(
+		UnpackSigned(Packed, 0, PositionBitsXY, PositionStepCm),
+		UnpackSigned(Packed, PositionBitsXY, PositionBitsXY, PositionStepCm),
+		UnpackSigned(Packed, 2 * PositionBitsXY, PositionBitsZ, PositionStepCm));
+}
+
+uint32 FEonTransformCodec::EncodeOrientation(const FRotator& Rotation)
+{
+	// Yaw wraps, so 65536 steps cover the circle; pitch has both ends, so 65535 steps cover [-90, 90]
+	const uint32 Yaw = static_cast<uint32>(FMath::RoundToInt64(FRotator::ClampAxis(Rotation.Yaw) * 65536.0 / 360.0)) & 0xFFFF;
+	const double Pitch = FMath::Clamp<double>(FRotator::NormalizeAxis(Rotation.Pitch), -90.0, 90.0);
+	const uint32 PitchSteps = static_cast<uint32>(FMath::RoundToInt64((Pitch + 90.0) * 65535.0 / 180.0));
+	return Yaw | PitchSteps << 16;
+}
+
+FRotator FEonTransformCodec::DecodeOrientation(uint32 Packed)
+{
+	const double Yaw = FRotator::NormalizeAxis((Packed & 0xFFFF) * 360.0 / 65536.0);
+	const double Pitch = (Packed >> 16) * 180.0 / 65535.0 - 90.0;
+	return FRotator(Pitch, Yaw, 0.0);
+}
@@ -40,7 +40,16 @@ void UInventoryComponent::BeginPlay()
 	{
 		if (USpaceTimeDBManager* Manager = PC->GetSpaceTimeDBManager())
 		{
-			Manager->OnInventoryUpdated.AddDynamic(this, &UInventoryComponent::OnInventoryDataReceived);
+			// Whole messages, so a snapshot or transaction is applied as one batch
+			Manager->OnServerMessage.AddUObject(this, &UInventoryComponent::OnServerMessageReceived);
+
+			// Rows the local authority already holds, e.g. the item definitions of an offline session
+			if (const FSpaceTimeDBLocalAuthority* Authority = Manager->GetLocalAuthority())
+			{
+				FSpaceTimeDBServerMessage Rows;
+				Authority->GetVisibleRows(Rows);
+				OnServerMessageReceived(Rows);
+			}
 		}
 	}
 
@@ -48,6 +57,19 @@ void UInventoryComponent::BeginPlay()
 	LoadInventoryFromLocal();
 }
 
+void UInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AEonPlayerController* PC = Cast<AEonPlayerController>(UGameplayStatics::GetPlayerController(this, 0)))
+	{
+		if (USpaceTimeDBManager* Manager = PC->GetSpaceTimeDBManager())
+		{
+			Manager->OnServerMessage.RemoveAll(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -59,18 +81,13 @@ void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 
 void UInventoryComponent::AddItem(const FString& ItemId, int32 Quantity)
 {
-	// Try SpaceTimeDB first
-	if (AEonPlayerController* PC = Cast<AEonPlayerController>(UGameplayStatics::GetPlayerController(this, 0)))
+	// Try SpaceTimeDB first; with a local authority the server's rules run here and the row arrives at once
+	USpaceTimeDBManager* Manager = GetReducerManager();
+	if (Manager && (Manager->IsConnected() || Manager->HasLocalAuthority()))
 	{
-		if (USpaceTimeDBManager* Manager = PC->GetSpaceTimeDBManager())
-		{
-			if (Manager->IsConnected())
-			{
-				Manager->AddItemToInventory(ItemId, Quantity);
-				LogTransaction(TEXT("Add"), ItemId, Quantity, true, TEXT("Server request sent"));
-				return;
-			}
-		}
+		Manager->AddItemToInventory(ItemId, Quantity);
+		LogTransaction(TEXT("Add"), ItemId, Quantity, true, Manager->HasLocalAuthority() ? TEXT("Applied locally") : TEXT("Server request sent"));
+		return;
 	}
 
 	// Local-only mode: add directly to inventory
@@ -88,15 +105,13 @@ void UInventoryComponent::RemoveItem(int64 EntryId, int32 Quantity)
 		return;
 	}
 
-	if (AEonPlayerController* PC = Cast<AEonPlayerController>(UGameplayStatics::GetPlayerController(this, 0)))
+	if (USpaceTimeDBManager* Manager = GetReducerManager())
 	{
-		if (USpaceTimeDBManager* Manager = PC->GetSpaceTimeDBManager())
-		{
-			Manager->RemoveItemFromInventory(EntryId, Quantity);
-			const FInventorySlot* Slot = FindItemByEntryIdConst(EntryId);
-			LogTransaction(TEXT("Remove"), Slot ? Slot->ItemId : TEXT("Unknown"), Quantity, true);
-			return;
-		}
+		const FInventorySlot* Slot = FindItemByEntryIdConst(EntryId);
+		const FString ItemId = Slot ? Slot->ItemId : TEXT("Unknown");
+		Manager->RemoveItemFromInventory(EntryId, Quantity);
+		LogTransaction(TEXT("Remove"), ItemId, Quantity, true);
+		return;
 	}
 
 	// Local fallback
@@ -117,13 +132,12 @@ void UInventoryComponent::UseItem(int64 EntryId)
 
 	if (Slot->ItemType == TEXT("consumable"))
 	{
-		if (AEonPlayerController* PC = Cast<AEonPlayerController>(UGameplayStatics::GetPlayerController(this, 0)))
+		if (USpaceTimeDBManager* Manager = GetReducerManager())
 		{
-			if (USpaceTimeDBManager* Manager = PC->GetSpaceTimeDBManager())
-			{
-				Manager->UseConsumable(EntryId);
-				LogTransaction(TEXT("Use"), Slot->ItemId, 1, true);
-			}
+			// A local authority may remove the slot before the call returns
+			const FString ItemId = Slot->ItemId;
+			Manager->UseConsumable(EntryId);
+			LogTransaction(TEXT("Use"), ItemId, 1, true);
 		}
 	}
 }
@@ -180,59 +194,114 @@ int32 UInventoryComponent::GetItemCount(const FString& ItemId) const
 	return Total;
 }
 
-void UInventoryComponent::OnInventoryDataReceived(const FString& JsonData)
+void UInventoryComponent::OnServerMessageReceived(const FSpaceTimeDBServerMessage& Message)
 {
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonData);
+	// Definitions first, so rows in the same message pick them up
+	if (Message.ItemDefinitions.Num() > 0)
+	{
+		ApplyServerItemDefinitions(Message.ItemDefinitions);
+	}
 
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	// An empty snapshot still matters: everything we hold was deleted while we were away
+	const bool bSnapshot = Message.Type == ESpaceTimeDBMessageType::InitialSubscription;
+	if (Message.InventoryItems.Num() == 0 && !bSnapshot)
 	{
 		return;
 	}
 
-	FInventorySlot NewSlot;
-	JsonObject->TryGetNumberField(TEXT("entry_id"), NewSlot.EntryId);
-	JsonObject->TryGetStringField(TEXT("item_id"), NewSlot.ItemId);
-	JsonObject->TryGetNumberField(TEXT("quantity"), NewSlot.Quantity);
-	JsonObject->TryGetNumberField(TEXT("slot_index"), NewSlot.SlotIndex);
-	JsonObject->TryGetStringField(TEXT("item_type"), NewSlot.ItemType);
-	JsonObject->TryGetStringField(TEXT("display_name"), NewSlot.DisplayName);
-	JsonObject->TryGetStringField(TEXT("description"), NewSlot.Description);
+	FSpaceTimeDBIdentity OwnerIdentity;
+	if (AEonPlayerController* PC = Cast<AEonPlayerController>(UGameplayStatics::GetPlayerController(this, 0)))
+	{
+		if (USpaceTimeDBManager* Manager = PC->GetSpaceTimeDBManager())
+		{
+			OwnerIdentity = Manager->GetIdentity();
+		}
+	}
+
+	ApplyServerInventoryRows(Message.InventoryItems, OwnerIdentity, bSnapshot);
+}
 
-	// Phase 8 fields
-	double Weight = 0.0;
-	if (JsonObject->TryGetNumberField(TEXT("weight"), Weight))
+void UInventoryComponent::ApplyServerInventoryRows(TArrayView<const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>> Rows, const FSpaceTimeDBIdentity& OwnerIdentity, bool bSnapshot)
+{
+	// Index the current slots once so the batch is O(N) rather than a scan per row
+	TMap<int64, int32> SlotByEntryId;
+	SlotByEntryId.Reserve(Items.Num() + Rows.Num());
+	for (int32 i = 0; i < Items.Num(); ++i)
 	{
-		NewSlot.Weight = static_cast<float>(Weight);
+		SlotByEntryId.Add(Items[i].EntryId, i);
 	}
 
-	int32 RarityInt = 0;
-	if (JsonObject->TryGetNumberField(TEXT("rarity"), RarityInt))
+	// Entries the snapshot mentions; the rest were deleted on the server
+	TSet<int64> SnapshotEntryIds;
+	if (bSnapshot)
 	{
-		NewSlot.Rarity = static_cast<EItemRarity>(FMath::Clamp(RarityInt, 0, 4));
+		SnapshotEntryIds.Reserve(Rows.Num());
 	}
 
-	double Durability = 100.0;
-	if (JsonObject->TryGetNumberField(TEXT("durability"), Durability))
+	bool bChanged = false;
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>& Update : Rows)
 	{
-		NewSlot.CurrentDurability = static_cast<float>(Durability);
-		NewSlot.bHasDurability = true;
+		const FSpaceTimeDBInventoryRow& Row = Update.Row;
+
+		// The subscription is already owner-filtered; this guards against a broader query
+		if (OwnerIdentity.IsValid() && Row.OwnerIdentity.IsValid() && Row.OwnerIdentity != OwnerIdentity)
+		{
+			continue;
+		}
+
+		const int64 EntryId = static_cast<int64>(Row.EntryId);
+		if (bSnapshot && Update.Op != ESpaceTimeDBRowOp::Delete)
+		{
+			SnapshotEntryIds.Add(EntryId);
+		}
+		const int32 Quantity = Update.Op == ESpaceTimeDBRowOp::Delete ? 0 : static_cast<int32>(FMath::Min<uint32>(Row.Quantity, MAX_int32));
+
+		// Only server-owned columns are overwritten; local state (favorites, locks, durability) is kept
+		if (const int32* Index = SlotByEntryId.Find(EntryId))
+		{
+			FInventorySlot& Existing = Items[*Index];
+			const int32 SlotIndex = static_cast<int32>(Row.SlotIndex);
+
+			// A resync resends every row; identical ones must not re-sort or re-broadcast
+			if (Existing.Quantity == Quantity && Existing.SlotIndex == SlotIndex && Existing.ItemId.Equals(Row.ItemId, ESearchCase::CaseSensitive))
+			{
+				continue;
+			}
+
+			Existing.ItemId = Row.ItemId;
+			Existing.Quantity = Quantity;
+			Existing.SlotIndex = SlotIndex;
+			ApplyItemDefinition(Existing);
+			bChanged = true;
+		}
+		else if (!Row.ItemId.IsEmpty() && Quantity > 0)
+		{
+			FInventorySlot NewSlot;
+			NewSlot.EntryId = EntryId;
+			NewSlot.ItemId = Row.ItemId;
+			NewSlot.Quantity = Quantity;
+			NewSlot.SlotIndex = static_cast<int32>(Row.SlotIndex);
+			ApplyItemDefinition(NewSlot);
+			SlotByEntryId.Add(EntryId, Items.Add(NewSlot));
+			bChanged = true;
+		}
 	}
 
-	bool bFound = false;
-	for (FInventorySlot& Slot : Items)
+	if (bSnapshot)
 	{
-		if (Slot.EntryId == NewSlot.EntryId)
+		for (FInventorySlot& Slot : Items)
 		{
-			Slot = NewSlot;
-			bFound = true;
-			break;
+			if (Slot.Quantity > 0 && !SnapshotEntryIds.Contains(Slot.EntryId))
+			{
+				Slot.Quantity = 0;
+				bChanged = true;
+			}
 		}
 	}
 
-	if (!bFound && !NewSlot.ItemId.IsEmpty())
+	if (!bChanged)
 	{
-		Items.Add(NewSlot);
+		return;
 	}
 
 	Items.RemoveAll([](const FInventorySlot& S) { return S.Quantity <= 0; });
@@ -245,6 +314,57 @@ void UInventoryComponent::OnInventoryDataReceived(const FString& JsonData)
 	OnInventoryChanged.Broadcast();
 }
 
+void UInventoryComponent::ApplyServerItemDefinitions(TArrayView<const TSpaceTimeDBRowUpdate<FSpaceTimeDBItemDefinitionRow>> Rows)
+{
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBItemDefinitionRow>& Update : Rows)
+	{
+		if (Update.Op == ESpaceTimeDBRowOp::Delete)
+		{
+			ItemDefinitions.Remove(Update.Row.ItemId);
+		}
+		else
+		{
+			ItemDefinitions.Add(Update.Row.ItemId, Update.Row);
+		}
+	}
+
+	bool bChanged = false;
+	for (FInventorySlot& Slot : Items)
+	{
+		bChanged |= ApplyItemDefinition(Slot);
+	}
+
+	if (bChanged)
+	{
+		OnInventoryChanged.Broadcast();
+	}
+}
+
+bool UInventoryComponent::ApplyItemDefinition(FInventorySlot& Slot) const
+{
+	const FSpaceTimeDBItemDefinitionRow* Definition = ItemDefinitions.Find(Slot.ItemId);
+	if (!Definition)
+	{
+		return false;
+	}
+
+	const int32 MaxStack = static_cast<int32>(FMath::Clamp<uint32>(Definition->MaxStack, 1, MAX_int32));
+	const EItemRarity Rarity = static_cast<EItemRarity>(FMath::Min<uint8>(Definition->Rarity, static_cast<uint8>(EItemRarity::Legendary)));
+	if (Slot.DisplayName.Equals(Definition->DisplayName, ESearchCase::CaseSensitive) && Slot.MaxStack == MaxStack &&
+		Slot.ItemType.Equals(Definition->ItemType, ESearchCase::CaseSensitive) &&
+		Slot.Description.Equals(Definition->Description, ESearchCase::CaseSensitive) && Slot.Rarity == Rarity)
+	{
+		return false;
+	}
+
+	Slot.DisplayName = Definition->DisplayName;
+	Slot.MaxStack = MaxStack;
+	Slot.ItemType = Definition->ItemType;
+	Slot.Description = Definition->Description;
+	Slot.Rarity = Rarity;
+	return true;
+}
+
 // ============================================================================
 // PHASE 8.1: WEIGHT SYSTEM
 // ============================================================================
@@ -1310,6 +1430,12 @@ void UInventoryComponent::RefreshFromServer()
 	// Trigger a re-subscribe to get fresh data
 }
 
+USpaceTimeDBManager* UInventoryComponent::GetReducerManager() const
+{
+	AEonPlayerController* PC = Cast<AEonPlayerController>(UGameplayStatics::GetPlayerController(this, 0));
+	return PC ? PC->GetSpaceTimeDBManager() : nullptr;
+}
+
 void UInventoryComponent::AddItemLocal(const FString& ItemId, int32 Quantity)
 {
 	// Check weight capacity
@@ -1483,5 +1609,7 @@ FInventorySlot UInventoryComponent::CreateItemSlot(const FString& ItemId, int32
 		NewSlot.EquipSlot = EEquipmentSlot::Accessory1;
 	}
 
+	// Server definitions win over the guesses above once they have arrived
+	ApplyItemDefinition(NewSlot);
 	return NewSlot;
 }
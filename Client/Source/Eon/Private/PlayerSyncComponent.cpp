@@ -1,11 +1,11 @@
 // Copyright 2026 tbassignana. MIT License.
 
 #include "PlayerSyncComponent.h"
+#include "SpaceTimeDBTableCache.h"
 #include "SpaceTimeDBManager.h"
-#include "EonPlayerController.h"
+#include "SpaceTimeDBLatencyProbe.h"
 #include "Kismet/GameplayStatics.h"
-#include "Json.h"
-#include "JsonUtilities.h"
+#include "Engine/GameInstance.h"
 #include "Engine/World.h"
 
 UPlayerSyncComponent::UPlayerSyncComponent()
@@ -17,120 +17,226 @@ void UPlayerSyncComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Subscribe to player updates from SpaceTimeDB
-	if (AEonPlayerController* PC = Cast<AEonPlayerController>(UGameplayStatics::GetPlayerController(this, 0)))
+	// Player rows live in the table cache; this component only reacts to changes
+	if (UGameInstance* GI = UGameplayStatics::GetGameInstance(this))
 	{
-		if (USpaceTimeDBManager* Manager = PC->GetSpaceTimeDBManager())
+		Bind(GI->GetSubsystem<USpaceTimeDBTableCache>(), GI->GetSubsystem<USpaceTimeDBManager>());
+	}
+}
+
+void UPlayerSyncComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Unbind();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPlayerSyncComponent::Bind(USpaceTimeDBTableCache* InCache, USpaceTimeDBManager* InManager)
+{
+	Unbind();
+	Cache = InCache;
+	Manager = InManager;
+
+	if (Cache.IsValid())
+	{
+		TSpaceTimeDBTable<FSpaceTimeDBPlayerRow>& Players = Cache->Players();
+		Players.OnInsert.AddUObject(this, &UPlayerSyncComponent::HandlePlayerInserted);
+		Players.OnUpdate.AddUObject(this, &UPlayerSyncComponent::HandlePlayerUpdated);
+		Players.OnDelete.AddUObject(this, &UPlayerSyncComponent::HandlePlayerDeleted);
+		Cache->OnSnapshotComplete.AddUObject(this, &UPlayerSyncComponent::HandleSnapshotComplete);
+
+		// Pick up players that were already replicated before we began play
+		for (const FSpaceTimeDBPlayerRow& Row : Players.GetRows())
 		{
-			// Bind to player data updates (will receive data once connected)
-			Manager->OnPlayerDataReceived.AddDynamic(this, &UPlayerSyncComponent::OnPlayerDataReceived);
+			HandlePlayerInserted(Row);
 		}
 	}
 }
 
+void UPlayerSyncComponent::Unbind()
+{
+	if (Cache.IsValid())
+	{
+		TSpaceTimeDBTable<FSpaceTimeDBPlayerRow>& Players = Cache->Players();
+		Players.OnInsert.RemoveAll(this);
+		Players.OnUpdate.RemoveAll(this);
+		Players.OnDelete.RemoveAll(this);
+		Cache->OnSnapshotComplete.RemoveAll(this);
+	}
+	Cache.Reset();
+	Manager.Reset();
+	PlayerRepresentations.Reset();
+	OnlinePlayerCount = 0;
+}
+
 void UPlayerSyncComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	InterpolatePlayers(DeltaTime);
+}
+
+void UPlayerSyncComponent::InterpolatePlayers(float DeltaTime)
+{
+	if (!Cache.IsValid())
+	{
+		return;
+	}
+
+	const bool bProbing = FSpaceTimeDBLatencyProbe::IsActive();
+	// Rows are dated by the server's clock; without a manager they are only held
+	const double ServerNow = Manager.IsValid() ? Manager->GetServerTime() : 0.0;
+
 	// Interpolate other player positions for smooth movement
-	for (const FOtherPlayer& Player : OtherPlayers)
+	for (TPair<FSpaceTimeDBIdentity, FPlayerRepresentation>& Pair : PlayerRepresentations)
 	{
-		if (AActor** ActorPtr = PlayerActors.Find(Player.PlayerId))
+		FPlayerRepresentation& Representation = Pair.Value;
+		const FSpaceTimeDBPlayerRow* Row = Cache->Players().Find(Pair.Key);
+		if (!Row)
 		{
-			if (AActor* Actor = *ActorPtr)
-			{
-				FVector CurrentLocation = Actor->GetActorLocation();
-				FRotator CurrentRotation = Actor->GetActorRotation();
+			continue;
+		}
 
-				FVector NewLocation = FMath::VInterpTo(CurrentLocation, Player.Position, DeltaTime, InterpolationSpeed);
-				FRotator NewRotation = FMath::RInterpTo(CurrentRotation, Player.Rotation, DeltaTime, InterpolationSpeed);
+		Representation.Location = FMath::VInterpTo(Representation.Location, Representation.Motion.PredictLocation(ServerNow), DeltaTime, InterpolationSpeed);
+		Representation.Rotation = FMath::RInterpTo(Representation.Rotation, FRotator(Row->Rotation), DeltaTime, InterpolationSpeed);
 
-				Actor->SetActorLocation(NewLocation);
-				Actor->SetActorRotation(NewRotation);
-			}
+		if (AActor* Actor = Representation.Actor.Get())
+		{
+			Actor->SetActorLocationAndRotation(Representation.Location, Representation.Rotation);
+		}
+
+		if (bProbing)
+		{
+			FSpaceTimeDBLatencyProbe::Get().NoteDisplayed(this, Pair.Key, Representation.Location);
 		}
 	}
 }
 
-FOtherPlayer UPlayerSyncComponent::GetPlayerById(const FString& PlayerId) const
+TOptional<FVector> UPlayerSyncComponent::GetDisplayLocation(const FSpaceTimeDBIdentity& PlayerIdentity) const
 {
-	const FOtherPlayer* Found = OtherPlayers.FindByPredicate([&PlayerId](const FOtherPlayer& P) {
-		return P.PlayerId == PlayerId;
-	});
-
-	return Found ? *Found : FOtherPlayer();
+	const FPlayerRepresentation* Representation = PlayerRepresentations.Find(PlayerIdentity);
+	return Representation ? Representation->Location : TOptional<FVector>();
 }
 
-void UPlayerSyncComponent::OnPlayerDataReceived(const FString& PlayerId, const FString& JsonData)
+TArray<FOtherPlayer> UPlayerSyncComponent::GetOtherPlayers() const
 {
-	// Skip if this is our own player
-	if (AEonPlayerController* PC = Cast<AEonPlayerController>(UGameplayStatics::GetPlayerController(this, 0)))
+	TArray<FOtherPlayer> Result;
+	if (Cache.IsValid())
 	{
-		// Compare identities - skip self
+		Result.Reserve(OnlinePlayerCount);
+		for (const FSpaceTimeDBPlayerRow& Row : Cache->Players().GetRows())
+		{
+			if (IsTrackedPlayer(Row))
+			{
+				Result.Add(ToOtherPlayer(Row));
+			}
+		}
 	}
+	return Result;
+}
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonData);
+FOtherPlayer UPlayerSyncComponent::GetPlayerById(const FString& PlayerId) const
+{
+	FSpaceTimeDBIdentity PlayerIdentity;
+	return FSpaceTimeDBIdentity::FromHex(PlayerId, PlayerIdentity) ? GetPlayer(PlayerIdentity) : FOtherPlayer();
+}
 
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
-	{
-		return;
-	}
+FOtherPlayer UPlayerSyncComponent::GetPlayer(const FSpaceTimeDBIdentity& PlayerIdentity) const
+{
+	const FSpaceTimeDBPlayerRow* Row = Cache.IsValid() ? Cache->Players().Find(PlayerIdentity) : nullptr;
+	return Row && IsTrackedPlayer(*Row) ? ToOtherPlayer(*Row) : FOtherPlayer();
+}
 
+FOtherPlayer UPlayerSyncComponent::ToOtherPlayer(const FSpaceTimeDBPlayerRow& Row)
+{
 	FOtherPlayer PlayerData;
-	PlayerData.PlayerId = PlayerId;
-	JsonObject->TryGetStringField(TEXT("username"), PlayerData.Username);
+	PlayerData.Identity = Row.Identity;
+	PlayerData.PlayerId = Row.Identity.ToHex();
+	PlayerData.Username = Row.Username;
+	PlayerData.Position = FVector(Row.Position);
+	PlayerData.Rotation = FRotator(Row.Rotation);
+	PlayerData.Health = Row.Health;
+	PlayerData.bIsOnline = Row.bIsOnline;
+	return PlayerData;
+}
 
-	double PosX, PosY, PosZ;
-	JsonObject->TryGetNumberField(TEXT("position_x"), PosX);
-	JsonObject->TryGetNumberField(TEXT("position_y"), PosY);
-	JsonObject->TryGetNumberField(TEXT("position_z"), PosZ);
-	PlayerData.Position = FVector(PosX, PosY, PosZ);
+bool UPlayerSyncComponent::IsTrackedPlayer(const FSpaceTimeDBPlayerRow& Row) const
+{
+	// Skip our own row; the local pawn represents us. Player rows are only
+	// subscribed after the identity is known, so this never changes under us.
+	return Row.bIsOnline && !(Manager.IsValid() && Row.Identity == Manager->GetIdentity());
+}
 
-	double RotPitch, RotYaw, RotRoll;
-	JsonObject->TryGetNumberField(TEXT("rotation_pitch"), RotPitch);
-	JsonObject->TryGetNumberField(TEXT("rotation_yaw"), RotYaw);
-	JsonObject->TryGetNumberField(TEXT("rotation_roll"), RotRoll);
-	PlayerData.Rotation = FRotator(RotPitch, RotYaw, RotRoll);
+void UPlayerSyncComponent::HandlePlayerInserted(const FSpaceTimeDBPlayerRow& Row)
+{
+	if (IsTrackedPlayer(Row))
+	{
+		if (FSpaceTimeDBLatencyProbe::IsActive())
+		{
+			FSpaceTimeDBLatencyProbe::Get().NoteReceived(this, Row.Identity, Row.Position);
+		}
 
-	double Health;
-	JsonObject->TryGetNumberField(TEXT("health"), Health);
-	PlayerData.Health = static_cast<float>(Health);
+		const FOtherPlayer PlayerData = ToOtherPlayer(Row);
+		++OnlinePlayerCount;
+		SpawnPlayerRepresentation(PlayerData);
+		AddMotionSample(Row);
+		OnPlayerJoined.Broadcast(PlayerData);
+	}
+}
 
-	JsonObject->TryGetBoolField(TEXT("is_online"), PlayerData.bIsOnline);
+void UPlayerSyncComponent::HandlePlayerUpdated(const FSpaceTimeDBPlayerRow& OldRow, const FSpaceTimeDBPlayerRow& NewRow)
+{
+	const bool bWasTracked = IsTrackedPlayer(OldRow);
+	const bool bIsTracked = IsTrackedPlayer(NewRow);
 
-	// Handle player leaving
-	if (!PlayerData.bIsOnline)
+	if (bWasTracked && bIsTracked)
 	{
-		OtherPlayers.RemoveAll([&PlayerId](const FOtherPlayer& P) { return P.PlayerId == PlayerId; });
-		RemovePlayerRepresentation(PlayerId);
-		OnPlayerLeft.Broadcast(PlayerId);
-		return;
+		if (FSpaceTimeDBLatencyProbe::IsActive())
+		{
+			FSpaceTimeDBLatencyProbe::Get().NoteReceived(this, NewRow.Identity, NewRow.Position);
+		}
+
+		const FOtherPlayer PlayerData = ToOtherPlayer(NewRow);
+		UpdatePlayerRepresentation(PlayerData);
+		AddMotionSample(NewRow);
+		OnPlayerUpdated.Broadcast(PlayerData);
 	}
+	else if (bIsTracked)
+	{
+		HandlePlayerInserted(NewRow);
+	}
+	else if (bWasTracked)
+	{
+		HandlePlayerDeleted(OldRow);
+	}
+}
 
-	// Update or add player
-	bool bFound = false;
-	for (FOtherPlayer& Existing : OtherPlayers)
+void UPlayerSyncComponent::HandlePlayerDeleted(const FSpaceTimeDBPlayerRow& Row)
+{
+	if (IsTrackedPlayer(Row))
 	{
-		if (Existing.PlayerId == PlayerId)
+		--OnlinePlayerCount;
+		RemovePlayerRepresentation(Row.Identity);
+		if (OnPlayerLeft.IsBound())
 		{
-			Existing = PlayerData;
-			bFound = true;
-			OnPlayerUpdated.Broadcast(PlayerData);
-			break;
+			OnPlayerLeft.Broadcast(Row.Identity.ToHex());
 		}
 	}
+}
 
-	if (!bFound)
-	{
-		OtherPlayers.Add(PlayerData);
-		SpawnPlayerRepresentation(PlayerData);
-		OnPlayerJoined.Broadcast(PlayerData);
-	}
+void UPlayerSyncComponent::HandleSnapshotComplete()
+{
+	UE_LOG(LogTemp, Log, TEXT("PlayerSync: Snapshot applied, %d other players"), OnlinePlayerCount);
+	OnSnapshotComplete.Broadcast();
 }
 
 void UPlayerSyncComponent::SpawnPlayerRepresentation(const FOtherPlayer& Player)
 {
+	// Interpolation starts from where the player first appears; the actor follows it
+	FPlayerRepresentation& Representation = PlayerRepresentations.Add(Player.Identity);
+	Representation.Location = Player.Position;
+	Representation.Rotation = Player.Rotation;
+
 	UWorld* World = GetWorld();
 	if (!World) return;
 
@@ -142,8 +248,8 @@ void UPlayerSyncComponent::SpawnPlayerRepresentation(const FOtherPlayer& Player)
 	UE_LOG(LogTemp, Log, TEXT("PlayerSync: Spawning representation for player %s at %s"),
 		*Player.Username, *Player.Position.ToString());
 
-	// Store reference (actual spawning would happen here with a proper actor class)
-	// PlayerActors.Add(Player.PlayerId, SpawnedActor);
+	// Store the actor (actual spawning would happen here with a proper actor class)
+	// Representation.Actor = SpawnedActor;
 }
 
 void UPlayerSyncComponent::UpdatePlayerRepresentation(const FOtherPlayer& Player)
@@ -151,15 +257,21 @@ void UPlayerSyncComponent::UpdatePlayerRepresentation(const FOtherPlayer& Player
 	// Position updates happen in Tick via interpolation
 }
 
-void UPlayerSyncComponent::RemovePlayerRepresentation(const FString& PlayerId)
+void UPlayerSyncComponent::RemovePlayerRepresentation(const FSpaceTimeDBIdentity& PlayerIdentity)
 {
-	if (AActor** ActorPtr = PlayerActors.Find(PlayerId))
+	FPlayerRepresentation Representation;
+	if (PlayerRepresentations.RemoveAndCopyValue(PlayerIdentity, Representation) && Representation.Actor.IsValid())
 	{
-		if (AActor* Actor = *ActorPtr)
-		{
-			Actor->Destroy();
-		}
-		PlayerActors.Remove(PlayerId);
+		Representation.Actor->Destroy();
+	}
+	UE_LOG(LogTemp, Log, TEXT("PlayerSync: Removed representation for player %s"), *PlayerIdentity.ToHex());
+}
+
+void UPlayerSyncComponent::AddMotionSample(const FSpaceTimeDBPlayerRow& Row)
+{
+	// Dated by last_seen, which update_player_position stamps; undated rows are held where they are
+	if (FPlayerRepresentation* Representation = PlayerRepresentations.Find(Row.Identity))
+	{
+		Representation->Motion.AddSample(FVector(Row.Position), FRotator(Row.Rotation), Row.LastSeenMicros * 1e-6);
 	}
-	UE_LOG(LogTemp, Log, TEXT("PlayerSync: Removed representation for player %s"), *PlayerId);
 }
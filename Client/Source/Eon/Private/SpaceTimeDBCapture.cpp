@@ -0,0 +1,233 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBCapture.h"
+#include "SpaceTimeDBTransport.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+
+namespace
+{
+	constexpr uint8 CaptureFlagOutbound = 1;
+	constexpr uint8 CaptureFlagBinary = 2;
+}
+
+// ============================================================================
+// CAPTURE FILES
+// ============================================================================
+
+bool FSpaceTimeDBCapture::Load(const FString& Path, TArray<FSpaceTimeDBCaptureFrame>& OutFrames)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Could not read capture %s"), *Path);
+		return false;
+	}
+	return Parse(Bytes, OutFrames);
+}
+
+bool FSpaceTimeDBCapture::Parse(TArrayView<const uint8> Bytes, TArray<FSpaceTimeDBCaptureFrame>& OutFrames)
+{
+	FMemoryReaderView Reader(Bytes);
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic;
+	Reader << FileVersion;
+	if (Reader.IsError() || FileMagic != Magic || FileVersion != Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Not a version %u capture"), Version);
+		return false;
+	}
+
+	double Seconds = 0.0;
+	while (!Reader.AtEnd())
+	{
+		uint8 Flags = 0;
+		uint32 DeltaMicros = 0;
+		uint32 Size = 0;
+		Reader << Flags;
+		Reader << DeltaMicros;
+		Reader << Size;
+		if (Reader.IsError() || Size > static_cast<uint64>(Reader.TotalSize() - Reader.Tell()))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Capture truncated after %d frames"), OutFrames.Num());
+			return false;
+		}
+
+		Seconds += DeltaMicros / 1000000.0;
+
+		FSpaceTimeDBCaptureFrame& Frame = OutFrames.AddDefaulted_GetRef();
+		Frame.Seconds = Seconds;
+		Frame.bOutbound = (Flags & CaptureFlagOutbound) != 0;
+		Frame.bBinary = (Flags & CaptureFlagBinary) != 0;
+		Frame.Bytes.SetNumUninitialized(Size);
+		Reader.Serialize(Frame.Bytes.GetData(), Size);
+	}
+	return true;
+}
+
+FString FSpaceTimeDBCapture::ResolvePath(const FString& Name)
+{
+	FString Path = Name;
+	if (FPaths::GetExtension(Path).IsEmpty())
+	{
+		Path += TEXT(".eoncap");
+	}
+
+	if (FPaths::IsRelative(Path) && !Path.Contains(TEXT("/")) && !Path.Contains(TEXT("\\")))
+	{
+		Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("NetCaptures"), Path);
+	}
+	return Path;
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+FSpaceTimeDBCaptureWriter::~FSpaceTimeDBCaptureWriter()
+{
+	Close();
+}
+
+bool FSpaceTimeDBCaptureWriter::Open(const FString& Path)
+{
+	Close();
+
+	Archive.Reset(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Archive.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Could not create capture %s"), *Path);
+		return false;
+	}
+
+	uint32 FileMagic = FSpaceTimeDBCapture::Magic;
+	uint32 FileVersion = FSpaceTimeDBCapture::Version;
+	*Archive << FileMagic;
+	*Archive << FileVersion;
+
+	LastFrameTime = FPlatformTime::Seconds();
+	NumFrames = 0;
+	return true;
+}
+
+void FSpaceTimeDBCaptureWriter::Close()
+{
+	if (Archive.IsValid())
+	{
+		Archive->Close();
+		Archive.Reset();
+	}
+}
+
+void FSpaceTimeDBCaptureWriter::Record(bool bOutbound, bool bBinary, const uint8* Data, int32 Size)
+{
+	if (!Archive.IsValid())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	uint32 DeltaMicros = static_cast<uint32>(FMath::Clamp((Now - LastFrameTime) * 1000000.0, 0.0, static_cast<double>(MAX_uint32)));
+	LastFrameTime = Now;
+
+	uint8 Flags = (bOutbound ? CaptureFlagOutbound : 0) | (bBinary ? CaptureFlagBinary : 0);
+	uint32 FrameSize = static_cast<uint32>(Size);
+	*Archive << Flags;
+	*Archive << DeltaMicros;
+	*Archive << FrameSize;
+	Archive->Serialize(const_cast<uint8*>(Data), Size);
+	++NumFrames;
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+FString FSpaceTimeDBReplayReport::ToString() const
+{
+	return FString::Printf(TEXT("%d frames over %d ticks (%.1fs captured): total %.2f ms, per frame mean %.3f / p50 %.3f / p95 %.3f / max %.3f ms, worst tick %.2f ms"),
+		FramesReplayed, Ticks, CaptureSeconds, TotalProcessMs, MeanProcessMs, P50ProcessMs, P95ProcessMs, MaxProcessMs, MaxTickMs);
+}
+
+FSpaceTimeDBReplayDriver::FSpaceTimeDBReplayDriver(TArray<FSpaceTimeDBCaptureFrame>&& InFrames, TSharedRef<FSpaceTimeDBLoopbackTransport> InTransport, float InSpeed)
+	: Frames(MoveTemp(InFrames))
+	, Transport(InTransport)
+	, Speed(FMath::Max(InSpeed, 0.0f))
+{
+	// Nobody plays the server during a replay; the client's own frames are discarded
+	Transport->OnClientFrame.BindLambda([](TArray<uint8>&, bool) {});
+	ProcessMs.Reserve(Frames.Num());
+}
+
+bool FSpaceTimeDBReplayDriver::Tick(float DeltaTime)
+{
+	if (IsFinished())
+	{
+		return false;
+	}
+
+	++Ticks;
+	Elapsed += DeltaTime * Speed;
+
+	const double TickStart = FPlatformTime::Seconds();
+	while (NextFrame < Frames.Num() && (Speed <= 0.0f || Frames[NextFrame].Seconds <= Elapsed))
+	{
+		Deliver(Frames[NextFrame++]);
+	}
+	MaxTickMs = FMath::Max(MaxTickMs, (FPlatformTime::Seconds() - TickStart) * 1000.0);
+
+	return !IsFinished();
+}
+
+void FSpaceTimeDBReplayDriver::RunToEnd()
+{
+	const float SavedSpeed = Speed;
+	Speed = 0.0f;
+	Tick(0.0f);
+	Speed = SavedSpeed;
+}
+
+void FSpaceTimeDBReplayDriver::Deliver(FSpaceTimeDBCaptureFrame& Frame)
+{
+	if (Frame.bOutbound)
+	{
+		return;
+	}
+
+	const double Start = FPlatformTime::Seconds();
+	Transport->ServerSend(MoveTemp(Frame.Bytes), Frame.bBinary);
+	ProcessMs.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+}
+
+FSpaceTimeDBReplayReport FSpaceTimeDBReplayDriver::GetReport() const
+{
+	FSpaceTimeDBReplayReport Report;
+	Report.FramesReplayed = ProcessMs.Num();
+	Report.Ticks = Ticks;
+	Report.MaxTickMs = MaxTickMs;
+	if (Frames.Num() > 0)
+	{
+		Report.CaptureSeconds = Frames.Last().Seconds;
+	}
+
+	if (ProcessMs.Num() == 0)
+	{
+		return Report;
+	}
+
+	TArray<double> Sorted = ProcessMs;
+	Sorted.Sort();
+	for (double Ms : Sorted)
+	{
+		Report.TotalProcessMs += Ms;
+	}
+	Report.MeanProcessMs = Report.TotalProcessMs / Sorted.Num();
+	Report.P50ProcessMs = Sorted[Sorted.Num() / 2];
+	Report.P95ProcessMs = Sorted[FMath::Min(Sorted.Num() - 1, Sorted.Num() * 95 / 100)];
+	Report.MaxProcessMs = Sorted.Last();
+	return Report;
+}
@@ -0,0 +1,117 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBClockSync.h"
+
+namespace
+{
+	// One sample is kept per bucket, the one with the shortest round trip
+	constexpr double BucketSeconds = 2.0;
+	// Five minutes of buckets
+	constexpr int32 MaxSamples = 150;
+
+	// Drift is only fitted through this many samples spread over this long;
+	// over a shorter span it cannot be told apart from round trip noise
+	constexpr int32 MinFitSamples = 4;
+	constexpr double MinDriftSpanSeconds = 30.0;
+
+	// Quartz clocks stay well inside this; anything beyond is noise
+	constexpr double MaxDrift = 500e-6;
+}
+
+void FSpaceTimeDBClockSync::AddSample(double LocalSendSeconds, double LocalReceiveSeconds, int64 ServerMicros)
+{
+	const double RoundTrip = LocalReceiveSeconds - LocalSendSeconds;
+	if (RoundTrip < 0.0 || ServerMicros <= 0)
+	{
+		return;
+	}
+
+	// The transaction ran somewhere inside the round trip; the midpoint is off by at most half of it
+	FSample Sample;
+	Sample.LocalTime = (LocalSendSeconds + LocalReceiveSeconds) * 0.5;
+	Sample.Offset = ServerMicros * 1e-6 - Sample.LocalTime;
+	Sample.RoundTrip = RoundTrip;
+
+	const int64 Bucket = FMath::FloorToInt64(Sample.LocalTime / BucketSeconds);
+	if (Samples.Num() > 0 && FMath::FloorToInt64(Samples.Last().LocalTime / BucketSeconds) == Bucket)
+	{
+		if (RoundTrip >= Samples.Last().RoundTrip)
+		{
+			return;
+		}
+		Samples.Last() = Sample;
+	}
+	else
+	{
+		if (Samples.Num() >= MaxSamples)
+		{
+			Samples.RemoveAt(0, Samples.Num() - MaxSamples + 1, EAllowShrinking::No);
+		}
+		Samples.Add(Sample);
+	}
+
+	Refit();
+}
+
+void FSpaceTimeDBClockSync::Reset()
+{
+	Samples.Reset();
+	FitTime = Offset = Drift = Uncertainty = 0.0;
+}
+
+double FSpaceTimeDBClockSync::ToServerTime(double LocalSeconds) const
+{
+	return LocalSeconds + Offset + Drift * (LocalSeconds - FitTime);
+}
+
+double FSpaceTimeDBClockSync::ToLocalTime(double ServerSeconds) const
+{
+	return (ServerSeconds - Offset + Drift * FitTime) / (1.0 + Drift);
+}
+
+void FSpaceTimeDBClockSync::Refit()
+{
+	// The least queued quarter of the buckets
+	TArray<FSample> Best = Samples;
+	Best.Sort([](const FSample& A, const FSample& B) { return A.RoundTrip < B.RoundTrip; });
+	Best.SetNum(FMath::Min(Best.Num(), FMath::Max(MinFitSamples, Best.Num() / 4)));
+	Uncertainty = Best[0].RoundTrip * 0.5;
+
+	// Offsets are around 1.7e9 seconds; fit their differences to keep the precision
+	const double BaseOffset = Best[0].Offset;
+	double MeanTime = 0.0;
+	double MeanDelta = 0.0;
+	double MinTime = Best[0].LocalTime;
+	double MaxTime = Best[0].LocalTime;
+	for (const FSample& Sample : Best)
+	{
+		MeanTime += Sample.LocalTime;
+		MeanDelta += Sample.Offset - BaseOffset;
+		MinTime = FMath::Min(MinTime, Sample.LocalTime);
+		MaxTime = FMath::Max(MaxTime, Sample.LocalTime);
+	}
+	MeanTime /= Best.Num();
+	MeanDelta /= Best.Num();
+
+	if (Best.Num() < MinFitSamples || MaxTime - MinTime < MinDriftSpanSeconds)
+	{
+		// Too little to fit a line through: the single best sample, as NTP's clock filter does
+		FitTime = Best[0].LocalTime;
+		Offset = BaseOffset;
+		Drift = 0.0;
+		return;
+	}
+
+	double Sxy = 0.0;
+	double Sxx = 0.0;
+	for (const FSample& Sample : Best)
+	{
+		const double Dx = Sample.LocalTime - MeanTime;
+		Sxy += Dx * (Sample.Offset - BaseOffset - MeanDelta);
+		Sxx += Dx * Dx;
+	}
+
+	FitTime = MeanTime;
+	Offset = BaseOffset + MeanDelta;
+	Drift = FMath::Clamp(Sxy / Sxx, -MaxDrift, MaxDrift);
+}
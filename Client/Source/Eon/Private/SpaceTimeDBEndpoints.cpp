@@ -0,0 +1,312 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBEndpoints.h"
+#include "SpaceTimeDBProtocol.h"
+#include "Algo/StableSort.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Json.h"
+
+namespace
+{
+	// Small, public and the same on every host: a fair round trip to time
+	const TCHAR* const ProbeQuery = TEXT("SELECT * FROM item_definition");
+}
+
+// ============================================================================
+// PROBE
+// ============================================================================
+
+FSpaceTimeDBEndpointProbe::FSpaceTimeDBEndpointProbe(const TArray<FString>& Hosts, const FString& InModuleName, bool bInBinary, FSpaceTimeDBTransportFactory InFactory)
+	: ModuleName(InModuleName)
+	, bBinary(bInBinary)
+	, Factory(MoveTemp(InFactory))
+{
+	check(Factory);
+	for (const FString& Host : Hosts)
+	{
+		FSpaceTimeDBEndpointResult& Result = Results.AddDefaulted_GetRef();
+		Result.Host = Host;
+	}
+	Probes.SetNum(Results.Num());
+}
+
+FSpaceTimeDBEndpointProbe::~FSpaceTimeDBEndpointProbe()
+{
+	for (FProbe& Probe : Probes)
+	{
+		if (Probe.Transport.IsValid())
+		{
+			Probe.Transport->UnbindAll();
+			Probe.Transport->Close();
+		}
+	}
+}
+
+void FSpaceTimeDBEndpointProbe::Start()
+{
+	for (int32 Index = 0; Index < Probes.Num(); ++Index)
+	{
+		FSpaceTimeDBTransportParams Params;
+		Params.Url = FString::Printf(TEXT("%s/database/subscribe/%s"), *Results[Index].Host, *ModuleName);
+		Params.Subprotocol = bBinary ? FSpaceTimeDBProtocol::BinarySubprotocol : FSpaceTimeDBProtocol::JsonSubprotocol;
+
+		// No token: a probe closing would otherwise mark our player offline
+		TSharedRef<ISpaceTimeDBTransport> Transport = Factory(Params);
+
+		// Every probe is owned by this object and unbound in its destructor
+		Transport->OnConnected.BindLambda([this, Index]() { HandleConnected(Index); });
+		Transport->OnConnectionError.BindLambda([this, Index](const FString& Error) { Fail(Index, Error); });
+		Transport->OnClosed.BindLambda([this, Index](int32 StatusCode, const FString& Reason, bool bWasClean) { Fail(Index, Reason); });
+		Transport->OnFrame.BindLambda([this, Index](TArray<uint8>& Frame, bool bFrameBinary) { HandleFrame(Index, Frame, bFrameBinary); });
+
+		Probes[Index].Transport = Transport;
+		Probes[Index].StartTime = GetTime();
+	}
+
+	// Connect only once every probe exists: a loopback answers inside Connect()
+	bStarted = true;
+	for (int32 Index = 0; Index < Probes.Num(); ++Index)
+	{
+		Probes[Index].Transport->Connect();
+	}
+
+	if (Probes.Num() == 0)
+	{
+		bDone = true;
+		if (OnComplete)
+		{
+			OnComplete();
+		}
+	}
+}
+
+void FSpaceTimeDBEndpointProbe::Tick()
+{
+	const double Now = GetTime();
+	for (int32 Index = 0; Index < Probes.Num() && !bDone; ++Index)
+	{
+		if (Probes[Index].Stage != EStage::Finished && Now - Probes[Index].StartTime > TimeoutSeconds)
+		{
+			Fail(Index, TEXT("Timed out"));
+		}
+	}
+}
+
+void FSpaceTimeDBEndpointProbe::HandleConnected(int32 Index)
+{
+	FProbe& Probe = Probes[Index];
+	if (Probe.Stage != EStage::Connecting)
+	{
+		return;
+	}
+
+	Probe.SentTime = GetTime();
+	Results[Index].HandshakeMs = (Probe.SentTime - Probe.StartTime) * 1000.0;
+	Probe.Stage = EStage::AwaitingAnswer;
+
+	if (bBinary)
+	{
+		TArray<uint8> Frame;
+		const FString Query = ProbeQuery;
+		FSpaceTimeDBProtocol::EncodeSubscribeBinary(MakeArrayView(&Query, 1), 1, Frame);
+		Probe.Transport->SendBinary(Frame.GetData(), Frame.Num());
+	}
+	else
+	{
+		FString Frame;
+		FSpaceTimeDBProtocol::EncodeSubscribeJson(ProbeQuery, Frame);
+		Probe.Transport->SendText(Frame);
+	}
+}
+
+void FSpaceTimeDBEndpointProbe::HandleFrame(int32 Index, const TArray<uint8>& Frame, bool bFrameBinary)
+{
+	FProbe& Probe = Probes[Index];
+	if (Probe.Stage != EStage::AwaitingAnswer)
+	{
+		return;
+	}
+
+	// The identity token comes unasked on connect; anything after it answers the subscribe
+	FSpaceTimeDBServerMessage Message;
+	const bool bDecoded = bFrameBinary
+		? FSpaceTimeDBProtocol::DecodeBinaryServerMessage(Frame.GetData(), Frame.Num(), Message)
+		: FSpaceTimeDBProtocol::DecodeJsonServerMessage(Frame.GetData(), Frame.Num(), Message);
+	if (bDecoded && Message.Type == ESpaceTimeDBMessageType::IdentityToken)
+	{
+		return;
+	}
+
+	Results[Index].RoundTripMs = (GetTime() - Probe.SentTime) * 1000.0;
+	Results[Index].bHealthy = true;
+	Finish(Index);
+}
+
+void FSpaceTimeDBEndpointProbe::Fail(int32 Index, const FString& Error)
+{
+	if (Probes[Index].Stage == EStage::Finished)
+	{
+		return;
+	}
+
+	Results[Index].bHealthy = false;
+	Results[Index].Error = Error;
+	Finish(Index);
+}
+
+void FSpaceTimeDBEndpointProbe::Finish(int32 Index)
+{
+	FProbe& Probe = Probes[Index];
+	Probe.Stage = EStage::Finished;
+	// Still bound: its close lands in Fail(), which ignores finished probes
+	Probe.Transport->Close();
+
+	if (!bStarted || bDone)
+	{
+		return;
+	}
+	for (const FProbe& Other : Probes)
+	{
+		if (Other.Stage != EStage::Finished)
+		{
+			return;
+		}
+	}
+
+	bDone = true;
+	if (OnComplete)
+	{
+		OnComplete();
+	}
+}
+
+TArray<FString> FSpaceTimeDBEndpointProbe::GetRanking() const
+{
+	TArray<const FSpaceTimeDBEndpointResult*> Sorted;
+	for (const FSpaceTimeDBEndpointResult& Result : Results)
+	{
+		Sorted.Add(&Result);
+	}
+	Algo::StableSort(Sorted, [](const FSpaceTimeDBEndpointResult* A, const FSpaceTimeDBEndpointResult* B)
+	{
+		if (A->bHealthy != B->bHealthy)
+		{
+			return A->bHealthy;
+		}
+		return A->bHealthy && A->GetScoreMs() < B->GetScoreMs();
+	});
+
+	TArray<FString> Ranking;
+	for (const FSpaceTimeDBEndpointResult* Result : Sorted)
+	{
+		Ranking.Add(Result->Host);
+	}
+	return Ranking;
+}
+
+// ============================================================================
+// ENDPOINT LIST
+// ============================================================================
+
+void FSpaceTimeDBEndpointList::Reset(const TArray<FString>& Hosts)
+{
+	Ranking = Hosts;
+	Candidates = Hosts;
+	Candidates.Sort();
+	ConsecutiveFailures = 0;
+	ProbedAt = 0.0;
+}
+
+void FSpaceTimeDBEndpointList::SetRanking(const TArray<FString>& Ranked)
+{
+	check(Ranked.Num() == Ranking.Num());
+	Ranking = Ranked;
+	ConsecutiveFailures = 0;
+	ProbedAt = FDateTime::UtcNow().ToUnixTimestampDecimal();
+}
+
+bool FSpaceTimeDBEndpointList::NoteFailure(int32 FailoverAfterErrors)
+{
+	if (++ConsecutiveFailures < FMath::Max(FailoverAfterErrors, 1) || Ranking.Num() < 2)
+	{
+		return false;
+	}
+
+	// The failed host stays a candidate, behind every other
+	const FString Failed = Ranking[0];
+	Ranking.RemoveAt(0);
+	Ranking.Add(Failed);
+	ConsecutiveFailures = 0;
+	return true;
+}
+
+FString FSpaceTimeDBEndpointList::ResolveCachePath(const FString& Name)
+{
+	return FPaths::IsRelative(Name) ? FPaths::Combine(FPaths::ProjectSavedDir(), Name) : Name;
+}
+
+bool FSpaceTimeDBEndpointList::LoadCache(const FString& Path, double MaxAgeSeconds)
+{
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *Path))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid())
+	{
+		return false;
+	}
+
+	TArray<FString> CachedCandidates;
+	TArray<FString> CachedRanking;
+	double CachedAt = 0.0;
+	if (!Root->TryGetStringArrayField(TEXT("candidates"), CachedCandidates) ||
+		!Root->TryGetStringArrayField(TEXT("ranking"), CachedRanking) ||
+		!Root->TryGetNumberField(TEXT("probed_at"), CachedAt))
+	{
+		return false;
+	}
+
+	CachedCandidates.Sort();
+	TArray<FString> SortedRanking = CachedRanking;
+	SortedRanking.Sort();
+	const double Age = FDateTime::UtcNow().ToUnixTimestampDecimal() - CachedAt;
+	if (CachedCandidates != Candidates || SortedRanking != Candidates || Age < 0.0 || Age > MaxAgeSeconds)
+	{
+		return false;
+	}
+
+	Ranking = MoveTemp(CachedRanking);
+	ConsecutiveFailures = 0;
+	ProbedAt = CachedAt;
+	return true;
+}
+
+void FSpaceTimeDBEndpointList::SaveCache(const FString& Path) const
+{
+	TArray<TSharedPtr<FJsonValue>> CandidateValues;
+	for (const FString& Host : Candidates)
+	{
+		CandidateValues.Add(MakeShared<FJsonValueString>(Host));
+	}
+	TArray<TSharedPtr<FJsonValue>> RankingValues;
+	for (const FString& Host : Ranking)
+	{
+		RankingValues.Add(MakeShared<FJsonValueString>(Host));
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetArrayField(TEXT("candidates"), CandidateValues);
+	Root->SetArrayField(TEXT("ranking"), RankingValues);
+	Root->SetNumberField(TEXT("probed_at"), ProbedAt);
+
+	FString Text;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Text));
+	if (!FFileHelper::SaveStringToFile(Text, *Path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Could not write endpoint cache %s"), *Path);
+	}
+}
@@ -0,0 +1,83 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBIdentity.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+	template <typename CharType>
+	bool ParseIdentityHex(const CharType* Chars, int32 Length, FSpaceTimeDBIdentity& OutIdentity)
+	{
+		if (Length >= 2 && Chars[0] == '0' && (Chars[1] == 'x' || Chars[1] == 'X'))
+		{
+			Chars += 2;
+			Length -= 2;
+		}
+		if (Length <= 0 || Length > FSpaceTimeDBIdentity::NumBytes * 2)
+		{
+			return false;
+		}
+
+		// The last digit is the low nibble of wire byte 0
+		uint8 Bytes[FSpaceTimeDBIdentity::NumBytes] = {};
+		for (int32 Digit = 0; Digit < Length; ++Digit)
+		{
+			const TCHAR Char = static_cast<TCHAR>(Chars[Length - 1 - Digit]);
+			if (!FChar::IsHexDigit(Char))
+			{
+				return false;
+			}
+			Bytes[Digit / 2] |= FParse::HexDigit(Char) << ((Digit & 1) * 4);
+		}
+
+		OutIdentity = FSpaceTimeDBIdentity::FromBytes(Bytes);
+		return true;
+	}
+}
+
+FSpaceTimeDBIdentity FSpaceTimeDBIdentity::FromBytes(const uint8* Bytes)
+{
+	FSpaceTimeDBIdentity Identity;
+	FMemory::Memcpy(Identity.Words, Bytes, NumBytes);
+
+	// Identities are already hashes, so folding the words is enough; a zero
+	// identity folds to zero like a default-constructed one
+	const uint64 Folded = (Identity.Words[0] ^ Identity.Words[1] ^ Identity.Words[2] ^ Identity.Words[3]) * 0x9E3779B97F4A7C15ull;
+	Identity.Hash = static_cast<uint32>(Folded >> 32);
+	return Identity;
+}
+
+bool FSpaceTimeDBIdentity::FromHex(FStringView Hex, FSpaceTimeDBIdentity& OutIdentity)
+{
+	return ParseIdentityHex(Hex.GetData(), Hex.Len(), OutIdentity);
+}
+
+bool FSpaceTimeDBIdentity::FromHex(const UTF8CHAR* Hex, int32 Length, FSpaceTimeDBIdentity& OutIdentity)
+{
+	return ParseIdentityHex(Hex, Length, OutIdentity);
+}
+
+FSpaceTimeDBIdentity FSpaceTimeDBIdentity::FromHex(FStringView Hex)
+{
+	FSpaceTimeDBIdentity Identity;
+	FromHex(Hex, Identity);
+	return Identity;
+}
+
+FString FSpaceTimeDBIdentity::ToHex() const
+{
+	static const TCHAR Digits[] = TEXT("0123456789abcdef");
+
+	FString Out;
+	Out.GetCharArray().SetNumUninitialized(NumBytes * 2 + 1);
+	TCHAR* Chars = Out.GetCharArray().GetData();
+	const uint8* Bytes = GetBytes();
+	for (int32 i = 0; i < NumBytes; ++i)
+	{
+		const uint8 Byte = Bytes[NumBytes - 1 - i];
+		Chars[i * 2] = Digits[Byte >> 4];
+		Chars[i * 2 + 1] = Digits[Byte & 0xF];
+	}
+	Chars[NumBytes * 2] = TEXT('\0');
+	return Out;
+}
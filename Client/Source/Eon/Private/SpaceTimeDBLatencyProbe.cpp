@@ -0,0 +1,184 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBLatencyProbe.h"
+#include "HAL/IConsoleManager.h"
+
+bool FSpaceTimeDBLatencyProbe::bActive = false;
+
+namespace
+{
+	// Sends kept per sender while waiting for peers to receive them; at 10 Hz
+	// this covers several seconds of delay
+	constexpr int32 MaxSendsPerSender = 128;
+
+	// Positions go through float columns (and text, for the JSON protocol)
+	constexpr float SentPositionTolerance = 0.01f;
+
+	FAutoConsoleCommand LatencyProbeBeginCommand(
+		TEXT("Eon.LatencyProbe.Begin"),
+		TEXT("Start measuring motion-to-display latency between clients in this process."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FSpaceTimeDBLatencyProbe::Get().Begin();
+			UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Latency probe started"));
+		}));
+
+	FAutoConsoleCommand LatencyProbeEndCommand(
+		TEXT("Eon.LatencyProbe.End"),
+		TEXT("Stop the latency probe and log its percentiles."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Latency probe %s"), *FSpaceTimeDBLatencyProbe::Get().End().ToString());
+		}));
+}
+
+FSpaceTimeDBLatencyPercentiles FSpaceTimeDBLatencyPercentiles::FromSamples(TArray<double> SamplesMs)
+{
+	FSpaceTimeDBLatencyPercentiles Result;
+	Result.Samples = SamplesMs.Num();
+	if (SamplesMs.Num() == 0)
+	{
+		return Result;
+	}
+
+	SamplesMs.Sort();
+	for (double Ms : SamplesMs)
+	{
+		Result.MeanMs += Ms;
+	}
+	Result.MeanMs /= SamplesMs.Num();
+	Result.P50Ms = SamplesMs[SamplesMs.Num() / 2];
+	Result.P90Ms = SamplesMs[FMath::Min(SamplesMs.Num() - 1, SamplesMs.Num() * 90 / 100)];
+	Result.P99Ms = SamplesMs[FMath::Min(SamplesMs.Num() - 1, SamplesMs.Num() * 99 / 100)];
+	Result.MaxMs = SamplesMs.Last();
+	return Result;
+}
+
+FString FSpaceTimeDBLatencyPercentiles::ToString() const
+{
+	return FString::Printf(TEXT("n=%d mean %.1f / p50 %.1f / p90 %.1f / p99 %.1f / max %.1f ms"),
+		Samples, MeanMs, P50Ms, P90Ms, P99Ms, MaxMs);
+}
+
+FString FSpaceTimeDBLatencyReport::ToString() const
+{
+	return FString::Printf(TEXT("%.1fs, %d sent, %d received, %d displayed, %d superseded; receive %s; display %s"),
+		Seconds, Sent, Received, Displayed, Superseded, *ToReceive.ToString(), *ToDisplay.ToString());
+}
+
+FSpaceTimeDBLatencyProbe& FSpaceTimeDBLatencyProbe::Get()
+{
+	static FSpaceTimeDBLatencyProbe Probe;
+	return Probe;
+}
+
+void FSpaceTimeDBLatencyProbe::Begin()
+{
+	Sends.Reset();
+	Tracks.Reset();
+	ReceiveMs.Reset();
+	DisplayMs.Reset();
+	NextSequence = 1;
+	NumSent = 0;
+	NumSuperseded = 0;
+	BeginTime = GetTime();
+	bActive = true;
+}
+
+FSpaceTimeDBLatencyReport FSpaceTimeDBLatencyProbe::End()
+{
+	FSpaceTimeDBLatencyReport Report = GetReport();
+	bActive = false;
+	return Report;
+}
+
+FSpaceTimeDBLatencyReport FSpaceTimeDBLatencyProbe::GetReport() const
+{
+	FSpaceTimeDBLatencyReport Report;
+	Report.Seconds = GetTime() - BeginTime;
+	Report.Sent = NumSent;
+	Report.Received = ReceiveMs.Num();
+	Report.Displayed = DisplayMs.Num();
+	Report.Superseded = NumSuperseded;
+	Report.ToReceive = FSpaceTimeDBLatencyPercentiles::FromSamples(ReceiveMs);
+	Report.ToDisplay = FSpaceTimeDBLatencyPercentiles::FromSamples(DisplayMs);
+	return Report;
+}
+
+void FSpaceTimeDBLatencyProbe::NoteSent(const FSpaceTimeDBIdentity& Sender, const FVector3f& Position)
+{
+	if (!bActive || !Sender.IsValid())
+	{
+		return;
+	}
+
+	// Only motion is measured: a resend of the same position changes nothing on screen
+	TArray<FSent>& History = Sends.FindOrAdd(Sender);
+	if (History.Num() > 0 && History.Last().Position.Equals(Position, SentPositionTolerance))
+	{
+		return;
+	}
+	if (History.Num() >= MaxSendsPerSender)
+	{
+		History.RemoveAt(0, History.Num() - MaxSendsPerSender + 1, EAllowShrinking::No);
+	}
+	History.Add({ NextSequence++, GetTime(), Position });
+	++NumSent;
+}
+
+void FSpaceTimeDBLatencyProbe::NoteReceived(const void* Observer, const FSpaceTimeDBIdentity& Sender, const FVector3f& Position)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	const TArray<FSent>* History = Sends.Find(Sender);
+	if (!History)
+	{
+		return;
+	}
+
+	// The oldest send after the last one this observer saw; sends skipped on
+	// the way (coalesced or overwritten on the server) never arrive
+	FTrack& Track = Tracks.FindOrAdd(TPair<const void*, FSpaceTimeDBIdentity>(Observer, Sender));
+	for (const FSent& Sent : *History)
+	{
+		if (Sent.Sequence > Track.LastReceived && Sent.Position.Equals(Position, SentPositionTolerance))
+		{
+			ReceiveMs.Add((GetTime() - Sent.Time) * 1000.0);
+			Track.LastReceived = Sent.Sequence;
+			Track.AwaitingDisplay.Add(Sent);
+			return;
+		}
+	}
+}
+
+void FSpaceTimeDBLatencyProbe::NoteDisplayed(const void* Observer, const FSpaceTimeDBIdentity& Sender, const FVector& DisplayPosition)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	FTrack* Track = Tracks.Find(TPair<const void*, FSpaceTimeDBIdentity>(Observer, Sender));
+	if (!Track || Track->AwaitingDisplay.Num() == 0)
+	{
+		return;
+	}
+
+	// The newest received position the display has reached; anything older
+	// was overtaken before interpolation settled on it
+	const float ToleranceSquared = ToleranceCm * ToleranceCm;
+	for (int32 i = Track->AwaitingDisplay.Num() - 1; i >= 0; --i)
+	{
+		const FSent& Sent = Track->AwaitingDisplay[i];
+		if (FVector::DistSquared(DisplayPosition, FVector(Sent.Position)) <= ToleranceSquared)
+		{
+			DisplayMs.Add((GetTime() - Sent.Time) * 1000.0);
+			NumSuperseded += i;
+			Track->AwaitingDisplay.RemoveAt(0, i + 1, EAllowShrinking::No);
+			return;
+		}
+	}
+}
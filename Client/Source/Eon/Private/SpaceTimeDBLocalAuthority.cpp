@@ -0,0 +1,747 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBLocalAuthority.h"
+#include "SpaceTimeDBReducers.h"
+#include "SpaceTimeDBTableCache.h"
+
+namespace
+{
+	// Same as the manager's reply timeout: a call the server has not answered by then never will be
+	constexpr double UnansweredCallSeconds = 30.0;
+
+	// Calls kept for the server while there is no connection. Beyond this the
+	// oldest is folded into the confirmed rows and no longer synced.
+	constexpr int32 MaxPendingCalls = 1024;
+
+	// lib.rs picks the first free slot below this, else slot 0
+	constexpr uint32 MaxInventorySlots = 100;
+
+	const TCHAR* const ConsumableItemType = TEXT("consumable");
+	const TCHAR* const HealthPotionItemId = TEXT("health_potion");
+	constexpr float HealthPotionAmount = 50.0f;
+
+	template <typename RowType>
+	void AddUpdate(TArray<TSpaceTimeDBRowUpdate<RowType>>& Out, const RowType& Row, ESpaceTimeDBRowOp Op)
+	{
+		TSpaceTimeDBRowUpdate<RowType>& Update = Out.AddDefaulted_GetRef();
+		Update.Row = Row;
+		Update.Op = Op;
+	}
+
+	template <typename KeyType, typename RowType>
+	void ApplyRows(TSpaceTimeDBKeyMap<KeyType, RowType>& Table, const TArray<TSpaceTimeDBRowUpdate<RowType>>& Updates, bool bSnapshot)
+	{
+		if (bSnapshot)
+		{
+			Table.Reset();
+		}
+		for (const TSpaceTimeDBRowUpdate<RowType>& Update : Updates)
+		{
+			if (Update.Op == ESpaceTimeDBRowOp::Delete)
+			{
+				Table.Remove(Update.Row.GetKey());
+			}
+			else
+			{
+				Table.Add(Update.Row.GetKey(), Update.Row);
+			}
+		}
+	}
+
+	// Upserts for rows that are new or changed, deletes for rows that are gone.
+	// A snapshot lists every row, since the table cache replaces the whole table.
+	template <typename KeyType, typename RowType>
+	void DiffRows(const TSpaceTimeDBKeyMap<KeyType, RowType>& From, const TSpaceTimeDBKeyMap<KeyType, RowType>& To, TArray<TSpaceTimeDBRowUpdate<RowType>>& Out, bool bSnapshot)
+	{
+		for (const TPair<KeyType, RowType>& Pair : To)
+		{
+			const RowType* Old = From.Find(Pair.Key);
+			if (bSnapshot || !Old || !(*Old == Pair.Value))
+			{
+				AddUpdate(Out, Pair.Value, ESpaceTimeDBRowOp::Upsert);
+			}
+		}
+
+		for (const TPair<KeyType, RowType>& Pair : From)
+		{
+			if (!To.Contains(Pair.Key))
+			{
+				AddUpdate(Out, Pair.Value, ESpaceTimeDBRowOp::Delete);
+			}
+		}
+	}
+
+	// lib.rs scans inventory_item in table order, which follows the auto_inc entry id
+	FSpaceTimeDBInventoryRow* FindStack(FSpaceTimeDBLocalAuthority::FStore& Store, const FSpaceTimeDBIdentity& Sender, const FString& ItemId)
+	{
+		FSpaceTimeDBInventoryRow* Found = nullptr;
+		for (TPair<uint64, FSpaceTimeDBInventoryRow>& Pair : Store.Inventory)
+		{
+			FSpaceTimeDBInventoryRow& Row = Pair.Value;
+			if (Row.OwnerIdentity == Sender && Row.ItemId.Equals(ItemId, ESearchCase::CaseSensitive) && (!Found || Row.EntryId < Found->EntryId))
+			{
+				Found = &Row;
+			}
+		}
+		return Found;
+	}
+
+	uint32 FindFreeSlot(const FSpaceTimeDBLocalAuthority::FStore& Store, const FSpaceTimeDBIdentity& Sender)
+	{
+		TSet<uint32> UsedSlots;
+		for (const TPair<uint64, FSpaceTimeDBInventoryRow>& Pair : Store.Inventory)
+		{
+			if (Pair.Value.OwnerIdentity == Sender)
+			{
+				UsedSlots.Add(Pair.Value.SlotIndex);
+			}
+		}
+
+		for (uint32 Slot = 0; Slot < MaxInventorySlots; ++Slot)
+		{
+			if (!UsedSlots.Contains(Slot))
+			{
+				return Slot;
+			}
+		}
+		return 0;
+	}
+
+	// The shared tail of add_item_to_inventory and collect_world_item
+	void AddToStackOrSlot(FSpaceTimeDBLocalAuthority::FStore& Store, const FSpaceTimeDBIdentity& Sender, const FString& ItemId, uint32 Quantity, uint32 MaxStack, uint64 NewEntryId)
+	{
+		if (FSpaceTimeDBInventoryRow* Stack = FindStack(Store, Sender, ItemId))
+		{
+			Stack->Quantity = static_cast<uint32>(FMath::Min<uint64>(static_cast<uint64>(Stack->Quantity) + Quantity, MaxStack));
+			return;
+		}
+
+		FSpaceTimeDBInventoryRow Row;
+		Row.EntryId = NewEntryId;
+		Row.OwnerIdentity = Sender;
+		Row.ItemId = ItemId;
+		Row.Quantity = FMath::Min(Quantity, MaxStack);
+		Row.SlotIndex = FindFreeSlot(Store, Sender);
+		Store.Inventory.Add(NewEntryId, MoveTemp(Row));
+	}
+
+	FSpaceTimeDBItemDefinitionRow MakeDefinition(const TCHAR* ItemId, const TCHAR* DisplayName, const TCHAR* Description, const TCHAR* ItemType, uint32 MaxStack, uint8 Rarity)
+	{
+		FSpaceTimeDBItemDefinitionRow Row;
+		Row.ItemId = ItemId;
+		Row.DisplayName = DisplayName;
+		Row.Description = Description;
+		Row.ItemType = ItemType;
+		Row.MaxStack = MaxStack;
+		Row.IconPath = FString::Printf(TEXT("/Game/UI/Icons/%s"), ItemId);
+		Row.Rarity = Rarity;
+		return Row;
+	}
+}
+
+// ============================================================================
+// REDUCERS
+// ============================================================================
+
+void FSpaceTimeDBLocalAuthority::AddItemToInventory(FStore& Store, const FSpaceTimeDBIdentity& Sender, const FString& ItemId, uint32 Quantity, uint64 NewEntryId)
+{
+	const FSpaceTimeDBItemDefinitionRow* Definition = Store.ItemDefinitions.Find(ItemId);
+	if (!Definition)
+	{
+		return;
+	}
+
+	AddToStackOrSlot(Store, Sender, ItemId, Quantity, Definition->MaxStack, NewEntryId);
+}
+
+void FSpaceTimeDBLocalAuthority::RemoveItemFromInventory(FStore& Store, const FSpaceTimeDBIdentity& Sender, uint64 EntryId, uint32 Quantity)
+{
+	FSpaceTimeDBInventoryRow* Entry = Store.Inventory.Find(EntryId);
+	if (!Entry || Entry->OwnerIdentity != Sender)
+	{
+		return;
+	}
+
+	if (Quantity >= Entry->Quantity)
+	{
+		Store.Inventory.Remove(EntryId);
+	}
+	else
+	{
+		Entry->Quantity -= Quantity;
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::UseConsumable(FStore& Store, const FSpaceTimeDBIdentity& Sender, uint64 EntryId)
+{
+	FSpaceTimeDBInventoryRow* Entry = Store.Inventory.Find(EntryId);
+	if (!Entry || Entry->OwnerIdentity != Sender)
+	{
+		return;
+	}
+
+	const FSpaceTimeDBItemDefinitionRow* Definition = Store.ItemDefinitions.Find(Entry->ItemId);
+	if (!Definition || !Definition->ItemType.Equals(ConsumableItemType, ESearchCase::CaseSensitive))
+	{
+		return;
+	}
+
+	// Mana potions have no effect on the server yet either
+	if (Store.Player.IsSet() && Store.Player->Identity == Sender && Entry->ItemId.Equals(HealthPotionItemId, ESearchCase::CaseSensitive))
+	{
+		Store.Player->Health = FMath::Min(Store.Player->Health + HealthPotionAmount, Store.Player->MaxHealth);
+	}
+
+	if (Entry->Quantity <= 1)
+	{
+		Store.Inventory.Remove(EntryId);
+	}
+	else
+	{
+		--Entry->Quantity;
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::CollectWorldItem(FStore& Store, const FSpaceTimeDBIdentity& Sender, uint64 WorldItemId, uint64 NewEntryId)
+{
+	FSpaceTimeDBWorldItemRow* WorldItem = Store.WorldItems.Find(WorldItemId);
+	if (!WorldItem || WorldItem->bIsCollected)
+	{
+		return;
+	}
+
+	// Marked collected even when the item has no definition, as on the server
+	WorldItem->bIsCollected = true;
+
+	const FSpaceTimeDBItemDefinitionRow* Definition = Store.ItemDefinitions.Find(WorldItem->ItemId);
+	if (!Definition)
+	{
+		return;
+	}
+
+	const FString ItemId = WorldItem->ItemId;
+	AddToStackOrSlot(Store, Sender, ItemId, WorldItem->Quantity, Definition->MaxStack, NewEntryId);
+}
+
+void FSpaceTimeDBLocalAuthority::ToggleInteractable(FStore& Store, const FString& InteractableId)
+{
+	if (FSpaceTimeDBInteractableRow* Interactable = Store.Interactables.Find(InteractableId))
+	{
+		Interactable->bIsActive = !Interactable->bIsActive;
+	}
+}
+
+bool FSpaceTimeDBLocalAuthority::HandlesReducer(const FString& ReducerName)
+{
+	return ReducerName == EonReducers::AddItemToInventory.Name || ReducerName == EonReducers::RemoveItemFromInventory.Name ||
+		ReducerName == EonReducers::UseConsumable.Name || ReducerName == EonReducers::CollectWorldItem.Name ||
+		ReducerName == EonReducers::ToggleInteractable.Name;
+}
+
+bool FSpaceTimeDBLocalAuthority::ParseCall(const FString& ReducerName, const FSpaceTimeDBArgList& Args, EReducer& OutReducer)
+{
+	auto ArgsAre = [&Args](std::initializer_list<ESpaceTimeDBArgType> Types)
+	{
+		if (Args.Num() != static_cast<int32>(Types.size()))
+		{
+			return false;
+		}
+		int32 Index = 0;
+		for (ESpaceTimeDBArgType Type : Types)
+		{
+			if (Args[Index++].Type != Type)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	if (ReducerName == EonReducers::AddItemToInventory.Name && ArgsAre({ ESpaceTimeDBArgType::String, ESpaceTimeDBArgType::U32 }))
+	{
+		OutReducer = EReducer::AddItemToInventory;
+	}
+	else if (ReducerName == EonReducers::RemoveItemFromInventory.Name && ArgsAre({ ESpaceTimeDBArgType::U64, ESpaceTimeDBArgType::U32 }))
+	{
+		OutReducer = EReducer::RemoveItemFromInventory;
+	}
+	else if (ReducerName == EonReducers::UseConsumable.Name && ArgsAre({ ESpaceTimeDBArgType::U64 }))
+	{
+		OutReducer = EReducer::UseConsumable;
+	}
+	else if (ReducerName == EonReducers::CollectWorldItem.Name && ArgsAre({ ESpaceTimeDBArgType::U64 }))
+	{
+		OutReducer = EReducer::CollectWorldItem;
+	}
+	else if (ReducerName == EonReducers::ToggleInteractable.Name && ArgsAre({ ESpaceTimeDBArgType::String }))
+	{
+		OutReducer = EReducer::ToggleInteractable;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+void FSpaceTimeDBLocalAuthority::ApplyCall(FStore& Store, const FPendingCall& Call) const
+{
+	const FSpaceTimeDBArgList& Args = Call.Args;
+	switch (Call.Reducer)
+	{
+	case EReducer::AddItemToInventory:
+		AddItemToInventory(Store, Identity, Args[0].StringValue, Args[1].U32Value, Call.NewEntryId);
+		break;
+	case EReducer::RemoveItemFromInventory:
+		RemoveItemFromInventory(Store, Identity, ResolveEntryId(Args[0].U64Value), Args[1].U32Value);
+		break;
+	case EReducer::UseConsumable:
+		UseConsumable(Store, Identity, ResolveEntryId(Args[0].U64Value));
+		break;
+	case EReducer::CollectWorldItem:
+		CollectWorldItem(Store, Identity, Args[0].U64Value, Call.NewEntryId);
+		break;
+	case EReducer::ToggleInteractable:
+		ToggleInteractable(Store, Args[0].StringValue);
+		break;
+	}
+}
+
+// ============================================================================
+// LOCAL CALLS
+// ============================================================================
+
+void FSpaceTimeDBLocalAuthority::Seed(const USpaceTimeDBTableCache& Cache)
+{
+	for (const FSpaceTimeDBInventoryRow& Row : Cache.InventoryItems().GetRows())
+	{
+		Confirmed.Inventory.Add(Row.EntryId, Row);
+	}
+	for (const FSpaceTimeDBWorldItemRow& Row : Cache.WorldItems().GetRows())
+	{
+		Confirmed.WorldItems.Add(Row.WorldItemId, Row);
+	}
+	for (const FSpaceTimeDBInteractableRow& Row : Cache.Interactables().GetRows())
+	{
+		Confirmed.Interactables.Add(Row.InteractableId, Row);
+	}
+	for (const FSpaceTimeDBItemDefinitionRow& Row : Cache.ItemDefinitions().GetRows())
+	{
+		Confirmed.ItemDefinitions.Add(Row.ItemId, Row);
+	}
+	if (const FSpaceTimeDBPlayerRow* Player = Cache.Players().Find(Identity))
+	{
+		Confirmed.Player = *Player;
+	}
+
+	// Listeners already hold these rows
+	Predicted = Confirmed;
+	Visible = Confirmed;
+}
+
+void FSpaceTimeDBLocalAuthority::AddDefaultItemDefinitions(FSpaceTimeDBServerMessage& OutChanges)
+{
+	OutChanges.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+
+	// The standard items of init(); premium items only come from the server
+	const FSpaceTimeDBItemDefinitionRow Defaults[] = {
+		MakeDefinition(TEXT("health_potion"), TEXT("Health Potion"), TEXT("Restores 50 health points."), TEXT("consumable"), 10, 0),
+		MakeDefinition(TEXT("mana_potion"), TEXT("Mana Potion"), TEXT("Restores 50 mana points."), TEXT("consumable"), 10, 0),
+		MakeDefinition(TEXT("gold_coin"), TEXT("Gold Coin"), TEXT("Currency."), TEXT("resource"), 999, 0),
+		MakeDefinition(TEXT("iron_sword"), TEXT("Iron Sword"), TEXT("A basic iron sword."), TEXT("weapon"), 1, 1),
+		MakeDefinition(TEXT("wooden_shield"), TEXT("Wooden Shield"), TEXT("A basic wooden shield."), TEXT("weapon"), 1, 0)
+	};
+
+	for (const FSpaceTimeDBItemDefinitionRow& Row : Defaults)
+	{
+		if (!Confirmed.ItemDefinitions.Contains(Row.ItemId))
+		{
+			Confirmed.ItemDefinitions.Add(Row.ItemId, Row);
+			Predicted.ItemDefinitions.Add(Row.ItemId, Row);
+			AddUpdate(OutChanges.ItemDefinitions, Row, ESpaceTimeDBRowOp::Upsert);
+		}
+	}
+}
+
+bool FSpaceTimeDBLocalAuthority::Call(const FString& ReducerName, const FSpaceTimeDBArgList& Args, FSpaceTimeDBServerMessage& OutChanges)
+{
+	FPendingCall NewCall;
+	if (!ParseCall(ReducerName, Args, NewCall.Reducer))
+	{
+		return false;
+	}
+
+	NewCall.LocalCallId = NextLocalCallId++;
+	NewCall.ReducerName = ReducerName;
+	NewCall.Args = Args;
+	if (NewCall.Reducer == EReducer::AddItemToInventory || NewCall.Reducer == EReducer::CollectWorldItem)
+	{
+		NewCall.NewEntryId = NextLocalEntryId++;
+	}
+
+	// Predicted already holds every earlier pending call, so this one goes on top
+	ApplyCall(Predicted, NewCall);
+	Pending.Add(MoveTemp(NewCall));
+
+	if (Pending.Num() > MaxPendingCalls)
+	{
+		CommitOldestCall();
+	}
+
+	OutChanges.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+	OutChanges.CallerIdentity = Identity;
+	EmitVisibleChanges(OutChanges, false);
+	return true;
+}
+
+void FSpaceTimeDBLocalAuthority::CommitOldestCall()
+{
+	// Only calls never handed to the manager can be folded in; the rest are the server's to settle
+	if (Pending[0].bReleased)
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: %d local calls waiting for the server, %s will not be synced"),
+		Pending.Num(), *Pending[0].ReducerName);
+	ApplyCall(Confirmed, Pending[0]);
+	Pending.RemoveAt(0);
+}
+
+uint64 FSpaceTimeDBLocalAuthority::ResolveEntryId(uint64 EntryId) const
+{
+	const uint64* ServerEntryId = EntryId >= LocalEntryIdBase ? EntryIdAliases.Find(EntryId) : nullptr;
+	return ServerEntryId ? *ServerEntryId : EntryId;
+}
+
+bool FSpaceTimeDBLocalAuthority::IsEntryIdAssigned(uint64 EntryId) const
+{
+	if (EntryId < LocalEntryIdBase || EntryIdAliases.Contains(EntryId))
+	{
+		return true;
+	}
+
+	// Unassigned only while the call that inserts it is still waiting; otherwise
+	// the row never existed on the server and the call will find nothing there either
+	return !Pending.ContainsByPredicate([EntryId](const FPendingCall& Call) { return Call.NewEntryId == EntryId; });
+}
+
+// ============================================================================
+// SERVER SYNC
+// ============================================================================
+
+void FSpaceTimeDBLocalAuthority::TakeCallsToSend(TArray<FSpaceTimeDBReducerCall>& OutCalls, double Now)
+{
+	for (FPendingCall& Call : Pending)
+	{
+		if (Call.bReleased)
+		{
+			continue;
+		}
+
+		const bool bNamesEntry = Call.Reducer == EReducer::RemoveItemFromInventory || Call.Reducer == EReducer::UseConsumable;
+		if (bNamesEntry && !IsEntryIdAssigned(Call.Args[0].U64Value))
+		{
+			// Order matters: nothing overtakes a call that is waiting
+			return;
+		}
+
+		FSpaceTimeDBReducerCall& Out = OutCalls.AddDefaulted_GetRef();
+		Out.ReducerName = Call.ReducerName;
+		Out.Args = Call.Args;
+		Out.LocalCallId = Call.LocalCallId;
+		if (bNamesEntry)
+		{
+			Out.Args[0].U64Value = ResolveEntryId(Call.Args[0].U64Value);
+		}
+
+		Call.bReleased = true;
+		Call.ReleasedAt = Now;
+	}
+}
+
+int32 FSpaceTimeDBLocalAuthority::GetNumUnsentCalls() const
+{
+	int32 Unsent = 0;
+	for (const FPendingCall& Call : Pending)
+	{
+		Unsent += Call.bReleased ? 0 : 1;
+	}
+	return Unsent;
+}
+
+void FSpaceTimeDBLocalAuthority::NoteSent(uint32 LocalCallId, uint32 RequestId)
+{
+	if (FPendingCall* Call = Pending.FindByPredicate([LocalCallId](const FPendingCall& Candidate) { return Candidate.LocalCallId == LocalCallId; }))
+	{
+		Call->RequestId = RequestId;
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::NoteUnsent(uint32 LocalCallId)
+{
+	// Not in flight after all, so no snapshot is needed to tell whether it ran
+	if (FPendingCall* Call = Pending.FindByPredicate([LocalCallId](const FPendingCall& Candidate) { return Candidate.LocalCallId == LocalCallId; }))
+	{
+		Call->RequestId = 0;
+		Call->bAwaitingSnapshot = false;
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::NoteQueueDropped()
+{
+	for (FPendingCall& Call : Pending)
+	{
+		if (Call.bReleased && Call.RequestId == 0)
+		{
+			Call.bReleased = false;
+		}
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::NoteConnectionLost()
+{
+	// Sending again could run a call twice; the snapshot after reconnecting says whether it ran
+	for (FPendingCall& Call : Pending)
+	{
+		Call.bAwaitingSnapshot |= Call.RequestId != 0;
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::Tick(double Now, FSpaceTimeDBServerMessage& OutChanges)
+{
+	const int32 Removed = Pending.RemoveAll([Now](const FPendingCall& Call)
+	{
+		return Call.bReleased && Now - Call.ReleasedAt > UnansweredCallSeconds;
+	});
+	if (Removed == 0)
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: %d local calls were never answered, rolling them back"), Removed);
+	OutChanges.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+	OutChanges.CallerIdentity = Identity;
+	Rebase(OutChanges, false);
+}
+
+void FSpaceTimeDBLocalAuthority::ApplyServerMessage(const FSpaceTimeDBServerMessage& Message, FSpaceTimeDBServerMessage& OutMessage)
+{
+	if (Message.Type != ESpaceTimeDBMessageType::InitialSubscription && Message.Type != ESpaceTimeDBMessageType::TransactionUpdate)
+	{
+		OutMessage = Message;
+		return;
+	}
+
+	// A subscription replaces the whole query set, as in the table cache
+	const bool bSnapshot = Message.Type == ESpaceTimeDBMessageType::InitialSubscription;
+
+	TSet<uint64> InsertedEntryIds;
+	ApplyConfirmedRows(Message, bSnapshot, InsertedEntryIds);
+
+	// Our call has now run on the server, so its effects are in the confirmed rows
+	const bool bOwnCall = Message.RequestId != 0 && (!Message.CallerIdentity.IsValid() || Message.CallerIdentity == Identity);
+	const int32 Answered = bOwnCall ? Pending.IndexOfByPredicate([&Message](const FPendingCall& Call) { return Call.RequestId == Message.RequestId; }) : INDEX_NONE;
+	if (Answered != INDEX_NONE)
+	{
+		ConfirmCall(Pending[Answered], Message, InsertedEntryIds);
+		Pending.RemoveAt(Answered);
+	}
+	if (bSnapshot)
+	{
+		Pending.RemoveAll([](const FPendingCall& Call) { return Call.bAwaitingSnapshot; });
+	}
+
+	OutMessage.Type = Message.Type;
+	OutMessage.Identity = Message.Identity;
+	OutMessage.CallerIdentity = Message.CallerIdentity;
+	OutMessage.RequestId = Message.RequestId;
+	OutMessage.TimestampMicros = Message.TimestampMicros;
+	OutMessage.Instances = Message.Instances;
+	OutMessage.ItemDefinitions = Message.ItemDefinitions;
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBPlayerRow>& Update : Message.Players)
+	{
+		if (Update.Row.Identity != Identity)
+		{
+			OutMessage.Players.Add(Update);
+		}
+	}
+
+	Rebase(OutMessage, bSnapshot);
+}
+
+void FSpaceTimeDBLocalAuthority::ApplyConfirmedRows(const FSpaceTimeDBServerMessage& Message, bool bSnapshot, TSet<uint64>& OutInsertedEntryIds)
+{
+	if (bSnapshot)
+	{
+		Confirmed.Inventory.Reset();
+		Confirmed.Player.Reset();
+	}
+
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>& Update : Message.InventoryItems)
+	{
+		// The JSON protocol reports a deleted stack as quantity 0
+		if (Update.Op == ESpaceTimeDBRowOp::Delete || Update.Row.Quantity == 0)
+		{
+			Confirmed.Inventory.Remove(Update.Row.EntryId);
+			VisibleEntryIds.Remove(Update.Row.EntryId);
+		}
+		else
+		{
+			if (!Confirmed.Inventory.Contains(Update.Row.EntryId))
+			{
+				OutInsertedEntryIds.Add(Update.Row.EntryId);
+			}
+			Confirmed.Inventory.Add(Update.Row.EntryId, Update.Row);
+		}
+	}
+
+	ApplyRows(Confirmed.WorldItems, Message.WorldItems, bSnapshot);
+	ApplyRows(Confirmed.Interactables, Message.Interactables, bSnapshot);
+	ApplyRows(Confirmed.ItemDefinitions, Message.ItemDefinitions, bSnapshot);
+
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBPlayerRow>& Update : Message.Players)
+	{
+		if (Update.Row.Identity != Identity)
+		{
+			continue;
+		}
+
+		if (Update.Op == ESpaceTimeDBRowOp::Delete)
+		{
+			Confirmed.Player.Reset();
+		}
+		else
+		{
+			Confirmed.Player = Update.Row;
+		}
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::ConfirmCall(const FPendingCall& Call, const FSpaceTimeDBServerMessage& Message, const TSet<uint64>& InsertedEntryIds)
+{
+	if (Call.NewEntryId == 0)
+	{
+		return;
+	}
+
+	FString ItemId;
+	if (Call.Reducer == EReducer::AddItemToInventory)
+	{
+		ItemId = Call.Args[0].StringValue;
+	}
+	else if (const FSpaceTimeDBWorldItemRow* WorldItem = Confirmed.WorldItems.Find(Call.Args[0].U64Value))
+	{
+		ItemId = WorldItem->ItemId;
+	}
+
+	// The row the server stacked onto or inserted. Only an inserted row takes over the
+	// local id listeners know; a stack they already hold by its own id.
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>& Update : Message.InventoryItems)
+	{
+		const FSpaceTimeDBInventoryRow& Row = Update.Row;
+		if (Update.Op == ESpaceTimeDBRowOp::Upsert && Row.Quantity > 0 && Row.OwnerIdentity == Identity && Row.ItemId.Equals(ItemId, ESearchCase::CaseSensitive))
+		{
+			EntryIdAliases.Add(Call.NewEntryId, Row.EntryId);
+			if (InsertedEntryIds.Contains(Row.EntryId))
+			{
+				VisibleEntryIds.Add(Row.EntryId, Call.NewEntryId);
+			}
+			return;
+		}
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::Rebase(FSpaceTimeDBServerMessage& OutChanges, bool bSnapshot)
+{
+	Predicted = Confirmed;
+	for (const FPendingCall& Call : Pending)
+	{
+		ApplyCall(Predicted, Call);
+	}
+	EmitVisibleChanges(OutChanges, bSnapshot);
+}
+
+void FSpaceTimeDBLocalAuthority::EmitVisibleChanges(FSpaceTimeDBServerMessage& OutChanges, bool bSnapshot)
+{
+	// Listeners know confirmed rows a local call inserted by the local id
+	FStore NewVisible;
+	NewVisible.Inventory.Reserve(Predicted.Inventory.Num());
+	for (const TPair<uint64, FSpaceTimeDBInventoryRow>& Pair : Predicted.Inventory)
+	{
+		FSpaceTimeDBInventoryRow Row = Pair.Value;
+		if (const uint64* VisibleId = VisibleEntryIds.Find(Pair.Key))
+		{
+			Row.EntryId = *VisibleId;
+		}
+		NewVisible.Inventory.Add(Row.EntryId, MoveTemp(Row));
+	}
+	NewVisible.WorldItems = Predicted.WorldItems;
+	NewVisible.Interactables = Predicted.Interactables;
+	NewVisible.Player = Predicted.Player;
+
+	DiffRows(Visible.Inventory, NewVisible.Inventory, OutChanges.InventoryItems, bSnapshot);
+	DiffRows(Visible.WorldItems, NewVisible.WorldItems, OutChanges.WorldItems, bSnapshot);
+	DiffRows(Visible.Interactables, NewVisible.Interactables, OutChanges.Interactables, bSnapshot);
+
+	if (NewVisible.Player.IsSet())
+	{
+		if (bSnapshot || !Visible.Player.IsSet() || !(*Visible.Player == *NewVisible.Player))
+		{
+			AddUpdate(OutChanges.Players, *NewVisible.Player, ESpaceTimeDBRowOp::Upsert);
+		}
+	}
+	else if (Visible.Player.IsSet())
+	{
+		AddUpdate(OutChanges.Players, *Visible.Player, ESpaceTimeDBRowOp::Delete);
+	}
+
+	Visible = MoveTemp(NewVisible);
+}
+
+void FSpaceTimeDBLocalAuthority::HandleInstanceChanged(TOptional<uint64> InstanceId)
+{
+	auto IsOtherInstance = [&InstanceId](uint64 RowInstanceId) { return !InstanceId.IsSet() || RowInstanceId != InstanceId.GetValue(); };
+	for (FStore* Store : { &Confirmed, &Predicted, &Visible })
+	{
+		for (auto It = Store->WorldItems.CreateIterator(); It; ++It)
+		{
+			if (IsOtherInstance(It.Value().InstanceId))
+			{
+				It.RemoveCurrent();
+			}
+		}
+		for (auto It = Store->Interactables.CreateIterator(); It; ++It)
+		{
+			if (IsOtherInstance(It.Value().InstanceId))
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+void FSpaceTimeDBLocalAuthority::GetVisibleRows(FSpaceTimeDBServerMessage& OutRows) const
+{
+	OutRows.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+	for (const TPair<uint64, FSpaceTimeDBInventoryRow>& Pair : Visible.Inventory)
+	{
+		AddUpdate(OutRows.InventoryItems, Pair.Value, ESpaceTimeDBRowOp::Upsert);
+	}
+	for (const TPair<uint64, FSpaceTimeDBWorldItemRow>& Pair : Visible.WorldItems)
+	{
+		AddUpdate(OutRows.WorldItems, Pair.Value, ESpaceTimeDBRowOp::Upsert);
+	}
+	for (const TPair<FString, FSpaceTimeDBInteractableRow>& Pair : Visible.Interactables)
+	{
+		AddUpdate(OutRows.Interactables, Pair.Value, ESpaceTimeDBRowOp::Upsert);
+	}
+	for (const TPair<FString, FSpaceTimeDBItemDefinitionRow>& Pair : Confirmed.ItemDefinitions)
+	{
+		AddUpdate(OutRows.ItemDefinitions, Pair.Value, ESpaceTimeDBRowOp::Upsert);
+	}
+	if (Visible.Player.IsSet())
+	{
+		AddUpdate(OutRows.Players, *Visible.Player, ESpaceTimeDBRowOp::Upsert);
+	}
+}
@@ -1,11 +1,99 @@
 // Copyright 2026 tbassignana. MIT License.
 
 #include "SpaceTimeDBManager.h"
-#include "WebSocketsModule.h"
+#include "SpaceTimeDBStats.h"
+#include "SpaceTimeDBTableCache.h"
+#include "SpaceTimeDBLatencyProbe.h"
+#include "EonTransformCodec.h"
+#include "Modules/ModuleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 #include "Json.h"
 #include "JsonUtilities.h"
-#include "TimerManager.h"
-#include "Engine/World.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Inbound Queue Depth"), STAT_EonNetInboundDepth, STATGROUP_EonNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Decoded Queue Depth"), STAT_EonNetDecodedDepth, STATGROUP_EonNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Messages Drained"), STAT_EonNetMessagesDrained, STATGROUP_EonNet);
+DECLARE_CYCLE_STAT(TEXT("Drain"), STAT_EonNetDrain, STATGROUP_EonNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Bytes In/s"), STAT_EonNetBytesInRate, STATGROUP_EonNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Bytes Out/s"), STAT_EonNetBytesOutRate, STATGROUP_EonNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Messages In/s"), STAT_EonNetMessagesInRate, STATGROUP_EonNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Messages Out/s"), STAT_EonNetMessagesOutRate, STATGROUP_EonNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Reducer Calls"), STAT_EonNetQueuedCalls, STATGROUP_EonNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Calls Awaiting Reply"), STAT_EonNetAwaitingReply, STATGROUP_EonNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Reducer RTT (ms)"), STAT_EonNetReducerRtt, STATGROUP_EonNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Player Rows"), STAT_EonNetPlayerRows, STATGROUP_EonNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Inventory Rows"), STAT_EonNetInventoryRows, STATGROUP_EonNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Instance Rows"), STAT_EonNetInstanceRows, STATGROUP_EonNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("World Item Rows"), STAT_EonNetWorldItemRows, STATGROUP_EonNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interactable Rows"), STAT_EonNetInteractableRows, STATGROUP_EonNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Definition Rows"), STAT_EonNetItemDefinitionRows, STATGROUP_EonNet);
+
+namespace
+{
+	// Server table names, in the order of TableRowUpdates
+	const TCHAR* const StatTableNames[] = {
+		FSpaceTimeDBPlayerRow::TableName, FSpaceTimeDBInventoryRow::TableName, FSpaceTimeDBInstanceRow::TableName,
+		FSpaceTimeDBWorldItemRow::TableName, FSpaceTimeDBInteractableRow::TableName, FSpaceTimeDBItemDefinitionRow::TableName
+	};
+
+	// Sent calls with no transaction update after this long are no longer tracked
+	constexpr double CallReplyTimeoutSeconds = 30.0;
+
+	// Host a replay connects to; it never comes from the command line, Game.ini or a probe
+	const TCHAR* const ReplayHost = TEXT("loopback://replay");
+
+	USpaceTimeDBManager* GetManager(UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		return GameInstance ? GameInstance->GetSubsystem<USpaceTimeDBManager>() : nullptr;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CaptureCommand(
+		TEXT("Eon.Net.Capture"),
+		TEXT("Eon.Net.Capture <Name>: record SpaceTimeDB traffic to Saved/NetCaptures/<Name>.eoncap. No name stops recording."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (USpaceTimeDBManager* Manager = GetManager(World))
+			{
+				if (Args.Num() > 0)
+				{
+					Manager->StartCapture(Args[0]);
+				}
+				else
+				{
+					Manager->StopCapture();
+				}
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs NetSimDisconnectCommand(
+		TEXT("Eon.NetSim.Disconnect"),
+		TEXT("Eon.NetSim.Disconnect: drop the SpaceTimeDB connection as if the network went away."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			USpaceTimeDBManager* Manager = GetManager(World);
+			if (Manager && Manager->GetNetSim())
+			{
+				Manager->GetNetSim()->SimulateDisconnect();
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs ReplayCommand(
+		TEXT("Eon.Net.Replay"),
+		TEXT("Eon.Net.Replay <Name> [Speed]: replay a capture with no server. Speed 1 is the recorded pace, 0 as fast as possible."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			USpaceTimeDBManager* Manager = GetManager(World);
+			if (Manager && Args.Num() > 0)
+			{
+				Manager->StartReplay(Args[0], Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1.0f);
+			}
+		}));
+}
 
 void USpaceTimeDBManager::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -16,50 +104,229 @@ void USpaceTimeDBManager::Initialize(FSubsystemCollectionBase& Collection)
 void USpaceTimeDBManager::Deinitialize()
 {
 	Disconnect();
+	StopCapture();
+	NetWorker.Reset();
 	Super::Deinitialize();
 }
 
 void USpaceTimeDBManager::Connect(const FSpaceTimeDBConfig& Config)
 {
-	CurrentConfig = Config;
+	if (Transport.IsValid() && Transport->IsConnected())
+	{
+		Disconnect();
+	}
+
+	FSpaceTimeDBConfig ResolvedConfig = Config;
+	if (Config.Host != ReplayHost)
+	{
+		ResolvedConfig.Host = ResolveHost(Config.Host);
+	}
+
+	// Candidates serve the same database, so the host in use may be any of them
+	TArray<FString> Hosts = { ResolvedConfig.Host };
+	for (const FString& Candidate : Config.CandidateHosts)
+	{
+		if (!Candidate.IsEmpty())
+		{
+			Hosts.AddUnique(Candidate);
+		}
+	}
+
+	// A token only identifies us to the database that issued it, and a clock estimate to the host it came from
+	if (!Hosts.Contains(CurrentConfig.Host) || ResolvedConfig.ModuleName != CurrentConfig.ModuleName)
+	{
+		AuthToken.Reset();
+		ClockSync.Reset();
+	}
+
+	CurrentConfig = ResolvedConfig;
+	Endpoints.Reset(Hosts);
+	EndpointProbe.Reset();
 	ReconnectAttempts = 0;
+	bWantsConnection = true;
+	FTSTicker::GetCoreTicker().RemoveTicker(ReconnectTickerHandle);
+	ReconnectTickerHandle.Reset();
 
-	if (WebSocket.IsValid() && WebSocket->IsConnected())
+	// A manager created outside a game instance (tests, tools) has no cache to configure
+	UGameInstance* GameInstance = GetGameInstance();
+	if (USpaceTimeDBTableCache* Cache = GameInstance ? GameInstance->GetSubsystem<USpaceTimeDBTableCache>() : nullptr)
 	{
-		Disconnect();
+		Cache->SetApplyBudget(CurrentConfig.ApplyBudgetMs, CurrentConfig.MinRowsToTimeSlice);
+	}
+
+	if (CurrentConfig.bUseNetworkThread)
+	{
+		if (!NetWorker.IsValid())
+		{
+			NetWorker = MakeUnique<FSpaceTimeDBNetWorker>();
+			NetWorker->SetDecodeHistogram(&DecodeHistogram);
+		}
+		if (!NetWorker->Start())
+		{
+			UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Network thread unavailable, decoding on the game thread"));
+			NetWorker.Reset();
+		}
+	}
+	else
+	{
+		NetWorker.Reset();
+	}
+
+	// One ticker per frame: flushes queued calls and drains the network thread. It keeps
+	// running across reconnects so calls queued while offline go out on the first tick.
+	FTSTicker::GetCoreTicker().RemoveTicker(NetTickerHandle);
+	TimeSinceFlush = 0.0f;
+	NetTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &USpaceTimeDBManager::NetTick));
+
+	ConnectToBestEndpoint();
+}
+
+void USpaceTimeDBManager::ConnectToBestEndpoint()
+{
+	if (Endpoints.Num() < 2)
+	{
+		OpenConnection();
+		return;
+	}
+
+	const FString CachePath = CurrentConfig.EndpointCacheFile.IsEmpty() ? FString() : FSpaceTimeDBEndpointList::ResolveCachePath(CurrentConfig.EndpointCacheFile);
+	if (!CachePath.IsEmpty() && Endpoints.LoadCache(CachePath, CurrentConfig.EndpointCacheHours * 3600.0))
+	{
+		CurrentConfig.Host = Endpoints.GetCurrent();
+		UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Using cached endpoint %s"), *CurrentConfig.Host);
+		OpenConnection();
+		return;
 	}
 
-	FString Url = FString::Printf(TEXT("%s/database/subscribe/%s"),
-		*CurrentConfig.Host, *CurrentConfig.ModuleName);
+	UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Probing %d endpoints"), Endpoints.Num());
+	EndpointProbe = MakeUnique<FSpaceTimeDBEndpointProbe>(Endpoints.GetRanking(), CurrentConfig.ModuleName, IsBinaryProtocol(),
+		[this](const FSpaceTimeDBTransportParams& Params) { return CreateTransport(Params); });
+	EndpointProbe->SetTimeout(CurrentConfig.EndpointProbeTimeout);
+	EndpointProbe->OnComplete = [this]() { FinishEndpointProbe(); };
+	// Hosts that answer at once (loopbacks) finish the probe inside Start()
+	EndpointProbe->Start();
+}
+
+void USpaceTimeDBManager::FinishEndpointProbe()
+{
+	EndpointProbeResults = EndpointProbe->GetResults();
+	Endpoints.SetRanking(EndpointProbe->GetRanking());
+
+	bool bAnyHealthy = false;
+	for (const FSpaceTimeDBEndpointResult& Result : EndpointProbeResults)
+	{
+		if (Result.bHealthy)
+		{
+			bAnyHealthy = true;
+			UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Endpoint %s answered in %.0f ms"), *Result.Host, Result.GetScoreMs());
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Endpoint %s failed - %s"), *Result.Host, *Result.Error);
+		}
+	}
+
+	if (Endpoints.GetCurrent() != CurrentConfig.Host)
+	{
+		CurrentConfig.Host = Endpoints.GetCurrent();
+		ClockSync.Reset();
+	}
+
+	// A ranking with nothing healthy says more about our network than about the hosts
+	if (bAnyHealthy && !CurrentConfig.EndpointCacheFile.IsEmpty())
+	{
+		Endpoints.SaveCache(FSpaceTimeDBEndpointList::ResolveCachePath(CurrentConfig.EndpointCacheFile));
+	}
+
+	// The probe is dropped on the next tick, not inside its own callback
+	if (bWantsConnection)
+	{
+		OpenConnection();
+	}
+}
+
+FString USpaceTimeDBManager::ResolveHost(const FString& ConfiguredHost)
+{
+	FString Host;
+	if (FParse::Value(FCommandLine::Get(), TEXT("SpaceTimeDBHost="), Host) && !Host.IsEmpty())
+	{
+		return Host;
+	}
+
+	if (GConfig && GConfig->GetString(TEXT("SpaceTimeDB"), TEXT("Host"), Host, GGameIni) && !Host.IsEmpty())
+	{
+		return Host;
+	}
+
+	return ConfiguredHost;
+}
+
+void USpaceTimeDBManager::OpenConnection()
+{
+	// Late callbacks from a transport being replaced must not schedule another reconnect
+	if (Transport.IsValid())
+	{
+		Transport->UnbindAll();
+		Transport->Close();
+		Transport.Reset();
+		NetSim.Reset();
+	}
+
+	// Request ids restart with the connection, and so does the link's backlog
+	++ConnectionGeneration;
+	CallsInFlight.Reset();
+	bBackpressure = false;
+
+	FSpaceTimeDBTransportParams Params;
+	Params.Url = FString::Printf(TEXT("%s/database/subscribe/%s"), *CurrentConfig.Host, *CurrentConfig.ModuleName);
+	Params.Subprotocol = IsBinaryProtocol() ? FSpaceTimeDBProtocol::BinarySubprotocol : FSpaceTimeDBProtocol::JsonSubprotocol;
+	if (!AuthToken.IsEmpty())
+	{
+		Params.UpgradeHeaders.Add(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *AuthToken));
+	}
+
+	Transport = CreateTransport(Params);
 
-	WebSocket = FWebSocketsModule::Get().CreateWebSocket(Url, TEXT("wss"));
+#if !UE_BUILD_SHIPPING
+	// Passes frames straight through until the Eon.NetSim.* variables ask for worse conditions
+	NetSim = MakeShared<FSpaceTimeDBNetSimTransport>(Transport.ToSharedRef());
+	Transport = NetSim;
+#endif
 
-	WebSocket->OnConnected().AddLambda([this]()
+	Transport->OnConnected.BindWeakLambda(this, [this]()
 	{
 		bIsConnected = true;
 		ReconnectAttempts = 0;
-		UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Connected"));
+		Endpoints.NoteConnected();
+		UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Connected (%s)"), IsBinaryProtocol() ? TEXT("binary") : TEXT("json"));
 		OnConnected.Broadcast();
 
-		// Subscribe to relevant tables
-		Subscribe(TEXT("SELECT * FROM player"));
-		Subscribe(TEXT("SELECT * FROM instance WHERE is_public = true"));
-		Subscribe(TEXT("SELECT * FROM inventory_item"));
-		Subscribe(TEXT("SELECT * FROM world_item"));
-		Subscribe(TEXT("SELECT * FROM interactable_state"));
+		// Subscribe to relevant tables; instance-scoped queries follow once our player row arrives.
+		// The table cache is kept across reconnects: the new initial rows are diffed against it.
+		Subscriptions.ResetActive();
+		RefreshSubscriptions();
 	});
 
-	WebSocket->OnConnectionError().AddLambda([this](const FString& Error)
+	Transport->OnConnectionError.BindWeakLambda(this, [this](const FString& Error)
 	{
 		UE_LOG(LogTemp, Error, TEXT("SpaceTimeDB: Connection error - %s"), *Error);
 		bIsConnected = false;
+		if (LocalAuthority.IsValid())
+		{
+			LocalAuthority->NoteConnectionLost();
+		}
 		AttemptReconnect();
 	});
 
-	WebSocket->OnClosed().AddLambda([this](int32 StatusCode, const FString& Reason, bool bWasClean)
+	Transport->OnClosed.BindWeakLambda(this, [this](int32 StatusCode, const FString& Reason, bool bWasClean)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Disconnected - %s"), *Reason);
 		bIsConnected = false;
+		if (LocalAuthority.IsValid())
+		{
+			LocalAuthority->NoteConnectionLost();
+		}
 		OnDisconnected.Broadcast(Reason);
 
 		if (!bWasClean)
@@ -68,233 +335,1120 @@ void USpaceTimeDBManager::Connect(const FSpaceTimeDBConfig& Config)
 		}
 	});
 
-	WebSocket->OnMessage().AddLambda([this](const FString& Message)
-	{
-		HandleMessage(Message);
-	});
+	Transport->OnFrame.BindUObject(this, &USpaceTimeDBManager::HandleFrame);
 
-	WebSocket->Connect();
+	Transport->Connect();
 }
 
-void USpaceTimeDBManager::Disconnect()
+TSharedRef<ISpaceTimeDBTransport> USpaceTimeDBManager::CreateTransport(const FSpaceTimeDBTransportParams& Params) const
 {
-	if (WebSocket.IsValid())
+	if (TransportFactory)
 	{
-		WebSocket->Close();
-		WebSocket.Reset();
+		return TransportFactory(Params);
 	}
-	bIsConnected = false;
-
-	if (UWorld* World = GetWorld())
+	if (FSpaceTimeDBLoopbackTransport::IsLoopbackUrl(Params.Url))
 	{
-		World->GetTimerManager().ClearTimer(ReconnectTimerHandle);
+		return MakeShared<FSpaceTimeDBLoopbackTransport>();
 	}
+	return MakeShared<FSpaceTimeDBWebSocketTransport>(Params);
 }
 
-bool USpaceTimeDBManager::IsConnected() const
+void USpaceTimeDBManager::HandleFrame(TArray<uint8>& Frame, bool bBinary)
 {
-	return bIsConnected && WebSocket.IsValid() && WebSocket->IsConnected();
+	RecordInbound(Frame.Num());
+	if (CaptureWriter.IsOpen())
+	{
+		// Captures get shared; our bearer token must not be in them
+		TArray<uint8> Redacted;
+		if (FSpaceTimeDBProtocol::RedactIdentityToken(Frame.GetData(), Frame.Num(), bBinary, Redacted))
+		{
+			CaptureWriter.Record(false, bBinary, Redacted.GetData(), Redacted.Num());
+		}
+		else
+		{
+			CaptureWriter.Record(false, bBinary, Frame.GetData(), Frame.Num());
+		}
+	}
+	if (NetWorker.IsValid())
+	{
+		FSpaceTimeDBInboundFrame Inbound;
+		Inbound.bBinary = bBinary;
+		Inbound.Generation = ConnectionGeneration;
+		Inbound.Bytes = MoveTemp(Frame);
+		NetWorker->EnqueueInbound(MoveTemp(Inbound));
+	}
+	else if (bBinary)
+	{
+		HandleBinaryMessage(Frame);
+	}
+	else
+	{
+		HandleMessage(Frame);
+	}
 }
 
-void USpaceTimeDBManager::AttemptReconnect()
+void USpaceTimeDBManager::Disconnect()
 {
-	if (ReconnectAttempts >= CurrentConfig.MaxReconnectAttempts)
+	FlushOutgoingCalls();
+	if (LocalAuthority.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("SpaceTimeDB: Max reconnect attempts reached"));
-		return;
+		LocalAuthority->NoteConnectionLost();
 	}
 
-	ReconnectAttempts++;
-	UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Reconnect attempt %d/%d"),
-		ReconnectAttempts, CurrentConfig.MaxReconnectAttempts);
+	// Whatever could not be sent is not replayed by a later Connect()
+	bWantsConnection = false;
+	DropQueuedCalls(TEXT("disconnecting"));
+
+	FTSTicker::GetCoreTicker().RemoveTicker(NetTickerHandle);
+	NetTickerHandle.Reset();
+	FTSTicker::GetCoreTicker().RemoveTicker(ReconnectTickerHandle);
+	ReconnectTickerHandle.Reset();
+	ReplayDriver.Reset();
+	EndpointProbe.Reset();
 
-	if (UWorld* World = GetWorld())
+	if (Transport.IsValid())
 	{
-		World->GetTimerManager().SetTimer(
-			ReconnectTimerHandle,
-			[this]() { Connect(CurrentConfig); },
-			CurrentConfig.ReconnectDelay,
-			false
-		);
+		Transport->Close();
+		Transport.Reset();
+		NetSim.Reset();
 	}
+	bIsConnected = false;
+}
+
+bool USpaceTimeDBManager::IsConnected() const
+{
+	return bIsConnected && Transport.IsValid() && Transport->IsConnected();
 }
 
-void USpaceTimeDBManager::CallReducer(const FString& ReducerName, const TArray<FString>& Args)
+float USpaceTimeDBManager::ComputeReconnectDelay(int32 Attempt, float BaseDelay, float MaxDelay)
 {
-	if (!IsConnected())
+	// "Equal jitter": half the backoff is fixed so retries still slow down, half is random
+	const float Exponent = static_cast<float>(FMath::Clamp(Attempt - 1, 0, 30));
+	const float Cap = FMath::Max(FMath::Min(MaxDelay, BaseDelay * FMath::Pow(2.0f, Exponent)), 0.0f);
+	return Cap * 0.5f + FMath::FRandRange(0.0f, Cap * 0.5f);
+}
+
+void USpaceTimeDBManager::AttemptReconnect()
+{
+	// Errors and closes can both report the same loss; one retry is enough
+	if (!bWantsConnection || ReconnectTickerHandle.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Not connected, cannot call reducer"));
 		return;
 	}
 
-	TSharedPtr<FJsonObject> CallObj = MakeShareable(new FJsonObject);
-	CallObj->SetStringField(TEXT("call"), ReducerName);
+	if (CurrentConfig.MaxReconnectAttempts > 0 && ReconnectAttempts >= CurrentConfig.MaxReconnectAttempts)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SpaceTimeDB: Max reconnect attempts reached"));
+		bWantsConnection = false;
+		DropQueuedCalls(TEXT("giving up on reconnect"));
+		return;
+	}
 
-	TArray<TSharedPtr<FJsonValue>> ArgsArray;
-	for (const FString& Arg : Args)
+	// Repeated failures move us to the next best host, which is retried on the usual backoff
+	if (Endpoints.NoteFailure(CurrentConfig.FailoverAfterErrors))
 	{
-		ArgsArray.Add(MakeShareable(new FJsonValueString(Arg)));
+		CurrentConfig.Host = Endpoints.GetCurrent();
+		ClockSync.Reset();
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Failing over to %s"), *CurrentConfig.Host);
+		if (!CurrentConfig.EndpointCacheFile.IsEmpty())
+		{
+			Endpoints.SaveCache(FSpaceTimeDBEndpointList::ResolveCachePath(CurrentConfig.EndpointCacheFile));
+		}
 	}
-	CallObj->SetArrayField(TEXT("args"), ArgsArray);
 
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(CallObj.ToSharedRef(), Writer);
+	ReconnectAttempts++;
+	const float Delay = ComputeReconnectDelay(ReconnectAttempts, CurrentConfig.ReconnectDelay, CurrentConfig.MaxReconnectDelay);
+	// No limit (0) has no "/max" to show
+	if (CurrentConfig.MaxReconnectAttempts > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Reconnect attempt %d/%d in %.1fs"),
+			ReconnectAttempts, CurrentConfig.MaxReconnectAttempts, Delay);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Reconnect attempt %d in %.1fs"), ReconnectAttempts, Delay);
+	}
 
-	WebSocket->Send(OutputString);
+	// A core ticker rather than a world timer: the connection outlives map changes
+	ReconnectTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+	{
+		ReconnectTickerHandle.Reset();
+		if (bWantsConnection)
+		{
+			OpenConnection();
+		}
+		return false;
+	}), Delay);
 }
 
-void USpaceTimeDBManager::Subscribe(const FString& Query)
+void USpaceTimeDBManager::CallReducer(const FString& ReducerName, FSpaceTimeDBArgList Args)
 {
-	if (!IsConnected())
+	// The local authority runs the call now and queues it for the server itself, offline too
+	if (LocalAuthority.IsValid())
 	{
-		return;
+		FSpaceTimeDBServerMessage Changes;
+		if (LocalAuthority->Call(ReducerName, Args, Changes))
+		{
+			BroadcastServerMessage(Changes);
+			SendLocalAuthorityCalls();
+			return;
+		}
 	}
 
-	TSharedPtr<FJsonObject> SubObj = MakeShareable(new FJsonObject);
-	SubObj->SetStringField(TEXT("subscribe"), Query);
+	const bool bConnected = IsConnected();
+	if (!bConnected && !bWantsConnection)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Not connected, cannot call reducer"));
+		return;
+	}
 
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(SubObj.ToSharedRef(), Writer);
+	EnqueueCall(ReducerName, MoveTemp(Args));
 
-	WebSocket->Send(OutputString);
+	// Unbatched calls go out immediately; while reconnecting they wait for the replay
+	if (bConnected && !CurrentConfig.bBatchOutgoingCalls)
+	{
+		FlushOutgoingCalls();
+	}
 }
 
-void USpaceTimeDBManager::HandleMessage(const FString& Message)
+void USpaceTimeDBManager::EnqueueCall(const FString& ReducerName, FSpaceTimeDBArgList&& Args, uint32 LocalCallId)
 {
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
-
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	// A newer call to a coalesced reducer supersedes the queued one in place
+	const ESpaceTimeDBCallLane Lane = GetCallLane(ReducerName);
+	const bool bCoalesced = CurrentConfig.CoalescedReducers.Contains(ReducerName);
+	if (bCoalesced)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Failed to parse message"));
-		return;
+		if (const int32* Slot = CoalescedCallSlots.Find(ReducerName))
+		{
+			OutgoingCalls[*Slot].Args = MoveTemp(Args);
+			OutgoingCalls[*Slot].LocalCallId = LocalCallId;
+			if (bBackpressure && Lane == ESpaceTimeDBCallLane::Telemetry)
+			{
+				++NetStats.StaleTelemetryDropped;
+			}
+			return;
+		}
 	}
 
-	FString MessageType;
-	if (JsonObject->TryGetStringField(TEXT("type"), MessageType))
+	// Offline the queue is bounded; the oldest call makes room
+	if (!IsConnected() && OutgoingCalls.Num() >= CurrentConfig.MaxQueuedCallsWhileDisconnected)
 	{
-		if (MessageType == TEXT("TransactionUpdate"))
+		if (OutgoingCalls.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Not connected, dropping reducer call %s"), *ReducerName);
+			return;
+		}
+
+		if (OutgoingCalls[0].LocalCallId != 0 && LocalAuthority.IsValid())
+		{
+			// The authority still holds its calls; handing all of them back keeps their order when they go out again
+			const int32 Returned = OutgoingCalls.RemoveAll([](const FSpaceTimeDBReducerCall& Call) { return Call.LocalCallId != 0; });
+			UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Offline call queue full, holding %d local calls for the next connection"), Returned);
+			LocalAuthority->NoteQueueDropped();
+			RebuildCoalescedCallSlots();
+		}
+		else
 		{
-			// Handle row updates
-			const TArray<TSharedPtr<FJsonValue>>* Updates;
-			if (JsonObject->TryGetArrayField(TEXT("updates"), Updates))
+			UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Offline call queue full, dropping %s"), *OutgoingCalls[0].ReducerName);
+			OutgoingCalls.RemoveAt(0);
+			for (auto It = CoalescedCallSlots.CreateIterator(); It; ++It)
 			{
-				for (const auto& Update : *Updates)
+				if (It.Value() == 0)
+				{
+					It.RemoveCurrent();
+				}
+				else
 				{
-					const TSharedPtr<FJsonObject>* UpdateObj;
-					if (Update->TryGetObject(UpdateObj))
-					{
-						FString TableName;
-						(*UpdateObj)->TryGetStringField(TEXT("table"), TableName);
-
-						if (TableName == TEXT("player"))
-						{
-							FString PlayerId, Data;
-							(*UpdateObj)->TryGetStringField(TEXT("identity"), PlayerId);
-
-							TSharedRef<TJsonWriter<>> DataWriter = TJsonWriterFactory<>::Create(&Data);
-							FJsonSerializer::Serialize(UpdateObj->ToSharedRef(), DataWriter);
-
-							OnPlayerDataReceived.Broadcast(PlayerId, Data);
-						}
-						else if (TableName == TEXT("inventory_item"))
-						{
-							FString Data;
-							TSharedRef<TJsonWriter<>> DataWriter = TJsonWriterFactory<>::Create(&Data);
-							FJsonSerializer::Serialize(UpdateObj->ToSharedRef(), DataWriter);
-							OnInventoryUpdated.Broadcast(Data);
-						}
-					}
+					--It.Value();
 				}
 			}
 		}
-		else if (MessageType == TEXT("IdentityToken"))
-		{
-			JsonObject->TryGetStringField(TEXT("identity"), Identity);
-			UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Identity set - %s"), *Identity);
-		}
 	}
-}
 
-// Player Management
-void USpaceTimeDBManager::RegisterPlayer(const FString& Username)
-{
-	CallReducer(TEXT("register_player"), { Username });
+	if (bCoalesced)
+	{
+		CoalescedCallSlots.Add(ReducerName, OutgoingCalls.Num());
+	}
+	OutgoingCalls.Add({ ReducerName, MoveTemp(Args), LocalCallId, Lane });
 }
 
-void USpaceTimeDBManager::UpdatePlayerPosition(FVector Position, FRotator Rotation)
+ESpaceTimeDBCallLane USpaceTimeDBManager::GetCallLane(const FString& ReducerName) const
 {
-	CallReducer(TEXT("update_player_position"), {
-		FString::SanitizeFloat(Position.X),
-		FString::SanitizeFloat(Position.Y),
-		FString::SanitizeFloat(Position.Z),
-		FString::SanitizeFloat(Rotation.Pitch),
-		FString::SanitizeFloat(Rotation.Yaw),
-		FString::SanitizeFloat(Rotation.Roll)
-	});
+	if (CurrentConfig.CriticalReducers.Contains(ReducerName))
+	{
+		return ESpaceTimeDBCallLane::Critical;
+	}
+	if (CurrentConfig.TelemetryReducers.Contains(ReducerName))
+	{
+		return ESpaceTimeDBCallLane::Telemetry;
+	}
+	return ESpaceTimeDBCallLane::Gameplay;
 }
 
-void USpaceTimeDBManager::SetPlayerOnline(bool bOnline)
+void USpaceTimeDBManager::UpdateBackpressure()
 {
-	CallReducer(TEXT("set_player_online"), { bOnline ? TEXT("true") : TEXT("false") });
-}
+	const int32 Buffered = Transport.IsValid() ? Transport->GetBufferedBytes() : 0;
+	const float RttExcessMs = NetStats.RttSamples > 0 ? NetStats.SmoothedRttMs - NetStats.MinRttMs : 0.0f;
 
-// Instance Management
-void USpaceTimeDBManager::CreateInstance(const FString& Name, int32 MaxPlayers, bool bIsPublic)
-{
-	CallReducer(TEXT("create_instance"), {
-		Name,
-		FString::FromInt(MaxPlayers),
-		bIsPublic ? TEXT("true") : TEXT("false")
-	});
+	// Clearing takes half of either threshold, so the state does not flap around one
+	const float Scale = bBackpressure ? 0.5f : 1.0f;
+	const bool bBuffered = CurrentConfig.BackpressureBufferedBytes > 0 && Buffered >= CurrentConfig.BackpressureBufferedBytes * Scale;
+	const bool bSlow = CurrentConfig.BackpressureRttMs > 0.0f && RttExcessMs >= CurrentConfig.BackpressureRttMs * Scale;
+	if (bBuffered || bSlow)
+	{
+		if (!bBackpressure)
+		{
+			UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Backpressure on (%d bytes buffered, RTT +%.0f ms), thinning telemetry"), Buffered, RttExcessMs);
+		}
+		bBackpressure = true;
+	}
+	else if (bBackpressure)
+	{
+		UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Backpressure off"));
+		bBackpressure = false;
+	}
 }
 
-void USpaceTimeDBManager::JoinInstance(int64 InstanceId)
+void USpaceTimeDBManager::DropQueuedCalls(const TCHAR* Reason)
 {
-	CallReducer(TEXT("join_instance"), { FString::Printf(TEXT("%lld"), InstanceId) });
-}
+	if (OutgoingCalls.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Dropping %d queued reducer calls (%s)"), OutgoingCalls.Num(), Reason);
+	}
+	OutgoingCalls.Reset();
+	CoalescedCallSlots.Reset();
 
-void USpaceTimeDBManager::LeaveInstance()
-{
-	CallReducer(TEXT("leave_instance"), {});
+	// Local calls that were waiting here are kept by the authority for the next connection
+	if (LocalAuthority.IsValid())
+	{
+		LocalAuthority->NoteQueueDropped();
+	}
 }
 
-void USpaceTimeDBManager::RequestInstanceList()
+void USpaceTimeDBManager::RequeueUnsentCalls(TArray<FSpaceTimeDBReducerCall>&& Calls)
 {
-	Subscribe(TEXT("SELECT * FROM instance WHERE is_public = true"));
-}
+	for (const FSpaceTimeDBReducerCall& Call : Calls)
+	{
+		if (Call.LocalCallId != 0 && LocalAuthority.IsValid())
+		{
+			LocalAuthority->NoteUnsent(Call.LocalCallId);
+		}
+	}
 
-// Inventory Management
-void USpaceTimeDBManager::AddItemToInventory(const FString& ItemId, int32 Quantity)
-{
-	CallReducer(TEXT("add_item_to_inventory"), {
-		ItemId,
-		FString::FromInt(Quantity)
-	});
-}
+	if (!bWantsConnection)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Dropping %d unsent reducer calls (not connected)"), Calls.Num());
+		if (LocalAuthority.IsValid())
+		{
+			LocalAuthority->NoteQueueDropped();
+		}
+		return;
+	}
 
-void USpaceTimeDBManager::RemoveItemFromInventory(int64 EntryId, int32 Quantity)
-{
-	CallReducer(TEXT("remove_item_from_inventory"), {
-		FString::Printf(TEXT("%lld"), EntryId),
-		FString::FromInt(Quantity)
-	});
+	// They were queued before anything still waiting, so they go ahead of it;
+	// a coalesced call superseded by a newer one is dropped
+	TSet<FString> Superseded;
+	for (const TPair<FString, int32>& Slot : CoalescedCallSlots)
+	{
+		Superseded.Add(Slot.Key);
+	}
+	for (int32 i = Calls.Num() - 1; i >= 0; --i)
+	{
+		if (!CurrentConfig.CoalescedReducers.Contains(Calls[i].ReducerName))
+		{
+			continue;
+		}
+		bool bAlreadyNewer = false;
+		Superseded.Add(Calls[i].ReducerName, &bAlreadyNewer);
+		if (bAlreadyNewer)
+		{
+			Calls.RemoveAt(i);
+		}
+	}
+	OutgoingCalls.Insert(MoveTemp(Calls), 0);
+	RebuildCoalescedCallSlots();
 }
 
-void USpaceTimeDBManager::UseConsumable(int64 EntryId)
+void USpaceTimeDBManager::RebuildCoalescedCallSlots()
 {
-	CallReducer(TEXT("use_consumable"), { FString::Printf(TEXT("%lld"), EntryId) });
+	CoalescedCallSlots.Reset();
+	for (int32 i = 0; i < OutgoingCalls.Num(); ++i)
+	{
+		if (CurrentConfig.CoalescedReducers.Contains(OutgoingCalls[i].ReducerName))
+		{
+			CoalescedCallSlots.Add(OutgoingCalls[i].ReducerName, i);
+		}
+	}
 }
 
-void USpaceTimeDBManager::CollectWorldItem(int64 WorldItemId)
+bool USpaceTimeDBManager::NetTick(float DeltaTime)
 {
-	CallReducer(TEXT("collect_world_item"), { FString::Printf(TEXT("%lld"), WorldItemId) });
-}
+	UpdateNetStats(DeltaTime);
 
-// Interactables
-void USpaceTimeDBManager::ToggleInteractable(const FString& InteractableId)
+	if (NetSim.IsValid())
+	{
+		// Delivered frames can drop the connection; keep the simulator alive for the tick
+		TSharedRef<FSpaceTimeDBNetSimTransport> Sim = NetSim.ToSharedRef();
+		Sim->Tick(DeltaTime);
+	}
+
+	if (ReplayDriver.IsValid())
+	{
+		TickReplay(DeltaTime);
+	}
+
+	if (EndpointProbe.IsValid())
+	{
+		EndpointProbe->Tick();
+		if (EndpointProbe->IsDone())
+		{
+			EndpointProbe.Reset();
+		}
+	}
+
+	if (LocalAuthority.IsValid())
+	{
+		FSpaceTimeDBServerMessage RolledBack;
+		LocalAuthority->Tick(FPlatformTime::Seconds(), RolledBack);
+		if (RolledBack.Type != ESpaceTimeDBMessageType::Unknown)
+		{
+			BroadcastServerMessage(RolledBack);
+		}
+		SendLocalAuthorityCalls();
+	}
+
+	TimeSinceFlush += DeltaTime;
+	if (CurrentConfig.bBatchOutgoingCalls && TimeSinceFlush >= CurrentConfig.FlushInterval)
+	{
+		TimeSinceFlush = 0.0f;
+		SubmitOutgoingCalls(NetWorker.IsValid());
+	}
+	else if (!CurrentConfig.bBatchOutgoingCalls && OutgoingCalls.Num() > 0 && IsConnected())
+	{
+		// Unbatched calls only wait here when backpressure held them back
+		SubmitOutgoingCalls(false);
+	}
+
+	DrainNetWorker();
+	return true;
+}
+
+void USpaceTimeDBManager::FlushOutgoingCalls()
+{
+	SubmitOutgoingCalls(false);
+}
+
+void USpaceTimeDBManager::SubmitOutgoingCalls(bool bUseWorker)
+{
+	if (OutgoingCalls.Num() == 0)
+	{
+		return;
+	}
+
+	if (!IsConnected())
+	{
+		// Kept for replay while a reconnect is pending
+		if (!bWantsConnection)
+		{
+			DropQueuedCalls(TEXT("not connected"));
+		}
+		return;
+	}
+
+	// Lanes go out most urgent first. While the link is backed up, telemetry
+	// waits out its interval, and newer calls replace it in the queue meanwhile.
+	UpdateBackpressure();
+	const double Now = FPlatformTime::Seconds();
+	const bool bSendTelemetry = !bBackpressure || Now - LastTelemetrySendTime >= CurrentConfig.BackpressureTelemetryInterval;
+	OutgoingCalls.StableSort([](const FSpaceTimeDBReducerCall& A, const FSpaceTimeDBReducerCall& B) { return A.Lane < B.Lane; });
+
+	FSpaceTimeDBCallBatch Batch;
+	TArray<FSpaceTimeDBReducerCall> Held;
+	for (FSpaceTimeDBReducerCall& Call : OutgoingCalls)
+	{
+		if (Call.Lane == ESpaceTimeDBCallLane::Telemetry)
+		{
+			if (!bSendTelemetry)
+			{
+				Held.Add(MoveTemp(Call));
+				continue;
+			}
+			LastTelemetrySendTime = Now;
+		}
+		Batch.Calls.Add(MoveTemp(Call));
+	}
+
+	OutgoingCalls = MoveTemp(Held);
+	RebuildCoalescedCallSlots();
+	if (Batch.Calls.Num() == 0)
+	{
+		return;
+	}
+
+	Batch.FirstRequestId = NextRequestId;
+	Batch.bBinary = IsBinaryProtocol();
+	Batch.Generation = ConnectionGeneration;
+	NextRequestId += Batch.Calls.Num();
+
+	// RTT runs from here: worker encode time and the drain wait are part of what the player feels
+	for (int32 i = 0; i < Batch.Calls.Num(); ++i)
+	{
+		FCallInFlight& InFlight = CallsInFlight.Add(Batch.FirstRequestId + i);
+		InFlight.SendTime = Now;
+		InFlight.bStampsLastSeen = Batch.Calls[i].ReducerName == EonReducers::UpdatePlayerPosition.Name ||
+			Batch.Calls[i].ReducerName == EonReducers::UpdatePlayerTransform.Name ||
+			Batch.Calls[i].ReducerName == EonReducers::SetPlayerOnline.Name;
+		if (Batch.Calls[i].LocalCallId != 0 && LocalAuthority.IsValid())
+		{
+			LocalAuthority->NoteSent(Batch.Calls[i].LocalCallId, Batch.FirstRequestId + i);
+		}
+	}
+
+	if (bUseWorker)
+	{
+		// Frames come back through DrainNetWorker
+		NetWorker->EnqueueCalls(MoveTemp(Batch));
+		return;
+	}
+
+	TArray<FSpaceTimeDBOutboundFrame> Frames;
+	FSpaceTimeDBNetWorker::EncodeCallBatch(MoveTemp(Batch), Frames);
+	for (const FSpaceTimeDBOutboundFrame& Frame : Frames)
+	{
+		SendFrame(Frame);
+	}
+}
+
+void USpaceTimeDBManager::SendFrame(const FSpaceTimeDBOutboundFrame& Frame)
+{
+	if (!IsConnected())
+	{
+		return;
+	}
+
+	if (Frame.bBinary)
+	{
+		Transport->SendBinary(Frame.Bytes.GetData(), Frame.Bytes.Num());
+		RecordOutbound(Frame.Bytes.Num());
+		CaptureWriter.Record(true, true, Frame.Bytes.GetData(), Frame.Bytes.Num());
+	}
+	else
+	{
+		Transport->SendText(Frame.Text);
+		RecordOutbound(FPlatformString::ConvertedLength<UTF8CHAR>(*Frame.Text, Frame.Text.Len()));
+		if (CaptureWriter.IsOpen())
+		{
+			FTCHARToUTF8 Utf8(*Frame.Text, Frame.Text.Len());
+			CaptureWriter.Record(true, false, reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		}
+	}
+}
+
+void USpaceTimeDBManager::DrainNetWorker()
+{
+	if (!NetWorker.IsValid())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_EonNetDrain);
+	SET_DWORD_STAT(STAT_EonNetInboundDepth, NetWorker->GetInboundDepth());
+	SET_DWORD_STAT(STAT_EonNetDecodedDepth, NetWorker->GetDecodedDepth());
+
+	// Calls encoded for a connection that has dropped since never reached it
+	TArray<FSpaceTimeDBReducerCall> Unsent;
+	FSpaceTimeDBOutboundFrame Frame;
+	while (NetWorker->DequeueEncoded(Frame))
+	{
+		if (Frame.Generation != ConnectionGeneration || !IsConnected())
+		{
+			if (Frame.Call.IsSet())
+			{
+				Unsent.Add(MoveTemp(Frame.Call.GetValue()));
+			}
+			continue;
+		}
+		SendFrame(Frame);
+	}
+	if (Unsent.Num() > 0)
+	{
+		RequeueUnsentCalls(MoveTemp(Unsent));
+	}
+
+	// Messages from a replaced socket describe state the new subscription supersedes
+	int32 Drained = 0;
+	FSpaceTimeDBServerMessage Message;
+	uint32 Generation = 0;
+	while (NetWorker->DequeueDecoded(Message, &Generation))
+	{
+		if (Generation != ConnectionGeneration)
+		{
+			continue;
+		}
+		DispatchServerMessage(Message);
+		++Drained;
+	}
+	INC_DWORD_STAT_BY(STAT_EonNetMessagesDrained, Drained);
+}
+
+void USpaceTimeDBManager::RefreshSubscriptions()
+{
+	if (!IsConnected())
+	{
+		return;
+	}
+
+	TArray<FString> Added, Removed;
+	if (!Subscriptions.Diff(Added, Removed))
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Updating subscriptions (+%d / -%d)"), Added.Num(), Removed.Num());
+
+	// A binary Subscribe replaces the previous set atomically
+	if (IsBinaryProtocol())
+	{
+		FSpaceTimeDBOutboundFrame Frame;
+		Frame.bBinary = true;
+		FSpaceTimeDBProtocol::EncodeSubscribeBinary(Subscriptions.BuildQueries(), NextRequestId++, Frame.Bytes);
+		SendFrame(Frame);
+	}
+	else
+	{
+		for (const FString& Query : Removed)
+		{
+			FSpaceTimeDBOutboundFrame Frame;
+			FSpaceTimeDBProtocol::EncodeUnsubscribeJson(Query, Frame.Text);
+			SendFrame(Frame);
+		}
+
+		for (const FString& Query : Added)
+		{
+			FSpaceTimeDBOutboundFrame Frame;
+			FSpaceTimeDBProtocol::EncodeSubscribeJson(Query, Frame.Text);
+			SendFrame(Frame);
+		}
+	}
+
+	Subscriptions.Commit();
+}
+
+void USpaceTimeDBManager::HandleMessage(const TArray<uint8>& Utf8Message)
+{
+	FSpaceTimeDBServerMessage Decoded;
+	const double DecodeStart = FPlatformTime::Seconds();
+	const bool bDecoded = FSpaceTimeDBProtocol::DecodeJsonServerMessage(Utf8Message.GetData(), Utf8Message.Num(), Decoded);
+	DecodeHistogram.Record(FPlatformTime::Seconds() - DecodeStart);
+
+	if (!bDecoded)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Failed to parse message"));
+		return;
+	}
+
+	DispatchServerMessage(Decoded);
+}
+
+void USpaceTimeDBManager::HandleBinaryMessage(const TArray<uint8>& Message)
+{
+	FSpaceTimeDBServerMessage Decoded;
+	const double DecodeStart = FPlatformTime::Seconds();
+	const bool bDecoded = FSpaceTimeDBProtocol::DecodeBinaryServerMessage(Message.GetData(), Message.Num(), Decoded);
+	DecodeHistogram.Record(FPlatformTime::Seconds() - DecodeStart);
+
+	if (!bDecoded)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Failed to decode binary message (%d bytes)"), Message.Num());
+		return;
+	}
+
+	DispatchServerMessage(Decoded);
+}
+
+void USpaceTimeDBManager::DispatchServerMessage(const FSpaceTimeDBServerMessage& Message)
+{
+	RecordServerMessage(Message);
+
+	if (!LocalAuthority.IsValid())
+	{
+		BroadcastServerMessage(Message);
+		return;
+	}
+
+	// Listeners see our tables as the local authority predicts them
+	FSpaceTimeDBServerMessage Predicted;
+	LocalAuthority->ApplyServerMessage(Message, Predicted);
+	BroadcastServerMessage(Predicted);
+
+	// An answer can assign an entry id that queued calls were waiting for
+	SendLocalAuthorityCalls();
+}
+
+void USpaceTimeDBManager::BroadcastServerMessage(const FSpaceTimeDBServerMessage& Message)
+{
+	OnServerMessage.Broadcast(Message);
+
+	if (Message.Type == ESpaceTimeDBMessageType::IdentityToken)
+	{
+		Identity = Message.Identity;
+		if (!Message.Token.IsEmpty())
+		{
+			AuthToken = Message.Token;
+		}
+		if (LocalAuthority.IsValid())
+		{
+			LocalAuthority->SetIdentity(Identity);
+		}
+		UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Identity set - %s"), *Identity.ToHex());
+		Subscriptions.SetIdentity(Identity);
+		RefreshSubscriptions();
+		return;
+	}
+
+	UpdateInstanceFromOwnRow(Message);
+
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBPlayerRow>& Update : Message.Players)
+	{
+		OnPlayerRow.Broadcast(Update.Row, Update.Op);
+
+		if (OnPlayerDataReceived.IsBound())
+		{
+			// Deletes are forwarded in the shape string listeners already understand;
+			// identities only become hex here, for Blueprint
+			FSpaceTimeDBPlayerRow Row = Update.Row;
+			Row.bIsOnline &= Update.Op != ESpaceTimeDBRowOp::Delete;
+			OnPlayerDataReceived.Broadcast(Row.Identity.ToHex(), FSpaceTimeDBProtocol::PlayerRowToJson(Row));
+		}
+	}
+
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>& Update : Message.InventoryItems)
+	{
+		OnInventoryRow.Broadcast(Update.Row, Update.Op);
+
+		if (OnInventoryUpdated.IsBound())
+		{
+			FSpaceTimeDBInventoryRow Row = Update.Row;
+			if (Update.Op == ESpaceTimeDBRowOp::Delete)
+			{
+				Row.Quantity = 0;
+			}
+			OnInventoryUpdated.Broadcast(FSpaceTimeDBProtocol::InventoryRowToJson(Row));
+		}
+	}
+}
+
+void USpaceTimeDBManager::UpdateInstanceFromOwnRow(const FSpaceTimeDBServerMessage& Message)
+{
+	if (!Identity.IsValid())
+	{
+		return;
+	}
+
+	for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBPlayerRow>& Update : Message.Players)
+	{
+		if (Update.Row.Identity != Identity)
+		{
+			continue;
+		}
+
+		const TOptional<uint64> NewInstance = Update.Op == ESpaceTimeDBRowOp::Delete ? TOptional<uint64>() : Update.Row.InstanceId;
+		if (NewInstance != Subscriptions.GetInstance())
+		{
+			UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Now in instance %s"),
+				NewInstance.IsSet() ? *LexToString(NewInstance.GetValue()) : TEXT("(none)"));
+
+			Subscriptions.SetInstance(NewInstance);
+			RefreshSubscriptions();
+			if (LocalAuthority.IsValid())
+			{
+				LocalAuthority->HandleInstanceChanged(NewInstance);
+			}
+			OnInstanceChanged.Broadcast(NewInstance);
+		}
+	}
+}
+
+// Player Management
+void USpaceTimeDBManager::RegisterPlayer(const FString& Username)
+{
+	CallReducer(EonReducers::RegisterPlayer, Username);
+}
+
+void USpaceTimeDBManager::UpdatePlayerPosition(FVector Position, FRotator Rotation)
+{
+	// Instances share the level's frame, so the world origin is every instance's origin
+	if (CurrentConfig.bCompactTransforms)
+	{
+		const FEonCompactTransform Compact = FEonTransformCodec::Encode(Position, Rotation);
+		if (FSpaceTimeDBLatencyProbe::IsActive())
+		{
+			// Peers receive the position as the server stores it, rounded to the codec's step
+			FSpaceTimeDBLatencyProbe::Get().NoteSent(Identity, FVector3f(FEonTransformCodec::DecodePosition(Compact.Position)));
+		}
+		CallReducer(EonReducers::UpdatePlayerTransform, Compact.Position, Compact.Orientation);
+		return;
+	}
+
+	if (FSpaceTimeDBLatencyProbe::IsActive())
+	{
+		FSpaceTimeDBLatencyProbe::Get().NoteSent(Identity, FVector3f(Position));
+	}
+
+	CallReducer(EonReducers::UpdatePlayerPosition,
+		static_cast<float>(Position.X), static_cast<float>(Position.Y), static_cast<float>(Position.Z),
+		static_cast<float>(Rotation.Pitch), static_cast<float>(Rotation.Yaw), static_cast<float>(Rotation.Roll));
+}
+
+void USpaceTimeDBManager::SetPlayerOnline(bool bOnline)
+{
+	CallReducer(EonReducers::SetPlayerOnline, bOnline);
+}
+
+// Instance Management
+void USpaceTimeDBManager::CreateInstance(const FString& Name, int32 MaxPlayers, bool bIsPublic)
+{
+	CallReducer(EonReducers::CreateInstance, Name, static_cast<uint32>(FMath::Max(MaxPlayers, 0)), bIsPublic);
+}
+
+void USpaceTimeDBManager::JoinInstance(int64 InstanceId)
+{
+	CallReducer(EonReducers::JoinInstance, static_cast<uint64>(InstanceId));
+}
+
+void USpaceTimeDBManager::LeaveInstance()
+{
+	CallReducer(EonReducers::LeaveInstance);
+}
+
+void USpaceTimeDBManager::RequestInstanceList()
+{
+	// Public instances are part of the base subscription and mirrored by the table cache
+	RefreshSubscriptions();
+}
+
+// Inventory Management
+void USpaceTimeDBManager::AddItemToInventory(const FString& ItemId, int32 Quantity)
+{
+	CallReducer(EonReducers::AddItemToInventory, ItemId, static_cast<uint32>(FMath::Max(Quantity, 0)));
+}
+
+void USpaceTimeDBManager::RemoveItemFromInventory(int64 EntryId, int32 Quantity)
+{
+	CallReducer(EonReducers::RemoveItemFromInventory, static_cast<uint64>(EntryId), static_cast<uint32>(FMath::Max(Quantity, 0)));
+}
+
+void USpaceTimeDBManager::UseConsumable(int64 EntryId)
+{
+	CallReducer(EonReducers::UseConsumable, static_cast<uint64>(EntryId));
+}
+
+void USpaceTimeDBManager::CollectWorldItem(int64 WorldItemId)
+{
+	CallReducer(EonReducers::CollectWorldItem, static_cast<uint64>(WorldItemId));
+}
+
+// Interactables
+void USpaceTimeDBManager::ToggleInteractable(const FString& InteractableId)
+{
+	CallReducer(EonReducers::ToggleInteractable, InteractableId);
+}
+
+// ============================================================================
+// LOCAL AUTHORITY
+// ============================================================================
+
+void USpaceTimeDBManager::SetLocalAuthority(bool bEnabled)
+{
+	if (bEnabled == LocalAuthority.IsValid())
+	{
+		return;
+	}
+
+	if (!bEnabled)
+	{
+		// What can still go out goes out as ordinary calls; the server's rows take over as they arrive
+		SendLocalAuthorityCalls();
+		if (const int32 Unsent = LocalAuthority->GetNumUnsentCalls())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Local authority off with %d calls never sent"), Unsent);
+		}
+		LocalAuthority.Reset();
+		return;
+	}
+
+	LocalAuthority = MakeUnique<FSpaceTimeDBLocalAuthority>();
+	LocalAuthority->SetIdentity(Identity);
+	// Without a cache to seed from, the authority starts empty and fills from the next snapshot
+	UGameInstance* GameInstance = GetGameInstance();
+	if (USpaceTimeDBTableCache* Cache = GameInstance ? GameInstance->GetSubsystem<USpaceTimeDBTableCache>() : nullptr)
+	{
+		LocalAuthority->Seed(*Cache);
+	}
+
+	FSpaceTimeDBServerMessage Defaults;
+	LocalAuthority->AddDefaultItemDefinitions(Defaults);
+	if (Defaults.ItemDefinitions.Num() > 0)
+	{
+		BroadcastServerMessage(Defaults);
+	}
+	UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Local authority on"));
+}
+
+void USpaceTimeDBManager::SendLocalAuthorityCalls()
+{
+	// Calls run as whoever the server says we are, so they wait for the identity too
+	if (!LocalAuthority.IsValid() || !IsConnected() || !Identity.IsValid())
+	{
+		return;
+	}
+
+	TArray<FSpaceTimeDBReducerCall> Calls;
+	LocalAuthority->TakeCallsToSend(Calls, FPlatformTime::Seconds());
+	if (Calls.Num() == 0)
+	{
+		return;
+	}
+
+	for (FSpaceTimeDBReducerCall& Call : Calls)
+	{
+		EnqueueCall(Call.ReducerName, MoveTemp(Call.Args), Call.LocalCallId);
+	}
+	if (!CurrentConfig.bBatchOutgoingCalls)
+	{
+		FlushOutgoingCalls();
+	}
+}
+
+// ============================================================================
+// CAPTURE AND REPLAY
+// ============================================================================
+
+bool USpaceTimeDBManager::StartCapture(const FString& Name)
+{
+	const FString Path = FSpaceTimeDBCapture::ResolvePath(Name);
+	if (!CaptureWriter.Open(Path))
+	{
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Capturing traffic to %s"), *Path);
+	return true;
+}
+
+void USpaceTimeDBManager::StopCapture()
+{
+	if (CaptureWriter.IsOpen())
+	{
+		UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Capture stopped after %d frames"), CaptureWriter.GetNumFrames());
+		CaptureWriter.Close();
+	}
+}
+
+bool USpaceTimeDBManager::StartReplay(const FString& Name, float Speed)
+{
+	const FString Path = FSpaceTimeDBCapture::ResolvePath(Name);
+	TArray<FSpaceTimeDBCaptureFrame> Frames;
+	if (!FSpaceTimeDBCapture::Load(Path, Frames))
+	{
+		return false;
+	}
+
+	// The replay owns the far end of a loopback; the manager connects to it as to any host
+	TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+	FSpaceTimeDBTransportFactory SavedFactory = MoveTemp(TransportFactory);
+	TransportFactory = [Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; };
+
+	// Frames are timed as they are handed over, so decoding has to happen inline. The
+	// loopback is the only endpoint: a probe would consume the first replayed frame
+	FSpaceTimeDBConfig ReplayConfig = CurrentConfig;
+	ReplayConfig.Host = ReplayHost;
+	ReplayConfig.CandidateHosts.Reset();
+	ReplayConfig.EndpointCacheFile.Reset();
+	ReplayConfig.bUseNetworkThread = false;
+	Connect(ReplayConfig);
+	TransportFactory = MoveTemp(SavedFactory);
+
+	UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Replaying %d frames from %s (speed %.2f)"), Frames.Num(), *Path, Speed);
+	ReplayDriver = MakeUnique<FSpaceTimeDBReplayDriver>(MoveTemp(Frames), Loopback, Speed);
+	return true;
+}
+
+void USpaceTimeDBManager::TickReplay(float DeltaTime)
+{
+	if (ReplayDriver->Tick(DeltaTime))
+	{
+		return;
+	}
+
+	const FSpaceTimeDBReplayReport Report = ReplayDriver->GetReport();
+	ReplayDriver.Reset();
+	UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Replay finished - %s"), *Report.ToString());
+	OnReplayFinished.Broadcast(Report);
+}
+
+// ============================================================================
+// INSTRUMENTATION
+// ============================================================================
+
+void USpaceTimeDBManager::RecordInbound(int32 Bytes)
+{
+	NetStatsWindow.BytesIn += Bytes;
+	++NetStatsWindow.MessagesIn;
+	NetStats.TotalBytesIn += Bytes;
+	++NetStats.TotalMessagesIn;
+}
+
+void USpaceTimeDBManager::RecordOutbound(int32 Bytes)
+{
+	NetStatsWindow.BytesOut += Bytes;
+	++NetStatsWindow.MessagesOut;
+	NetStats.TotalBytesOut += Bytes;
+	++NetStats.TotalMessagesOut;
+}
+
+void USpaceTimeDBManager::RecordServerMessage(const FSpaceTimeDBServerMessage& Message)
+{
+	const int32 RowCounts[] = { Message.Players.Num(), Message.InventoryItems.Num(), Message.Instances.Num(), Message.WorldItems.Num(), Message.Interactables.Num(), Message.ItemDefinitions.Num() };
+	for (int32 i = 0; i < static_cast<int32>(UE_ARRAY_COUNT(RowCounts)); ++i)
+	{
+		TableRowUpdates[i] += RowCounts[i];
+	}
+	INC_DWORD_STAT_BY(STAT_EonNetPlayerRows, RowCounts[0]);
+	INC_DWORD_STAT_BY(STAT_EonNetInventoryRows, RowCounts[1]);
+	INC_DWORD_STAT_BY(STAT_EonNetInstanceRows, RowCounts[2]);
+	INC_DWORD_STAT_BY(STAT_EonNetWorldItemRows, RowCounts[3]);
+	INC_DWORD_STAT_BY(STAT_EonNetInteractableRows, RowCounts[4]);
+	INC_DWORD_STAT_BY(STAT_EonNetItemDefinitionRows, RowCounts[5]);
+
+	// Request ids are per connection, so only updates caused by our own calls count
+	if (Message.RequestId == 0 || (Message.CallerIdentity.IsValid() && Message.CallerIdentity != Identity))
+	{
+		return;
+	}
+
+	FCallInFlight InFlight;
+	if (!CallsInFlight.RemoveAndCopyValue(Message.RequestId, InFlight))
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double SendTime = InFlight.SendTime;
+	const float RttMs = static_cast<float>((Now - SendTime) * 1000.0);
+	NetStats.LastRttMs = RttMs;
+	if (NetStats.RttSamples == 0)
+	{
+		NetStats.SmoothedRttMs = NetStats.MinRttMs = NetStats.MaxRttMs = RttMs;
+	}
+	else
+	{
+		// Same smoothing as TCP's SRTT
+		NetStats.SmoothedRttMs += (RttMs - NetStats.SmoothedRttMs) * 0.125f;
+		NetStats.MinRttMs = FMath::Min(NetStats.MinRttMs, RttMs);
+		NetStats.MaxRttMs = FMath::Max(NetStats.MaxRttMs, RttMs);
+	}
+	++NetStats.RttSamples;
+	SET_FLOAT_STAT(STAT_EonNetReducerRtt, NetStats.SmoothedRttMs);
+
+	// The transaction's timestamp dates the reply for the clock estimate. The JSON
+	// protocol leaves it out; a call that stamps our last_seen carries it there instead.
+	int64 ServerMicros = Message.TimestampMicros;
+	if (ServerMicros == 0 && InFlight.bStampsLastSeen)
+	{
+		for (const TSpaceTimeDBRowUpdate<FSpaceTimeDBPlayerRow>& Update : Message.Players)
+		{
+			if (Update.Row.Identity == Identity && Update.Op != ESpaceTimeDBRowOp::Delete)
+			{
+				ServerMicros = Update.Row.LastSeenMicros;
+			}
+		}
+	}
+	if (ServerMicros > 0)
+	{
+		ClockSync.AddSample(SendTime, Now, ServerMicros);
+	}
+}
+
+void USpaceTimeDBManager::UpdateNetStats(float DeltaTime)
+{
+	SET_DWORD_STAT(STAT_EonNetQueuedCalls, OutgoingCalls.Num());
+	SET_DWORD_STAT(STAT_EonNetAwaitingReply, CallsInFlight.Num());
+
+	NetStatsWindow.Seconds += DeltaTime;
+	if (NetStatsWindow.Seconds < 1.0f)
+	{
+		return;
+	}
+
+	const float Seconds = NetStatsWindow.Seconds;
+	NetStats.BytesInPerSecond = NetStatsWindow.BytesIn / Seconds;
+	NetStats.BytesOutPerSecond = NetStatsWindow.BytesOut / Seconds;
+	NetStats.MessagesInPerSecond = NetStatsWindow.MessagesIn / Seconds;
+	NetStats.MessagesOutPerSecond = NetStatsWindow.MessagesOut / Seconds;
+	NetStatsWindow = FNetStatsWindow();
+
+	SET_DWORD_STAT(STAT_EonNetBytesInRate, FMath::RoundToInt(NetStats.BytesInPerSecond));
+	SET_DWORD_STAT(STAT_EonNetBytesOutRate, FMath::RoundToInt(NetStats.BytesOutPerSecond));
+	SET_DWORD_STAT(STAT_EonNetMessagesInRate, FMath::RoundToInt(NetStats.MessagesInPerSecond));
+	SET_DWORD_STAT(STAT_EonNetMessagesOutRate, FMath::RoundToInt(NetStats.MessagesOutPerSecond));
+
+	// Calls the server never answered (dropped frames, a relay without request ids) stop counting
+	const double Cutoff = FPlatformTime::Seconds() - CallReplyTimeoutSeconds;
+	for (auto It = CallsInFlight.CreateIterator(); It; ++It)
+	{
+		if (It.Value().SendTime < Cutoff)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+FSpaceTimeDBNetStats USpaceTimeDBManager::GetNetStats() const
+{
+	FSpaceTimeDBNetStats Stats = NetStats;
+	Stats.QueuedReducerCalls = OutgoingCalls.Num();
+	Stats.CallsAwaitingReply = CallsInFlight.Num();
+	Stats.BufferedBytesOut = Transport.IsValid() ? Transport->GetBufferedBytes() : 0;
+	Stats.bBackpressure = bBackpressure;
+	Stats.ClockUncertaintyMs = static_cast<float>(ClockSync.GetUncertaintySeconds() * 1000.0);
+	Stats.ClockDriftPpm = static_cast<float>(ClockSync.GetDriftPpm());
+	Stats.ClockSamples = ClockSync.GetNumSamples();
+
+	for (int32 i = 0; i < static_cast<int32>(UE_ARRAY_COUNT(StatTableNames)); ++i)
+	{
+		Stats.TableRowUpdates.Add(StatTableNames[i], TableRowUpdates[i]);
+	}
+
+	DecodeHistogram.Snapshot(Stats.DecodeTimeHistogram);
+	Stats.TotalDecodeMs = static_cast<float>(DecodeHistogram.GetTotalMs());
+	Stats.DecodeBucketBoundsMicros = TArray<float>(FSpaceTimeDBDecodeHistogram::BucketBoundsMicros, FSpaceTimeDBDecodeHistogram::NumBuckets);
+	return Stats;
+}
+
+double USpaceTimeDBManager::GetServerTime() const
+{
+	if (!ClockSync.IsSynchronized())
+	{
+		return FDateTime::UtcNow().ToUnixTimestampDecimal();
+	}
+	return ClockSync.ToServerTime(FPlatformTime::Seconds());
+}
+
+double USpaceTimeDBManager::ServerTimeToLocal(int64 ServerMicros) const
+{
+	if (!ClockSync.IsSynchronized())
+	{
+		// Assume the clocks agree until a round trip says otherwise
+		return FPlatformTime::Seconds() - (FDateTime::UtcNow().ToUnixTimestampDecimal() - ServerMicros * 1e-6);
+	}
+	return ClockSync.ToLocalTime(ServerMicros * 1e-6);
+}
+
+void USpaceTimeDBManager::ResetNetStats()
 {
-	CallReducer(TEXT("toggle_interactable"), { InteractableId });
+	NetStats = FSpaceTimeDBNetStats();
+	NetStatsWindow = FNetStatsWindow();
+	DecodeHistogram.Reset();
+	FMemory::Memzero(TableRowUpdates);
 }
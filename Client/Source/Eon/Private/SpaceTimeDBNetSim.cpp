@@ -0,0 +1,396 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBNetSim.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarNetSimLatencyMs(
+		TEXT("Eon.NetSim.LatencyMs"), 0.0f,
+		TEXT("One-way latency added to SpaceTimeDB traffic, in ms."));
+
+	TAutoConsoleVariable<float> CVarNetSimJitterMs(
+		TEXT("Eon.NetSim.JitterMs"), 0.0f,
+		TEXT("Random extra one-way latency per SpaceTimeDB frame, up to this many ms."));
+
+	TAutoConsoleVariable<float> CVarNetSimReorderPercent(
+		TEXT("Eon.NetSim.ReorderPercent"), 0.0f,
+		TEXT("Chance (0-100) that a SpaceTimeDB frame may be delivered ahead of earlier ones."));
+
+	TAutoConsoleVariable<float> CVarNetSimLossPercent(
+		TEXT("Eon.NetSim.LossPercent"), 0.0f,
+		TEXT("Chance (0-100) that a SpaceTimeDB frame is lost and stalls for Eon.NetSim.RetransmitMs."));
+
+	TAutoConsoleVariable<float> CVarNetSimRetransmitMs(
+		TEXT("Eon.NetSim.RetransmitMs"), 200.0f,
+		TEXT("Delay a lost SpaceTimeDB frame takes to be resent, in ms."));
+
+	TAutoConsoleVariable<int32> CVarNetSimDownKbps(
+		TEXT("Eon.NetSim.DownKbps"), 0,
+		TEXT("Server-to-client bandwidth cap in kbit/s. 0 is unlimited."));
+
+	TAutoConsoleVariable<int32> CVarNetSimUpKbps(
+		TEXT("Eon.NetSim.UpKbps"), 0,
+		TEXT("Client-to-server bandwidth cap in kbit/s. 0 is unlimited."));
+
+	TAutoConsoleVariable<float> CVarNetSimDisconnectsPerMinute(
+		TEXT("Eon.NetSim.DisconnectsPerMinute"), 0.0f,
+		TEXT("Average number of simulated SpaceTimeDB connection drops per minute."));
+
+	FSpaceTimeDBNetSimSettings MakeProfile(float LatencyMs, float JitterMs, float ReorderPercent, float LossPercent,
+		int32 DownKbps, int32 UpKbps, float DisconnectsPerMinute)
+	{
+		FSpaceTimeDBNetSimSettings Settings;
+		Settings.LatencyMs = LatencyMs;
+		Settings.JitterMs = JitterMs;
+		Settings.ReorderPercent = ReorderPercent;
+		Settings.LossPercent = LossPercent;
+		Settings.DownKbps = DownKbps;
+		Settings.UpKbps = UpKbps;
+		Settings.DisconnectsPerMinute = DisconnectsPerMinute;
+		return Settings;
+	}
+
+	struct FNetSimProfile
+	{
+		const TCHAR* Name;
+		FSpaceTimeDBNetSimSettings Settings;
+	};
+
+	const FNetSimProfile NetSimProfiles[] = {
+		{ TEXT("Off"), FSpaceTimeDBNetSimSettings() },
+		{ TEXT("Wifi"), MakeProfile(5.0f, 5.0f, 0.0f, 0.1f, 0, 0, 0.0f) },
+		{ TEXT("LTE"), MakeProfile(40.0f, 20.0f, 0.0f, 0.5f, 10000, 2000, 0.05f) },
+		{ TEXT("3G"), MakeProfile(150.0f, 75.0f, 1.0f, 2.0f, 1000, 300, 0.2f) },
+		{ TEXT("Lossy"), MakeProfile(100.0f, 100.0f, 5.0f, 10.0f, 500, 200, 1.0f) },
+	};
+
+	FAutoConsoleCommand NetSimProfileCommand(
+		TEXT("Eon.NetSim.Profile"),
+		TEXT("Eon.NetSim.Profile <Off|Wifi|LTE|3G|Lossy>: set every Eon.NetSim variable to a preset."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FSpaceTimeDBNetSimSettings Settings;
+			if (Args.Num() == 0 || !FSpaceTimeDBNetSimSettings::FindProfile(Args[0], Settings))
+			{
+				FString Names;
+				for (const FNetSimProfile& Profile : NetSimProfiles)
+				{
+					Names += Names.IsEmpty() ? Profile.Name : FString::Printf(TEXT(", %s"), Profile.Name);
+				}
+				UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Unknown network profile, expected one of %s"), *Names);
+				return;
+			}
+
+			FSpaceTimeDBNetSimSettings::ApplyToConsoleVariables(Settings);
+			UE_LOG(LogTemp, Log, TEXT("SpaceTimeDB: Network profile %s"), *Args[0]);
+		}));
+}
+
+// ============================================================================
+// SETTINGS
+// ============================================================================
+
+FSpaceTimeDBNetSimSettings FSpaceTimeDBNetSimSettings::FromConsoleVariables()
+{
+	FSpaceTimeDBNetSimSettings Settings;
+	Settings.LatencyMs = FMath::Max(CVarNetSimLatencyMs.GetValueOnGameThread(), 0.0f);
+	Settings.JitterMs = FMath::Max(CVarNetSimJitterMs.GetValueOnGameThread(), 0.0f);
+	Settings.ReorderPercent = FMath::Clamp(CVarNetSimReorderPercent.GetValueOnGameThread(), 0.0f, 100.0f);
+	Settings.LossPercent = FMath::Clamp(CVarNetSimLossPercent.GetValueOnGameThread(), 0.0f, 100.0f);
+	Settings.RetransmitMs = FMath::Max(CVarNetSimRetransmitMs.GetValueOnGameThread(), 0.0f);
+	Settings.DownKbps = FMath::Max(CVarNetSimDownKbps.GetValueOnGameThread(), 0);
+	Settings.UpKbps = FMath::Max(CVarNetSimUpKbps.GetValueOnGameThread(), 0);
+	Settings.DisconnectsPerMinute = FMath::Max(CVarNetSimDisconnectsPerMinute.GetValueOnGameThread(), 0.0f);
+	return Settings;
+}
+
+bool FSpaceTimeDBNetSimSettings::FindProfile(const FString& Name, FSpaceTimeDBNetSimSettings& OutSettings)
+{
+	for (const FNetSimProfile& Profile : NetSimProfiles)
+	{
+		if (Name == Profile.Name)
+		{
+			OutSettings = Profile.Settings;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FSpaceTimeDBNetSimSettings::ApplyToConsoleVariables(const FSpaceTimeDBNetSimSettings& Settings)
+{
+	CVarNetSimLatencyMs->Set(Settings.LatencyMs, ECVF_SetByConsole);
+	CVarNetSimJitterMs->Set(Settings.JitterMs, ECVF_SetByConsole);
+	CVarNetSimReorderPercent->Set(Settings.ReorderPercent, ECVF_SetByConsole);
+	CVarNetSimLossPercent->Set(Settings.LossPercent, ECVF_SetByConsole);
+	CVarNetSimRetransmitMs->Set(Settings.RetransmitMs, ECVF_SetByConsole);
+	CVarNetSimDownKbps->Set(Settings.DownKbps, ECVF_SetByConsole);
+	CVarNetSimUpKbps->Set(Settings.UpKbps, ECVF_SetByConsole);
+	CVarNetSimDisconnectsPerMinute->Set(Settings.DisconnectsPerMinute, ECVF_SetByConsole);
+}
+
+// ============================================================================
+// TRANSPORT
+// ============================================================================
+
+FSpaceTimeDBNetSimTransport::FSpaceTimeDBNetSimTransport(TSharedRef<ISpaceTimeDBTransport> InInner)
+	: Inner(InInner)
+	, Random(static_cast<int32>(FPlatformTime::Cycles()))
+{
+	Inner->OnFrame.BindRaw(this, &FSpaceTimeDBNetSimTransport::HandleInnerFrame);
+	Inner->OnConnected.BindLambda([this]()
+	{
+		FPending Item;
+		Item.Event = EEvent::Connected;
+		HandleInnerEvent(MoveTemp(Item));
+	});
+	Inner->OnConnectionError.BindLambda([this](const FString& Error)
+	{
+		FPending Item;
+		Item.Event = EEvent::Error;
+		Item.Text = Error;
+		HandleInnerEvent(MoveTemp(Item));
+	});
+	Inner->OnClosed.BindLambda([this](int32 StatusCode, const FString& Reason, bool bWasClean)
+	{
+		FPending Item;
+		Item.Event = EEvent::Closed;
+		Item.StatusCode = StatusCode;
+		Item.Text = Reason;
+		Item.bWasClean = bWasClean;
+		HandleInnerEvent(MoveTemp(Item));
+	});
+}
+
+FSpaceTimeDBNetSimTransport::~FSpaceTimeDBNetSimTransport()
+{
+	Inner->UnbindAll();
+}
+
+FSpaceTimeDBNetSimSettings FSpaceTimeDBNetSimTransport::GetSettings() const
+{
+	return SettingsOverride.IsSet() ? SettingsOverride.GetValue() : FSpaceTimeDBNetSimSettings::FromConsoleVariables();
+}
+
+void FSpaceTimeDBNetSimTransport::Connect()
+{
+	bDropped = false;
+	Inner->Connect();
+}
+
+void FSpaceTimeDBNetSimTransport::Close()
+{
+	// Unsent frames die with the socket; the close itself still travels the link
+	Outbound.Pending.Reset();
+	bConnected = false;
+	Inner->Close();
+}
+
+void FSpaceTimeDBNetSimTransport::SendText(const FString& Text)
+{
+	const FSpaceTimeDBNetSimSettings Settings = GetSettings();
+	if (!Settings.IsActive() && Outbound.Num() == 0)
+	{
+		Inner->SendText(Text);
+		return;
+	}
+
+	FPending Item;
+	Item.Text = Text;
+	Schedule(Outbound, MoveTemp(Item), Settings.UpKbps, Settings);
+}
+
+void FSpaceTimeDBNetSimTransport::SendBinary(const uint8* Data, int32 Size)
+{
+	const FSpaceTimeDBNetSimSettings Settings = GetSettings();
+	if (!Settings.IsActive() && Outbound.Num() == 0)
+	{
+		Inner->SendBinary(Data, Size);
+		return;
+	}
+
+	FPending Item;
+	Item.bBinary = true;
+	Item.Bytes.Append(Data, Size);
+	Schedule(Outbound, MoveTemp(Item), Settings.UpKbps, Settings);
+}
+
+int32 FSpaceTimeDBNetSimTransport::GetBufferedBytes() const
+{
+	// The uplink's backlog is the time until it is free again, at its rate
+	const int32 UpKbps = GetSettings().UpKbps;
+	const double BusySeconds = Outbound.LinkFreeAt - Now;
+	const int32 Backlog = UpKbps > 0 && BusySeconds > 0.0 ? FMath::CeilToInt32(BusySeconds * UpKbps * 1000.0 / 8.0) : 0;
+	return Backlog + Inner->GetBufferedBytes();
+}
+
+void FSpaceTimeDBNetSimTransport::Tick(float DeltaTime)
+{
+	Now += DeltaTime;
+
+	const FSpaceTimeDBNetSimSettings Settings = GetSettings();
+	if (bConnected && Settings.DisconnectsPerMinute > 0.0f && Random.FRand() < Settings.DisconnectsPerMinute * DeltaTime / 60.0f)
+	{
+		SimulateDisconnect();
+		return;
+	}
+
+	// Deliveries can send, close or drop, so items are taken off one at a time
+	while (Outbound.Num() > 0 && Outbound.Pending[0].DeliverAt <= Now)
+	{
+		FPending Item = MoveTemp(Outbound.Pending[0]);
+		Outbound.Pending.RemoveAt(0);
+		DeliverOutbound(Item);
+	}
+	while (Inbound.Num() > 0 && Inbound.Pending[0].DeliverAt <= Now)
+	{
+		FPending Item = MoveTemp(Inbound.Pending[0]);
+		Inbound.Pending.RemoveAt(0);
+		DeliverInbound(Item);
+	}
+}
+
+void FSpaceTimeDBNetSimTransport::SimulateDisconnect()
+{
+	const bool bWasConnected = bConnected;
+	++NumSimulatedDisconnects;
+
+	Inbound = FLane();
+	Outbound = FLane();
+	bConnected = false;
+	bDropped = true;
+	Inner->Close();
+
+	UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Simulated connection drop"));
+	if (bWasConnected)
+	{
+		OnClosed.ExecuteIfBound(1006, TEXT("Simulated disconnect"), false);
+	}
+}
+
+void FSpaceTimeDBNetSimTransport::Schedule(FLane& Lane, FPending&& Item, int32 Kbps, const FSpaceTimeDBNetSimSettings& Settings)
+{
+	const bool bFrame = Item.Event == EEvent::Frame;
+
+	// Serialization delay: a frame leaves once the link has finished with the ones before it
+	double SentAt = Now;
+	if (bFrame && Kbps > 0)
+	{
+		const int32 Size = Item.bBinary ? Item.Bytes.Num() : FMath::Max(Item.Bytes.Num(), Item.Text.Len());
+		SentAt = FMath::Max(Now, Lane.LinkFreeAt) + Size * 8.0 / (Kbps * 1000.0);
+		Lane.LinkFreeAt = SentAt;
+	}
+
+	double DeliverAt = SentAt + Settings.LatencyMs / 1000.0;
+	bool bMayOvertake = false;
+	if (bFrame)
+	{
+		DeliverAt += Random.FRandRange(0.0f, Settings.JitterMs) / 1000.0;
+		if (Settings.LossPercent > 0.0f && Random.FRand() * 100.0f < Settings.LossPercent)
+		{
+			DeliverAt += Settings.RetransmitMs / 1000.0;
+		}
+		bMayOvertake = Settings.ReorderPercent > 0.0f && Random.FRand() * 100.0f < Settings.ReorderPercent;
+	}
+
+	// In order unless this frame may overtake; nothing overtakes a connect or close
+	DeliverAt = FMath::Max(DeliverAt, bMayOvertake ? Lane.EventAt : Lane.LastDeliverAt);
+	Lane.LastDeliverAt = FMath::Max(Lane.LastDeliverAt, DeliverAt);
+	if (!bFrame)
+	{
+		Lane.EventAt = DeliverAt;
+	}
+
+	// Equal times keep send order
+	Item.DeliverAt = DeliverAt;
+	const int32 Index = Algo::UpperBoundBy(Lane.Pending, DeliverAt, &FPending::DeliverAt);
+	Lane.Pending.Insert(MoveTemp(Item), Index);
+}
+
+void FSpaceTimeDBNetSimTransport::DeliverInbound(FPending& Item)
+{
+	switch (Item.Event)
+	{
+		case EEvent::Frame:
+			if (bConnected)
+			{
+				OnFrame.ExecuteIfBound(Item.Bytes, Item.bBinary);
+			}
+			break;
+
+		case EEvent::Connected:
+			bConnected = true;
+			OnConnected.ExecuteIfBound();
+			break;
+
+		case EEvent::Error:
+			bConnected = false;
+			OnConnectionError.ExecuteIfBound(Item.Text);
+			break;
+
+		case EEvent::Closed:
+			bConnected = false;
+			OnClosed.ExecuteIfBound(Item.StatusCode, Item.Text, Item.bWasClean);
+			break;
+	}
+}
+
+void FSpaceTimeDBNetSimTransport::DeliverOutbound(FPending& Item)
+{
+	if (!Inner->IsConnected())
+	{
+		return;
+	}
+
+	if (Item.bBinary)
+	{
+		Inner->SendBinary(Item.Bytes.GetData(), Item.Bytes.Num());
+	}
+	else
+	{
+		Inner->SendText(Item.Text);
+	}
+}
+
+void FSpaceTimeDBNetSimTransport::HandleInnerFrame(TArray<uint8>& Frame, bool bBinary)
+{
+	if (bDropped)
+	{
+		return;
+	}
+
+	const FSpaceTimeDBNetSimSettings Settings = GetSettings();
+	if (!Settings.IsActive() && Inbound.Num() == 0)
+	{
+		if (bConnected)
+		{
+			OnFrame.ExecuteIfBound(Frame, bBinary);
+		}
+		return;
+	}
+
+	FPending Item;
+	Item.bBinary = bBinary;
+	Item.Bytes = MoveTemp(Frame);
+	Schedule(Inbound, MoveTemp(Item), Settings.DownKbps, Settings);
+}
+
+void FSpaceTimeDBNetSimTransport::HandleInnerEvent(FPending&& Item)
+{
+	// After a simulated drop the real socket's own close is not news to the owner
+	if (bDropped)
+	{
+		return;
+	}
+
+	const FSpaceTimeDBNetSimSettings Settings = GetSettings();
+	if (!Settings.IsActive() && Inbound.Num() == 0)
+	{
+		DeliverInbound(Item);
+		return;
+	}
+
+	Schedule(Inbound, MoveTemp(Item), 0, Settings);
+}
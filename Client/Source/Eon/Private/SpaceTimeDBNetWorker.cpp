@@ -0,0 +1,171 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBNetWorker.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+DECLARE_CYCLE_STAT(TEXT("Decode"), STAT_EonNetDecode, STATGROUP_EonNet);
+DECLARE_CYCLE_STAT(TEXT("Encode"), STAT_EonNetEncode, STATGROUP_EonNet);
+
+FSpaceTimeDBNetWorker::FSpaceTimeDBNetWorker()
+{
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FSpaceTimeDBNetWorker::~FSpaceTimeDBNetWorker()
+{
+	Shutdown();
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+}
+
+bool FSpaceTimeDBNetWorker::Start()
+{
+	if (Thread || !FPlatformProcess::SupportsMultithreading())
+	{
+		return Thread != nullptr;
+	}
+
+	bStopping = false;
+	Thread = FRunnableThread::Create(this, TEXT("SpaceTimeDBNet"), 0, TPri_AboveNormal);
+	return Thread != nullptr;
+}
+
+void FSpaceTimeDBNetWorker::Shutdown()
+{
+	if (Thread)
+	{
+		// Kill() calls Stop() and waits for Run() to return
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+void FSpaceTimeDBNetWorker::Stop()
+{
+	bStopping = true;
+	WorkEvent->Trigger();
+}
+
+void FSpaceTimeDBNetWorker::EnqueueInbound(FSpaceTimeDBInboundFrame&& Frame)
+{
+	Inbound.Enqueue(MoveTemp(Frame));
+	InboundDepth.fetch_add(1, std::memory_order_relaxed);
+	WorkEvent->Trigger();
+}
+
+void FSpaceTimeDBNetWorker::EnqueueCalls(FSpaceTimeDBCallBatch&& Batch)
+{
+	OutgoingBatches.Enqueue(MoveTemp(Batch));
+	WorkEvent->Trigger();
+}
+
+bool FSpaceTimeDBNetWorker::DequeueDecoded(FSpaceTimeDBServerMessage& OutMessage, uint32* OutGeneration)
+{
+	FDecoded Entry;
+	if (!Decoded.Dequeue(Entry))
+	{
+		return false;
+	}
+	DecodedDepth.fetch_sub(1, std::memory_order_relaxed);
+	OutMessage = MoveTemp(Entry.Message);
+	if (OutGeneration)
+	{
+		*OutGeneration = Entry.Generation;
+	}
+	return true;
+}
+
+bool FSpaceTimeDBNetWorker::DequeueEncoded(FSpaceTimeDBOutboundFrame& OutFrame)
+{
+	return Encoded.Dequeue(OutFrame);
+}
+
+uint32 FSpaceTimeDBNetWorker::Run()
+{
+	while (!bStopping)
+	{
+		WorkEvent->Wait();
+
+		// Outgoing first: reducer calls are latency sensitive, decoded rows wait for the next drain anyway
+		ProcessOutbound();
+		ProcessInbound();
+	}
+	return 0;
+}
+
+void FSpaceTimeDBNetWorker::ProcessInbound()
+{
+	FSpaceTimeDBInboundFrame Frame;
+	while (!bStopping && Inbound.Dequeue(Frame))
+	{
+		InboundDepth.fetch_sub(1, std::memory_order_relaxed);
+
+		FDecoded Entry;
+		Entry.Generation = Frame.Generation;
+		FSpaceTimeDBServerMessage& Message = Entry.Message;
+		bool bOk = false;
+		{
+			SCOPE_CYCLE_COUNTER(STAT_EonNetDecode);
+			const double DecodeStart = FPlatformTime::Seconds();
+			bOk = Frame.bBinary
+				? FSpaceTimeDBProtocol::DecodeBinaryServerMessage(Frame.Bytes.GetData(), Frame.Bytes.Num(), Message)
+				: FSpaceTimeDBProtocol::DecodeJsonServerMessage(Frame.Bytes.GetData(), Frame.Bytes.Num(), Message);
+			if (DecodeHistogram)
+			{
+				DecodeHistogram->Record(FPlatformTime::Seconds() - DecodeStart);
+			}
+		}
+
+		if (!bOk)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Failed to decode %s message"), Frame.bBinary ? TEXT("binary") : TEXT("text"));
+			continue;
+		}
+
+		Decoded.Enqueue(MoveTemp(Entry));
+		DecodedDepth.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void FSpaceTimeDBNetWorker::ProcessOutbound()
+{
+	FSpaceTimeDBCallBatch Batch;
+	TArray<FSpaceTimeDBOutboundFrame> Frames;
+	while (!bStopping && OutgoingBatches.Dequeue(Batch))
+	{
+		Frames.Reset();
+		EncodeCallBatch(MoveTemp(Batch), Frames);
+		for (FSpaceTimeDBOutboundFrame& Frame : Frames)
+		{
+			Encoded.Enqueue(MoveTemp(Frame));
+		}
+	}
+}
+
+void FSpaceTimeDBNetWorker::EncodeCallBatch(FSpaceTimeDBCallBatch&& Batch, TArray<FSpaceTimeDBOutboundFrame>& OutFrames)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EonNetEncode);
+
+	// SpaceTimeDB takes one ClientMessage per frame; batching saves the
+	// per-call flushes and the queueing, not the frames themselves
+	uint32 RequestId = Batch.FirstRequestId;
+	OutFrames.Reserve(OutFrames.Num() + Batch.Calls.Num());
+	for (FSpaceTimeDBReducerCall& Call : Batch.Calls)
+	{
+		FSpaceTimeDBOutboundFrame& Frame = OutFrames.AddDefaulted_GetRef();
+		Frame.bBinary = Batch.bBinary;
+		Frame.Generation = Batch.Generation;
+		if (Batch.bBinary)
+		{
+			FSpaceTimeDBProtocol::EncodeReducerCallBinary(Call.ReducerName, Call.Args, RequestId++, Frame.Bytes);
+		}
+		else
+		{
+			FSpaceTimeDBProtocol::EncodeReducerCallJson(Call.ReducerName, Call.Args, RequestId++, Frame.Text);
+		}
+		Frame.Call = MoveTemp(Call);
+	}
+}
@@ -0,0 +1,1259 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBProtocol.h"
+#include "Json.h"
+#include "JsonUtilities.h"
+#include "Misc/Parse.h"
+
+const TCHAR* FSpaceTimeDBProtocol::JsonSubprotocol = TEXT("wss");
+const TCHAR* FSpaceTimeDBProtocol::BinarySubprotocol = TEXT("v1.bsatn.spacetimedb");
+
+namespace
+{
+	// ClientMessage / ServerMessage variant tags (SpaceTimeDB v1 websocket API)
+	constexpr uint8 ClientTagCallReducer = 0;
+	constexpr uint8 ClientTagSubscribe = 1;
+
+	constexpr uint8 ServerTagInitialSubscription = 0;
+	constexpr uint8 ServerTagTransactionUpdate = 1;
+	constexpr uint8 ServerTagTransactionUpdateLight = 2;
+	constexpr uint8 ServerTagIdentityToken = 3;
+
+	constexpr uint8 CompressionNone = 0;
+	constexpr uint8 UpdateStatusCommitted = 0;
+	constexpr uint8 UpdateStatusFailed = 1;
+	constexpr uint8 QueryUpdateUncompressed = 0;
+	constexpr uint8 RowSizeHintFixed = 0;
+	constexpr uint8 OptionSome = 0;
+
+	constexpr int32 ConnectionIdSize = 16;
+
+	using FTypedJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FTypedJsonWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	// Appends Value as the body of a JSON string (no surrounding quotes)
+	void AppendJsonEscaped(FString& Out, const FString& Value)
+	{
+		for (const TCHAR Char : Value)
+		{
+			switch (Char)
+			{
+				case TEXT('"'): Out.Append(TEXT("\\\"")); break;
+				case TEXT('\\'): Out.Append(TEXT("\\\\")); break;
+				case TEXT('\n'): Out.Append(TEXT("\\n")); break;
+				case TEXT('\r'): Out.Append(TEXT("\\r")); break;
+				case TEXT('\t'): Out.Append(TEXT("\\t")); break;
+				default:
+					if (Char < 0x20)
+					{
+						Out.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+					}
+					else
+					{
+						Out.AppendChar(Char);
+					}
+					break;
+			}
+		}
+	}
+
+	void AppendJsonArg(FString& Out, const FSpaceTimeDBArg& Arg)
+	{
+		Out.AppendChar(TEXT('"'));
+		switch (Arg.Type)
+		{
+			case ESpaceTimeDBArgType::Bool: Out.Append(Arg.BoolValue ? TEXT("true") : TEXT("false")); break;
+			case ESpaceTimeDBArgType::U32: Out.Appendf(TEXT("%u"), Arg.U32Value); break;
+			case ESpaceTimeDBArgType::U64: Out.Appendf(TEXT("%llu"), Arg.U64Value); break;
+			// 9 significant digits round-trip any f32
+			case ESpaceTimeDBArgType::F32: Out.Appendf(TEXT("%.9g"), Arg.F32Value); break;
+			case ESpaceTimeDBArgType::String: AppendJsonEscaped(Out, Arg.StringValue); break;
+			case ESpaceTimeDBArgType::Identity: Out.Append(TEXT("0x")).Append(Arg.IdentityValue.ToHex()); break;
+		}
+		Out.AppendChar(TEXT('"'));
+	}
+
+	void WriteArg(FBsatnWriter& Writer, const FSpaceTimeDBArg& Arg)
+	{
+		switch (Arg.Type)
+		{
+			case ESpaceTimeDBArgType::Bool: Writer.WriteBool(Arg.BoolValue); break;
+			case ESpaceTimeDBArgType::U32: Writer.WriteU32(Arg.U32Value); break;
+			case ESpaceTimeDBArgType::U64: Writer.WriteU64(Arg.U64Value); break;
+			case ESpaceTimeDBArgType::F32: Writer.WriteF32(Arg.F32Value); break;
+			case ESpaceTimeDBArgType::String: Writer.WriteString(Arg.StringValue); break;
+			case ESpaceTimeDBArgType::Identity: Writer.WriteRaw(Arg.IdentityValue.GetBytes(), FSpaceTimeDBIdentity::NumBytes); break;
+		}
+	}
+
+	FSpaceTimeDBIdentity ReadIdentity(FBsatnReader& Reader)
+	{
+		uint8 Bytes[FSpaceTimeDBIdentity::NumBytes];
+		Reader.ReadRaw(Bytes, FSpaceTimeDBIdentity::NumBytes);
+		return Reader.IsError() ? FSpaceTimeDBIdentity() : FSpaceTimeDBIdentity::FromBytes(Bytes);
+	}
+
+	using FKey = FUtf8JsonReader;
+
+	// ReadRow / ReadJsonField / WriteJsonColumns for every mirrored table
+	#include "SpaceTimeDBSchema.inl"
+
+	template <typename RowType>
+	bool ReadRowList(FBsatnReader& Reader, ESpaceTimeDBRowOp Op, TArray<TSpaceTimeDBRowUpdate<RowType>>& OutRows)
+	{
+		// RowSizeHint is informational for us: rows are self-delimiting given the schema
+		if (Reader.ReadU8() == RowSizeHintFixed)
+		{
+			Reader.ReadU16();
+		}
+		else
+		{
+			Reader.Skip(static_cast<int32>(Reader.ReadU32()) * sizeof(uint64));
+		}
+
+		TArrayView<const uint8> RowsData = Reader.ReadBytes();
+		FBsatnReader RowReader(RowsData.GetData(), RowsData.Num());
+		while (!Reader.IsError() && !RowReader.AtEnd() && !RowReader.IsError())
+		{
+			TSpaceTimeDBRowUpdate<RowType>& Update = OutRows.AddDefaulted_GetRef();
+			Update.Op = Op;
+			ReadRow(RowReader, Update.Row);
+		}
+		return !Reader.IsError() && !RowReader.IsError();
+	}
+
+	bool SkipRowList(FBsatnReader& Reader)
+	{
+		if (Reader.ReadU8() == RowSizeHintFixed)
+		{
+			Reader.ReadU16();
+		}
+		else
+		{
+			Reader.Skip(static_cast<int32>(Reader.ReadU32()) * sizeof(uint64));
+		}
+		Reader.ReadBytes();
+		return !Reader.IsError();
+	}
+
+	template <typename RowType>
+	bool ReadTableUpdates(FBsatnReader& Reader, uint32 NumUpdates, TArray<TSpaceTimeDBRowUpdate<RowType>>& OutRows)
+	{
+		const int32 FirstRow = OutRows.Num();
+		for (uint32 UpdateIndex = 0; UpdateIndex < NumUpdates; ++UpdateIndex)
+		{
+			if (Reader.ReadU8() != QueryUpdateUncompressed)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Compressed query updates are not supported"));
+				return false;
+			}
+			if (!ReadRowList(Reader, ESpaceTimeDBRowOp::Delete, OutRows) || !ReadRowList(Reader, ESpaceTimeDBRowOp::Upsert, OutRows))
+			{
+				return false;
+			}
+		}
+
+		// An update arrives as delete(old) + insert(new) for the same key;
+		// only keep deletes whose key was not re-inserted.
+		TSpaceTimeDBKeySet<typename RowType::KeyType> InsertedKeys;
+		for (int32 i = FirstRow; i < OutRows.Num(); ++i)
+		{
+			if (OutRows[i].Op == ESpaceTimeDBRowOp::Upsert)
+			{
+				InsertedKeys.Add(OutRows[i].Row.GetKey());
+			}
+		}
+		for (int32 i = OutRows.Num() - 1; i >= FirstRow; --i)
+		{
+			if (OutRows[i].Op == ESpaceTimeDBRowOp::Delete && InsertedKeys.Contains(OutRows[i].Row.GetKey()))
+			{
+				OutRows.RemoveAt(i);
+			}
+		}
+		return true;
+	}
+
+	bool ReadDatabaseUpdate(FBsatnReader& Reader, FSpaceTimeDBServerMessage& OutMessage)
+	{
+		const uint32 NumTables = Reader.ReadU32();
+		for (uint32 TableIndex = 0; TableIndex < NumTables && !Reader.IsError(); ++TableIndex)
+		{
+			Reader.ReadU32(); // table_id
+			const FString TableName = Reader.ReadString();
+			Reader.ReadU64(); // num_rows
+			const uint32 NumUpdates = Reader.ReadU32();
+
+			bool bOk = true;
+			if (TableName == FSpaceTimeDBPlayerRow::TableName)
+			{
+				bOk = ReadTableUpdates(Reader, NumUpdates, OutMessage.Players);
+			}
+			else if (TableName == FSpaceTimeDBInventoryRow::TableName)
+			{
+				bOk = ReadTableUpdates(Reader, NumUpdates, OutMessage.InventoryItems);
+			}
+			else if (TableName == FSpaceTimeDBInstanceRow::TableName)
+			{
+				bOk = ReadTableUpdates(Reader, NumUpdates, OutMessage.Instances);
+			}
+			else if (TableName == FSpaceTimeDBWorldItemRow::TableName)
+			{
+				bOk = ReadTableUpdates(Reader, NumUpdates, OutMessage.WorldItems);
+			}
+			else if (TableName == FSpaceTimeDBInteractableRow::TableName)
+			{
+				bOk = ReadTableUpdates(Reader, NumUpdates, OutMessage.Interactables);
+			}
+			else if (TableName == FSpaceTimeDBItemDefinitionRow::TableName)
+			{
+				bOk = ReadTableUpdates(Reader, NumUpdates, OutMessage.ItemDefinitions);
+			}
+			else
+			{
+				for (uint32 UpdateIndex = 0; UpdateIndex < NumUpdates && bOk; ++UpdateIndex)
+				{
+					bOk = Reader.ReadU8() == QueryUpdateUncompressed && SkipRowList(Reader) && SkipRowList(Reader);
+				}
+			}
+
+			if (!bOk)
+			{
+				return false;
+			}
+		}
+		return !Reader.IsError();
+	}
+
+	// The rest of a full TransactionUpdate after its status: who called which reducer
+	bool ReadReducerCallInfo(FBsatnReader& Reader, FSpaceTimeDBServerMessage& OutMessage)
+	{
+		OutMessage.TimestampMicros = Reader.ReadI64();
+		OutMessage.CallerIdentity = ReadIdentity(Reader);
+		Reader.Skip(ConnectionIdSize);
+		Reader.ReadBytes(); // reducer_name, same layout as a string
+		Reader.ReadU32(); // reducer_id
+		Reader.ReadBytes(); // args
+		OutMessage.RequestId = Reader.ReadU32();
+		return !Reader.IsError();
+	}
+
+	// JSON keys and string values the decoder switches on
+	constexpr uint32 JsonKeyType = FKey::HashKey("type");
+	constexpr uint32 JsonKeyUpdates = FKey::HashKey("updates");
+	constexpr uint32 JsonKeyIdentity = FKey::HashKey("identity");
+	constexpr uint32 JsonKeyTable = FKey::HashKey("table");
+	constexpr uint32 JsonKeyRequestId = FKey::HashKey("request_id");
+	constexpr uint32 JsonKeyCallerIdentity = FKey::HashKey("caller_identity");
+	constexpr uint32 JsonKeyToken = FKey::HashKey("token");
+	constexpr uint32 JsonKeyTimestamp = FKey::HashKey("timestamp");
+
+	constexpr uint32 JsonTypeTransactionUpdate = FKey::HashKey("TransactionUpdate");
+	constexpr uint32 JsonTypeIdentityToken = FKey::HashKey("IdentityToken");
+
+	constexpr uint32 JsonTablePlayer = FKey::HashKey("player");
+	constexpr uint32 JsonTableInventoryItem = FKey::HashKey("inventory_item");
+	constexpr uint32 JsonTableInstance = FKey::HashKey("instance");
+	constexpr uint32 JsonTableWorldItem = FKey::HashKey("world_item");
+	constexpr uint32 JsonTableInteractable = FKey::HashKey("interactable_state");
+	constexpr uint32 JsonTableItemDefinition = FKey::HashKey("item_definition");
+
+	// Reads the remaining columns of an update object into a new row
+	template <typename RowType>
+	void ReadJsonRow(FUtf8JsonReader& Reader, TArray<TSpaceTimeDBRowUpdate<RowType>>& OutUpdates)
+	{
+		RowType& Row = OutUpdates.AddDefaulted_GetRef().Row;
+
+		uint32 Key = 0;
+		while (Reader.NextKey(Key))
+		{
+			if (Key == JsonKeyTable)
+			{
+				Reader.SkipValue();
+			}
+			else
+			{
+				ReadJsonField(Reader, Key, Row);
+			}
+		}
+	}
+
+	// One {"table": name, <columns>...} update. The table key normally comes
+	// first; if columns precede it the object is re-read once the table is known.
+	void ReadJsonUpdate(FUtf8JsonReader& Reader, FSpaceTimeDBServerMessage& OutMessage)
+	{
+		if (Reader.PeekChar() != '{')
+		{
+			Reader.SkipValue();
+			return;
+		}
+
+		const int32 ObjectStart = Reader.Tell();
+		Reader.BeginObject();
+
+		uint32 Key = 0;
+		uint32 Table = 0;
+		bool bHasTable = false;
+		bool bSkippedColumns = false;
+		while (!bHasTable && Reader.NextKey(Key))
+		{
+			if (Key == JsonKeyTable)
+			{
+				Table = Reader.ReadStringHash();
+				bHasTable = true;
+			}
+			else
+			{
+				Reader.SkipValue();
+				bSkippedColumns = true;
+			}
+		}
+
+		if (!bHasTable)
+		{
+			return;
+		}
+
+		if (bSkippedColumns)
+		{
+			Reader.Seek(ObjectStart);
+			Reader.BeginObject();
+		}
+
+		switch (Table)
+		{
+			case JsonTablePlayer: ReadJsonRow(Reader, OutMessage.Players); break;
+			case JsonTableInventoryItem: ReadJsonRow(Reader, OutMessage.InventoryItems); break;
+			case JsonTableInstance: ReadJsonRow(Reader, OutMessage.Instances); break;
+			case JsonTableWorldItem: ReadJsonRow(Reader, OutMessage.WorldItems); break;
+			case JsonTableInteractable: ReadJsonRow(Reader, OutMessage.Interactables); break;
+			case JsonTableItemDefinition: ReadJsonRow(Reader, OutMessage.ItemDefinitions); break;
+			default:
+				while (Reader.NextKey(Key))
+				{
+					Reader.SkipValue();
+				}
+				break;
+		}
+	}
+}
+
+// ============================================================================
+// FSpaceTimeDBArg
+// ============================================================================
+
+FSpaceTimeDBArg FSpaceTimeDBArg::Bool(bool Value)
+{
+	FSpaceTimeDBArg Arg;
+	Arg.Type = ESpaceTimeDBArgType::Bool;
+	Arg.BoolValue = Value;
+	return Arg;
+}
+
+FSpaceTimeDBArg FSpaceTimeDBArg::U32(uint32 Value)
+{
+	FSpaceTimeDBArg Arg;
+	Arg.Type = ESpaceTimeDBArgType::U32;
+	Arg.U32Value = Value;
+	return Arg;
+}
+
+FSpaceTimeDBArg FSpaceTimeDBArg::U64(uint64 Value)
+{
+	FSpaceTimeDBArg Arg;
+	Arg.Type = ESpaceTimeDBArgType::U64;
+	Arg.U64Value = Value;
+	return Arg;
+}
+
+FSpaceTimeDBArg FSpaceTimeDBArg::F32(float Value)
+{
+	FSpaceTimeDBArg Arg;
+	Arg.Type = ESpaceTimeDBArgType::F32;
+	Arg.F32Value = Value;
+	return Arg;
+}
+
+FSpaceTimeDBArg FSpaceTimeDBArg::String(const FString& Value)
+{
+	FSpaceTimeDBArg Arg;
+	Arg.Type = ESpaceTimeDBArgType::String;
+	Arg.StringValue = Value;
+	return Arg;
+}
+
+FSpaceTimeDBArg FSpaceTimeDBArg::Identity(const FSpaceTimeDBIdentity& Value)
+{
+	FSpaceTimeDBArg Arg;
+	Arg.Type = ESpaceTimeDBArgType::Identity;
+	Arg.IdentityValue = Value;
+	return Arg;
+}
+
+// ============================================================================
+// FBsatnWriter
+// ============================================================================
+
+void FBsatnWriter::WriteString(const FString& Value)
+{
+	FTCHARToUTF8 Utf8(*Value, Value.Len());
+	WriteU32(static_cast<uint32>(Utf8.Length()));
+	WriteRaw(Utf8.Get(), Utf8.Length());
+}
+
+void FBsatnWriter::WriteBytes(const uint8* Data, int32 Size)
+{
+	WriteU32(static_cast<uint32>(Size));
+	WriteRaw(Data, Size);
+}
+
+void FBsatnWriter::WriteRaw(const void* Data, int32 Size)
+{
+	Buffer.Append(static_cast<const uint8*>(Data), Size);
+}
+
+int32 FBsatnWriter::BeginLengthPrefixed()
+{
+	const int32 PrefixOffset = Buffer.Num();
+	WriteU32(0);
+	return PrefixOffset;
+}
+
+void FBsatnWriter::EndLengthPrefixed(int32 PrefixOffset)
+{
+	const uint32 Length = static_cast<uint32>(Buffer.Num() - PrefixOffset - sizeof(uint32));
+	FMemory::Memcpy(Buffer.GetData() + PrefixOffset, &Length, sizeof(Length));
+}
+
+// ============================================================================
+// FBsatnReader
+// ============================================================================
+
+bool FBsatnReader::Require(int32 Count)
+{
+	if (bError || Count < 0 || Count > Size - Offset)
+	{
+		bError = true;
+		return false;
+	}
+	return true;
+}
+
+uint8 FBsatnReader::ReadU8()
+{
+	return Require(1) ? Data[Offset++] : 0;
+}
+
+uint16 FBsatnReader::ReadU16()
+{
+	uint16 Value = 0;
+	ReadRaw(&Value, sizeof(Value));
+	return Value;
+}
+
+uint32 FBsatnReader::ReadU32()
+{
+	uint32 Value = 0;
+	ReadRaw(&Value, sizeof(Value));
+	return Value;
+}
+
+uint64 FBsatnReader::ReadU64()
+{
+	uint64 Value = 0;
+	ReadRaw(&Value, sizeof(Value));
+	return Value;
+}
+
+int64 FBsatnReader::ReadI64()
+{
+	int64 Value = 0;
+	ReadRaw(&Value, sizeof(Value));
+	return Value;
+}
+
+float FBsatnReader::ReadF32()
+{
+	float Value = 0.0f;
+	ReadRaw(&Value, sizeof(Value));
+	return Value;
+}
+
+FString FBsatnReader::ReadString()
+{
+	const int32 Length = static_cast<int32>(ReadU32());
+	if (!Require(Length))
+	{
+		return FString();
+	}
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), Length);
+	Offset += Length;
+	return FString(Converted.Length(), Converted.Get());
+}
+
+TArrayView<const uint8> FBsatnReader::ReadBytes()
+{
+	const int32 Length = static_cast<int32>(ReadU32());
+	if (!Require(Length))
+	{
+		return TArrayView<const uint8>();
+	}
+
+	TArrayView<const uint8> View(Data + Offset, Length);
+	Offset += Length;
+	return View;
+}
+
+void FBsatnReader::ReadRaw(void* Out, int32 Count)
+{
+	if (Require(Count))
+	{
+		FMemory::Memcpy(Out, Data + Offset, Count);
+		Offset += Count;
+	}
+}
+
+void FBsatnReader::Skip(int32 Count)
+{
+	if (Require(Count))
+	{
+		Offset += Count;
+	}
+}
+
+// ============================================================================
+// FUtf8JsonReader
+// ============================================================================
+
+uint32 FUtf8JsonReader::HashKey(const uint8* Bytes, int32 Count)
+{
+	uint32 Hash = 2166136261u;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Hash = (Hash ^ Bytes[i]) * 16777619u;
+	}
+	return Hash;
+}
+
+void FUtf8JsonReader::SetError()
+{
+	bError = true;
+	Offset = Size;
+}
+
+void FUtf8JsonReader::SkipWhitespace()
+{
+	while (Offset < Size && (Data[Offset] == ' ' || Data[Offset] == '\t' || Data[Offset] == '\n' || Data[Offset] == '\r'))
+	{
+		++Offset;
+	}
+}
+
+uint8 FUtf8JsonReader::PeekChar()
+{
+	SkipWhitespace();
+	return Offset < Size ? Data[Offset] : 0;
+}
+
+bool FUtf8JsonReader::Consume(uint8 Char)
+{
+	if (PeekChar() != Char)
+	{
+		return false;
+	}
+	++Offset;
+	return true;
+}
+
+bool FUtf8JsonReader::ConsumeLiteral(const char* Literal)
+{
+	SkipWhitespace();
+	const int32 Length = FCStringAnsi::Strlen(Literal);
+	if (Size - Offset < Length || FMemory::Memcmp(Data + Offset, Literal, Length) != 0)
+	{
+		return false;
+	}
+	Offset += Length;
+	return true;
+}
+
+bool FUtf8JsonReader::BeginObject()
+{
+	if (!Consume('{'))
+	{
+		SetError();
+		return false;
+	}
+	return true;
+}
+
+bool FUtf8JsonReader::NextKey(uint32& OutKeyHash)
+{
+	if (bError || Consume('}'))
+	{
+		return false;
+	}
+	Consume(',');
+
+	int32 Start = 0, End = 0;
+	bool bEscaped = false;
+	if (!ScanString(Start, End, bEscaped) || !Consume(':'))
+	{
+		SetError();
+		return false;
+	}
+
+	// Escaped keys hash their raw bytes and so never match a known column
+	OutKeyHash = HashKey(Data + Start, End - Start);
+	return true;
+}
+
+bool FUtf8JsonReader::BeginArray()
+{
+	if (!Consume('['))
+	{
+		SetError();
+		return false;
+	}
+	return true;
+}
+
+bool FUtf8JsonReader::NextElement()
+{
+	if (bError || Consume(']'))
+	{
+		return false;
+	}
+	Consume(',');
+	return !bError;
+}
+
+bool FUtf8JsonReader::ScanString(int32& OutStart, int32& OutEnd, bool& bOutEscaped)
+{
+	if (!Consume('"'))
+	{
+		return false;
+	}
+
+	OutStart = Offset;
+	bOutEscaped = false;
+	while (Offset < Size)
+	{
+		const uint8 Char = Data[Offset];
+		if (Char == '"')
+		{
+			OutEnd = Offset++;
+			return true;
+		}
+		if (Char == '\\')
+		{
+			bOutEscaped = true;
+			++Offset;
+		}
+		++Offset;
+	}
+	return false;
+}
+
+FString FUtf8JsonReader::ReadString()
+{
+	int32 Start = 0, End = 0;
+	bool bEscaped = false;
+	if (!ScanString(Start, End, bEscaped))
+	{
+		SetError();
+		return FString();
+	}
+
+	if (!bEscaped)
+	{
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Start), End - Start);
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	// Unescape into UTF-8 first, then convert once
+	TArray<ANSICHAR, TInlineAllocator<256>> Utf8;
+	Utf8.Reserve(End - Start);
+	for (int32 i = Start; i < End; ++i)
+	{
+		if (Data[i] != '\\' || i + 1 >= End)
+		{
+			Utf8.Add(static_cast<ANSICHAR>(Data[i]));
+			continue;
+		}
+
+		switch (Data[++i])
+		{
+			case 'b': Utf8.Add('\b'); break;
+			case 'f': Utf8.Add('\f'); break;
+			case 'n': Utf8.Add('\n'); break;
+			case 'r': Utf8.Add('\r'); break;
+			case 't': Utf8.Add('\t'); break;
+			case 'u':
+			{
+				auto ReadHex4 = [this, End](int32 At, uint32& OutValue)
+				{
+					OutValue = 0;
+					for (int32 Digit = 0; Digit < 4; ++Digit)
+					{
+						if (At + Digit >= End || !FChar::IsHexDigit(static_cast<TCHAR>(Data[At + Digit])))
+						{
+							return false;
+						}
+						OutValue = (OutValue << 4) | FParse::HexDigit(static_cast<TCHAR>(Data[At + Digit]));
+					}
+					return true;
+				};
+
+				uint32 CodePoint = 0;
+				if (!ReadHex4(i + 1, CodePoint))
+				{
+					SetError();
+					return FString();
+				}
+				i += 4;
+
+				// A high surrogate followed by an escaped low surrogate encodes one code point
+				uint32 Low = 0;
+				if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && i + 2 < End && Data[i + 1] == '\\' && Data[i + 2] == 'u' &&
+					ReadHex4(i + 3, Low) && Low >= 0xDC00 && Low <= 0xDFFF)
+				{
+					CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+					i += 6;
+				}
+
+				if (CodePoint < 0x80)
+				{
+					Utf8.Add(static_cast<ANSICHAR>(CodePoint));
+				}
+				else if (CodePoint < 0x800)
+				{
+					Utf8.Add(static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6)));
+					Utf8.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+				}
+				else if (CodePoint < 0x10000)
+				{
+					Utf8.Add(static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12)));
+					Utf8.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+					Utf8.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+				}
+				else
+				{
+					Utf8.Add(static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18)));
+					Utf8.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+					Utf8.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+					Utf8.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+				}
+				break;
+			}
+			default: Utf8.Add(static_cast<ANSICHAR>(Data[i])); break; // quote, backslash, slash
+		}
+	}
+
+	FUTF8ToTCHAR Converted(Utf8.GetData(), Utf8.Num());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+FSpaceTimeDBIdentity FUtf8JsonReader::ReadIdentity()
+{
+	int32 Start = 0, End = 0;
+	bool bEscaped = false;
+	if (!ScanString(Start, End, bEscaped))
+	{
+		SetError();
+		return FSpaceTimeDBIdentity();
+	}
+
+	// A malformed identity would otherwise alias every other one onto the zero identity
+	FSpaceTimeDBIdentity Identity;
+	if (!FSpaceTimeDBIdentity::FromHex(reinterpret_cast<const UTF8CHAR*>(Data + Start), End - Start, Identity))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Identity is not valid hex"));
+		SetError();
+		return FSpaceTimeDBIdentity();
+	}
+	return Identity;
+}
+
+uint32 FUtf8JsonReader::ReadStringHash()
+{
+	int32 Start = 0, End = 0;
+	bool bEscaped = false;
+	if (!ScanString(Start, End, bEscaped))
+	{
+		SetError();
+		return 0;
+	}
+	return HashKey(Data + Start, End - Start);
+}
+
+bool FUtf8JsonReader::ReadBool()
+{
+	if (ConsumeLiteral("true"))
+	{
+		return true;
+	}
+	if (!ConsumeLiteral("false"))
+	{
+		SetError();
+	}
+	return false;
+}
+
+bool FUtf8JsonReader::TryReadNull()
+{
+	return ConsumeLiteral("null");
+}
+
+bool FUtf8JsonReader::ScanNumber(ANSICHAR (&OutBuffer)[64], int32& OutLength)
+{
+	const bool bQuoted = Consume('"');
+
+	OutLength = 0;
+	while (Offset < Size && OutLength < static_cast<int32>(UE_ARRAY_COUNT(OutBuffer)) - 1)
+	{
+		const uint8 Char = Data[Offset];
+		if (!FChar::IsDigit(static_cast<TCHAR>(Char)) && Char != '-' && Char != '+' && Char != '.' && Char != 'e' && Char != 'E')
+		{
+			break;
+		}
+		OutBuffer[OutLength++] = static_cast<ANSICHAR>(Char);
+		++Offset;
+	}
+	OutBuffer[OutLength] = '\0';
+
+	if (OutLength == 0 || (bQuoted && !Consume('"')))
+	{
+		SetError();
+		return false;
+	}
+	return true;
+}
+
+double FUtf8JsonReader::ReadDouble()
+{
+	ANSICHAR Buffer[64];
+	int32 Length = 0;
+	return ScanNumber(Buffer, Length) ? FCStringAnsi::Atod(Buffer) : 0.0;
+}
+
+uint64 FUtf8JsonReader::ReadU64()
+{
+	ANSICHAR Buffer[64];
+	int32 Length = 0;
+	if (!ScanNumber(Buffer, Length))
+	{
+		return 0;
+	}
+
+	// Integers are parsed exactly; anything with a fraction or exponent goes through double
+	uint64 Value = 0;
+	for (int32 i = 0; i < Length; ++i)
+	{
+		if (!FChar::IsDigit(Buffer[i]))
+		{
+			return Buffer[0] == '-' ? 0 : static_cast<uint64>(FCStringAnsi::Atod(Buffer));
+		}
+		Value = Value * 10 + (Buffer[i] - '0');
+	}
+	return Value;
+}
+
+int64 FUtf8JsonReader::ReadI64()
+{
+	ANSICHAR Buffer[64];
+	int32 Length = 0;
+	if (!ScanNumber(Buffer, Length))
+	{
+		return 0;
+	}
+
+	const bool bNegative = Buffer[0] == '-';
+	int64 Value = 0;
+	for (int32 i = bNegative ? 1 : 0; i < Length; ++i)
+	{
+		if (!FChar::IsDigit(Buffer[i]))
+		{
+			return static_cast<int64>(FCStringAnsi::Atod(Buffer));
+		}
+		Value = Value * 10 + (Buffer[i] - '0');
+	}
+	return bNegative ? -Value : Value;
+}
+
+void FUtf8JsonReader::SkipValue()
+{
+	SkipValue(0);
+}
+
+void FUtf8JsonReader::SkipValue(int32 Depth)
+{
+	// Server frames are shallow; anything deeper is treated as malformed
+	constexpr int32 MaxDepth = 64;
+	if (Depth > MaxDepth)
+	{
+		SetError();
+		return;
+	}
+
+	uint32 Key = 0;
+	int32 Start = 0, End = 0;
+	bool bEscaped = false;
+	switch (PeekChar())
+	{
+		case '{':
+			BeginObject();
+			while (NextKey(Key))
+			{
+				SkipValue(Depth + 1);
+			}
+			break;
+		case '[':
+			BeginArray();
+			while (NextElement())
+			{
+				SkipValue(Depth + 1);
+			}
+			break;
+		case '"':
+			if (!ScanString(Start, End, bEscaped))
+			{
+				SetError();
+			}
+			break;
+		case 't':
+		case 'f':
+			ReadBool();
+			break;
+		case 'n':
+			if (!TryReadNull())
+			{
+				SetError();
+			}
+			break;
+		default:
+			ReadDouble();
+			break;
+	}
+}
+
+// ============================================================================
+// FSpaceTimeDBProtocol
+// ============================================================================
+
+void FSpaceTimeDBProtocol::EncodeReducerCallJson(const FString& ReducerName, TArrayView<const FSpaceTimeDBArg> Args, uint32 RequestId, FString& OutFrame)
+{
+	OutFrame.Reserve(OutFrame.Len() + ReducerName.Len() + 48 + Args.Num() * 16);
+	OutFrame.Append(TEXT("{\"call\":\""));
+	AppendJsonEscaped(OutFrame, ReducerName);
+	OutFrame.Append(TEXT("\",\"args\":["));
+	for (int32 i = 0; i < Args.Num(); ++i)
+	{
+		if (i > 0)
+		{
+			OutFrame.AppendChar(TEXT(','));
+		}
+		AppendJsonArg(OutFrame, Args[i]);
+	}
+	OutFrame.Appendf(TEXT("],\"request_id\":%u}"), RequestId);
+}
+
+void FSpaceTimeDBProtocol::EncodeSubscribeJson(const FString& Query, FString& OutFrame)
+{
+	TSharedRef<FTypedJsonWriter> Writer = FTypedJsonWriterFactory::Create(&OutFrame);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("subscribe"), Query);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+}
+
+void FSpaceTimeDBProtocol::EncodeUnsubscribeJson(const FString& Query, FString& OutFrame)
+{
+	TSharedRef<FTypedJsonWriter> Writer = FTypedJsonWriterFactory::Create(&OutFrame);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("unsubscribe"), Query);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+}
+
+void FSpaceTimeDBProtocol::EncodeReducerCallBinary(const FString& ReducerName, TArrayView<const FSpaceTimeDBArg> Args, uint32 RequestId, TArray<uint8>& OutFrame)
+{
+	FBsatnWriter Writer(OutFrame);
+	Writer.WriteU8(ClientTagCallReducer);
+	Writer.WriteString(ReducerName);
+
+	const int32 ArgsPrefix = Writer.BeginLengthPrefixed();
+	for (const FSpaceTimeDBArg& Arg : Args)
+	{
+		WriteArg(Writer, Arg);
+	}
+	Writer.EndLengthPrefixed(ArgsPrefix);
+
+	Writer.WriteU32(RequestId);
+	Writer.WriteU8(0); // CallReducerFlags::FullUpdate
+}
+
+void FSpaceTimeDBProtocol::EncodeSubscribeBinary(TArrayView<const FString> Queries, uint32 RequestId, TArray<uint8>& OutFrame)
+{
+	FBsatnWriter Writer(OutFrame);
+	Writer.WriteU8(ClientTagSubscribe);
+	Writer.WriteU32(static_cast<uint32>(Queries.Num()));
+	for (const FString& Query : Queries)
+	{
+		Writer.WriteString(Query);
+	}
+	Writer.WriteU32(RequestId);
+}
+
+bool FSpaceTimeDBProtocol::DecodeJsonServerMessage(const uint8* Data, int32 Size, FSpaceTimeDBServerMessage& OutMessage)
+{
+	FUtf8JsonReader Reader(Data, Size);
+	if (!Reader.BeginObject())
+	{
+		return false;
+	}
+
+	uint32 Key = 0;
+	uint32 MessageType = 0;
+	while (Reader.NextKey(Key))
+	{
+		switch (Key)
+		{
+			case JsonKeyType:
+				MessageType = Reader.ReadStringHash();
+				break;
+
+			case JsonKeyUpdates:
+				if (Reader.PeekChar() != '[')
+				{
+					Reader.SkipValue();
+					break;
+				}
+				Reader.BeginArray();
+				while (Reader.NextElement())
+				{
+					ReadJsonUpdate(Reader, OutMessage);
+				}
+				break;
+
+			case JsonKeyIdentity:
+				OutMessage.Identity = Reader.ReadIdentity();
+				break;
+
+			case JsonKeyRequestId:
+				OutMessage.RequestId = Reader.ReadU32();
+				break;
+
+			case JsonKeyCallerIdentity:
+				OutMessage.CallerIdentity = Reader.ReadIdentity();
+				break;
+
+			case JsonKeyToken:
+				OutMessage.Token = Reader.ReadString();
+				break;
+
+			case JsonKeyTimestamp:
+				// A bare number, or SpaceTimeDB's {"__timestamp_micros_since_unix_epoch__": n}
+				if (Reader.PeekChar() == '{')
+				{
+					Reader.BeginObject();
+					while (Reader.NextKey(Key))
+					{
+						OutMessage.TimestampMicros = Reader.ReadI64();
+					}
+				}
+				else
+				{
+					OutMessage.TimestampMicros = Reader.ReadI64();
+				}
+				break;
+
+			default:
+				Reader.SkipValue();
+				break;
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	// "type" may follow the payload, so fields are only kept once it is known
+	switch (MessageType)
+	{
+		case JsonTypeTransactionUpdate:
+			OutMessage.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+			OutMessage.Identity = FSpaceTimeDBIdentity();
+			OutMessage.Token.Reset();
+			break;
+
+		case JsonTypeIdentityToken:
+		{
+			const FSpaceTimeDBIdentity Identity = OutMessage.Identity;
+			FString Token = MoveTemp(OutMessage.Token);
+			OutMessage = FSpaceTimeDBServerMessage();
+			OutMessage.Type = ESpaceTimeDBMessageType::IdentityToken;
+			OutMessage.Identity = Identity;
+			OutMessage.Token = MoveTemp(Token);
+			break;
+		}
+
+		default:
+			OutMessage = FSpaceTimeDBServerMessage();
+			break;
+	}
+	return true;
+}
+
+bool FSpaceTimeDBProtocol::DecodeJsonServerMessage(const FString& Message, FSpaceTimeDBServerMessage& OutMessage)
+{
+	FTCHARToUTF8 Utf8(*Message, Message.Len());
+	return DecodeJsonServerMessage(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length(), OutMessage);
+}
+
+bool FSpaceTimeDBProtocol::DecodeBinaryServerMessage(const uint8* Data, int32 Size, FSpaceTimeDBServerMessage& OutMessage)
+{
+	FBsatnReader Reader(Data, Size);
+
+	if (Reader.ReadU8() != CompressionNone)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpaceTimeDB: Compressed server messages are not supported"));
+		return false;
+	}
+
+	switch (Reader.ReadU8())
+	{
+		case ServerTagInitialSubscription:
+			OutMessage.Type = ESpaceTimeDBMessageType::InitialSubscription;
+			return ReadDatabaseUpdate(Reader, OutMessage);
+
+		case ServerTagTransactionUpdate:
+		{
+			OutMessage.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+			// Failed / out-of-energy transactions carry no row changes
+			const uint8 Status = Reader.ReadU8();
+			if (Status == UpdateStatusCommitted && !ReadDatabaseUpdate(Reader, OutMessage))
+			{
+				return false;
+			}
+			if (Status == UpdateStatusFailed)
+			{
+				Reader.ReadBytes(); // error message
+			}
+			return ReadReducerCallInfo(Reader, OutMessage);
+		}
+
+		case ServerTagTransactionUpdateLight:
+			OutMessage.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+			OutMessage.RequestId = Reader.ReadU32();
+			return ReadDatabaseUpdate(Reader, OutMessage);
+
+		case ServerTagIdentityToken:
+			OutMessage.Type = ESpaceTimeDBMessageType::IdentityToken;
+			OutMessage.Identity = ReadIdentity(Reader);
+			OutMessage.Token = Reader.ReadString();
+			return !Reader.IsError();
+
+		default:
+			return true;
+	}
+}
+
+bool FSpaceTimeDBProtocol::RedactIdentityToken(const uint8* Data, int32 Size, bool bBinary, TArray<uint8>& OutFrame)
+{
+	if (bBinary)
+	{
+		// Compression, tag, identity, then the token string; whatever follows is kept
+		constexpr int32 TokenOffset = 2 + FSpaceTimeDBIdentity::NumBytes;
+		if (Size < TokenOffset || Data[0] != CompressionNone || Data[1] != ServerTagIdentityToken)
+		{
+			return false;
+		}
+
+		FBsatnReader Reader(Data + TokenOffset, Size - TokenOffset);
+		Reader.ReadString();
+		if (Reader.IsError())
+		{
+			return false;
+		}
+
+		OutFrame.Reset();
+		FBsatnWriter Writer(OutFrame);
+		Writer.WriteRaw(Data, TokenOffset);
+		Writer.WriteU32(0);
+		Writer.WriteRaw(Data + Size - Reader.Remaining(), Reader.Remaining());
+		return true;
+	}
+
+	FUtf8JsonReader Reader(Data, Size);
+	if (!Reader.BeginObject())
+	{
+		return false;
+	}
+
+	// Transactions give themselves away at "type" or "updates", long before the end of the frame
+	int32 TokenStart = INDEX_NONE;
+	int32 TokenEnd = INDEX_NONE;
+	bool bIdentityToken = false;
+	uint32 Key = 0;
+	while (Reader.NextKey(Key))
+	{
+		if (Key == JsonKeyType)
+		{
+			if (Reader.ReadStringHash() != JsonTypeIdentityToken)
+			{
+				return false;
+			}
+			bIdentityToken = true;
+		}
+		else if (Key == JsonKeyUpdates)
+		{
+			return false;
+		}
+		else if (Key == JsonKeyToken)
+		{
+			TokenStart = Reader.Tell();
+			Reader.SkipValue();
+			TokenEnd = Reader.Tell();
+		}
+		else
+		{
+			Reader.SkipValue();
+		}
+	}
+	if (!bIdentityToken || TokenStart == INDEX_NONE || Reader.IsError())
+	{
+		return false;
+	}
+
+	OutFrame.Reset(Size);
+	OutFrame.Append(Data, TokenStart);
+	OutFrame.Append(reinterpret_cast<const uint8*>("\"\""), 2);
+	OutFrame.Append(Data + TokenEnd, Size - TokenEnd);
+	return true;
+}
+
+FString FSpaceTimeDBProtocol::PlayerRowToJson(const FSpaceTimeDBPlayerRow& Row)
+{
+	FString Out;
+	TSharedRef<FTypedJsonWriter> Writer = FTypedJsonWriterFactory::Create(&Out);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("table"), FSpaceTimeDBPlayerRow::TableName);
+	WriteJsonColumns(*Writer, Row);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return Out;
+}
+
+FString FSpaceTimeDBProtocol::InventoryRowToJson(const FSpaceTimeDBInventoryRow& Row)
+{
+	FString Out;
+	TSharedRef<FTypedJsonWriter> Writer = FTypedJsonWriterFactory::Create(&Out);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("table"), FSpaceTimeDBInventoryRow::TableName);
+	WriteJsonColumns(*Writer, Row);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return Out;
+}
@@ -0,0 +1,254 @@
+// Copyright 2026 tbassignana. MIT License.
+
+// Generated by Scripts/generate_spacetimedb_schema.py from Server/eonserver/src/lib.rs.
+// Do not edit; change the server tables and rerun the script.
+
+// Row decoders, included by SpaceTimeDBProtocol.cpp inside its anonymous namespace.
+// ReadRow reads BSATN columns in declaration order; ReadJsonField reads one JSON
+// column and skips unknown ones, so older clients tolerate new server columns.
+// WriteJsonColumns writes a row back out with the server's column names.
+
+void ReadRow(FBsatnReader& Reader, FSpaceTimeDBInstanceRow& Row)
+{
+	Row.InstanceId = Reader.ReadU64();
+	Row.Name = Reader.ReadString();
+	Row.MaxPlayers = Reader.ReadU32();
+	Row.bIsPublic = Reader.ReadBool();
+	Row.CreatedAtMicros = Reader.ReadI64();
+	Row.OwnerIdentity = ReadIdentity(Reader);
+}
+
+void ReadJsonField(FUtf8JsonReader& Reader, uint32 Key, FSpaceTimeDBInstanceRow& Row)
+{
+	switch (Key)
+	{
+		case FKey::HashKey("instance_id"): Row.InstanceId = Reader.ReadU64(); break;
+		case FKey::HashKey("name"): Row.Name = Reader.ReadString(); break;
+		case FKey::HashKey("max_players"): Row.MaxPlayers = Reader.ReadU32(); break;
+		case FKey::HashKey("is_public"): Row.bIsPublic = Reader.ReadBool(); break;
+		case FKey::HashKey("created_at"): Row.CreatedAtMicros = Reader.ReadI64(); break;
+		case FKey::HashKey("owner_identity"): Row.OwnerIdentity = Reader.ReadIdentity(); break;
+		default: Reader.SkipValue(); break;
+	}
+}
+
+void WriteJsonColumns(FTypedJsonWriter& Writer, const FSpaceTimeDBInstanceRow& Row)
+{
+	Writer.WriteValue(TEXT("instance_id"), static_cast<int64>(Row.InstanceId));
+	Writer.WriteValue(TEXT("name"), Row.Name);
+	Writer.WriteValue(TEXT("max_players"), static_cast<int64>(Row.MaxPlayers));
+	Writer.WriteValue(TEXT("is_public"), Row.bIsPublic);
+	Writer.WriteValue(TEXT("created_at"), Row.CreatedAtMicros);
+	Writer.WriteValue(TEXT("owner_identity"), Row.OwnerIdentity.ToHex());
+}
+
+void ReadRow(FBsatnReader& Reader, FSpaceTimeDBPlayerRow& Row)
+{
+	Row.Identity = ReadIdentity(Reader);
+	Row.Username = Reader.ReadString();
+	if (Reader.ReadU8() == OptionSome)
+	{
+		Row.InstanceId = Reader.ReadU64();
+	}
+	Row.Position.X = Reader.ReadF32();
+	Row.Position.Y = Reader.ReadF32();
+	Row.Position.Z = Reader.ReadF32();
+	Row.Rotation.Pitch = Reader.ReadF32();
+	Row.Rotation.Yaw = Reader.ReadF32();
+	Row.Rotation.Roll = Reader.ReadF32();
+	Row.Health = Reader.ReadF32();
+	Row.MaxHealth = Reader.ReadF32();
+	Row.bIsOnline = Reader.ReadBool();
+	Row.LastSeenMicros = Reader.ReadI64();
+}
+
+void ReadJsonField(FUtf8JsonReader& Reader, uint32 Key, FSpaceTimeDBPlayerRow& Row)
+{
+	switch (Key)
+	{
+		case FKey::HashKey("identity"): Row.Identity = Reader.ReadIdentity(); break;
+		case FKey::HashKey("username"): Row.Username = Reader.ReadString(); break;
+		case FKey::HashKey("instance_id"):
+			if (!Reader.TryReadNull())
+			{
+				Row.InstanceId = Reader.ReadU64();
+			}
+			break;
+		case FKey::HashKey("position_x"): Row.Position.X = Reader.ReadFloat(); break;
+		case FKey::HashKey("position_y"): Row.Position.Y = Reader.ReadFloat(); break;
+		case FKey::HashKey("position_z"): Row.Position.Z = Reader.ReadFloat(); break;
+		case FKey::HashKey("rotation_pitch"): Row.Rotation.Pitch = Reader.ReadFloat(); break;
+		case FKey::HashKey("rotation_yaw"): Row.Rotation.Yaw = Reader.ReadFloat(); break;
+		case FKey::HashKey("rotation_roll"): Row.Rotation.Roll = Reader.ReadFloat(); break;
+		case FKey::HashKey("health"): Row.Health = Reader.ReadFloat(); break;
+		case FKey::HashKey("max_health"): Row.MaxHealth = Reader.ReadFloat(); break;
+		case FKey::HashKey("is_online"): Row.bIsOnline = Reader.ReadBool(); break;
+		case FKey::HashKey("last_seen"): Row.LastSeenMicros = Reader.ReadI64(); break;
+		default: Reader.SkipValue(); break;
+	}
+}
+
+void WriteJsonColumns(FTypedJsonWriter& Writer, const FSpaceTimeDBPlayerRow& Row)
+{
+	Writer.WriteValue(TEXT("identity"), Row.Identity.ToHex());
+	Writer.WriteValue(TEXT("username"), Row.Username);
+	if (Row.InstanceId.IsSet())
+	{
+		Writer.WriteValue(TEXT("instance_id"), static_cast<int64>(Row.InstanceId.GetValue()));
+	}
+	Writer.WriteValue(TEXT("position_x"), Row.Position.X);
+	Writer.WriteValue(TEXT("position_y"), Row.Position.Y);
+	Writer.WriteValue(TEXT("position_z"), Row.Position.Z);
+	Writer.WriteValue(TEXT("rotation_pitch"), Row.Rotation.Pitch);
+	Writer.WriteValue(TEXT("rotation_yaw"), Row.Rotation.Yaw);
+	Writer.WriteValue(TEXT("rotation_roll"), Row.Rotation.Roll);
+	Writer.WriteValue(TEXT("health"), Row.Health);
+	Writer.WriteValue(TEXT("max_health"), Row.MaxHealth);
+	Writer.WriteValue(TEXT("is_online"), Row.bIsOnline);
+	Writer.WriteValue(TEXT("last_seen"), Row.LastSeenMicros);
+}
+
+void ReadRow(FBsatnReader& Reader, FSpaceTimeDBItemDefinitionRow& Row)
+{
+	Row.ItemId = Reader.ReadString();
+	Row.DisplayName = Reader.ReadString();
+	Row.Description = Reader.ReadString();
+	Row.ItemType = Reader.ReadString();
+	Row.MaxStack = Reader.ReadU32();
+	Row.IconPath = Reader.ReadString();
+	Row.bIsPremium = Reader.ReadBool();
+	Row.PremiumCurrencyPrice = Reader.ReadU32();
+	Row.bIsExclusive = Reader.ReadBool();
+	Row.Rarity = Reader.ReadU8();
+}
+
+void ReadJsonField(FUtf8JsonReader& Reader, uint32 Key, FSpaceTimeDBItemDefinitionRow& Row)
+{
+	switch (Key)
+	{
+		case FKey::HashKey("item_id"): Row.ItemId = Reader.ReadString(); break;
+		case FKey::HashKey("display_name"): Row.DisplayName = Reader.ReadString(); break;
+		case FKey::HashKey("description"): Row.Description = Reader.ReadString(); break;
+		case FKey::HashKey("item_type"): Row.ItemType = Reader.ReadString(); break;
+		case FKey::HashKey("max_stack"): Row.MaxStack = Reader.ReadU32(); break;
+		case FKey::HashKey("icon_path"): Row.IconPath = Reader.ReadString(); break;
+		case FKey::HashKey("is_premium"): Row.bIsPremium = Reader.ReadBool(); break;
+		case FKey::HashKey("premium_currency_price"): Row.PremiumCurrencyPrice = Reader.ReadU32(); break;
+		case FKey::HashKey("is_exclusive"): Row.bIsExclusive = Reader.ReadBool(); break;
+		case FKey::HashKey("rarity"): Row.Rarity = static_cast<uint8>(Reader.ReadU32()); break;
+		default: Reader.SkipValue(); break;
+	}
+}
+
+void WriteJsonColumns(FTypedJsonWriter& Writer, const FSpaceTimeDBItemDefinitionRow& Row)
+{
+	Writer.WriteValue(TEXT("item_id"), Row.ItemId);
+	Writer.WriteValue(TEXT("display_name"), Row.DisplayName);
+	Writer.WriteValue(TEXT("description"), Row.Description);
+	Writer.WriteValue(TEXT("item_type"), Row.ItemType);
+	Writer.WriteValue(TEXT("max_stack"), static_cast<int64>(Row.MaxStack));
+	Writer.WriteValue(TEXT("icon_path"), Row.IconPath);
+	Writer.WriteValue(TEXT("is_premium"), Row.bIsPremium);
+	Writer.WriteValue(TEXT("premium_currency_price"), static_cast<int64>(Row.PremiumCurrencyPrice));
+	Writer.WriteValue(TEXT("is_exclusive"), Row.bIsExclusive);
+	Writer.WriteValue(TEXT("rarity"), static_cast<int64>(Row.Rarity));
+}
+
+void ReadRow(FBsatnReader& Reader, FSpaceTimeDBInventoryRow& Row)
+{
+	Row.EntryId = Reader.ReadU64();
+	Row.OwnerIdentity = ReadIdentity(Reader);
+	Row.ItemId = Reader.ReadString();
+	Row.Quantity = Reader.ReadU32();
+	Row.SlotIndex = Reader.ReadU32();
+}
+
+void ReadJsonField(FUtf8JsonReader& Reader, uint32 Key, FSpaceTimeDBInventoryRow& Row)
+{
+	switch (Key)
+	{
+		case FKey::HashKey("entry_id"): Row.EntryId = Reader.ReadU64(); break;
+		case FKey::HashKey("owner_identity"): Row.OwnerIdentity = Reader.ReadIdentity(); break;
+		case FKey::HashKey("item_id"): Row.ItemId = Reader.ReadString(); break;
+		case FKey::HashKey("quantity"): Row.Quantity = Reader.ReadU32(); break;
+		case FKey::HashKey("slot_index"): Row.SlotIndex = Reader.ReadU32(); break;
+		default: Reader.SkipValue(); break;
+	}
+}
+
+void WriteJsonColumns(FTypedJsonWriter& Writer, const FSpaceTimeDBInventoryRow& Row)
+{
+	Writer.WriteValue(TEXT("entry_id"), static_cast<int64>(Row.EntryId));
+	Writer.WriteValue(TEXT("owner_identity"), Row.OwnerIdentity.ToHex());
+	Writer.WriteValue(TEXT("item_id"), Row.ItemId);
+	Writer.WriteValue(TEXT("quantity"), static_cast<int64>(Row.Quantity));
+	Writer.WriteValue(TEXT("slot_index"), static_cast<int64>(Row.SlotIndex));
+}
+
+void ReadRow(FBsatnReader& Reader, FSpaceTimeDBWorldItemRow& Row)
+{
+	Row.WorldItemId = Reader.ReadU64();
+	Row.InstanceId = Reader.ReadU64();
+	Row.ItemId = Reader.ReadString();
+	Row.Quantity = Reader.ReadU32();
+	Row.Position.X = Reader.ReadF32();
+	Row.Position.Y = Reader.ReadF32();
+	Row.Position.Z = Reader.ReadF32();
+	Row.bIsCollected = Reader.ReadBool();
+}
+
+void ReadJsonField(FUtf8JsonReader& Reader, uint32 Key, FSpaceTimeDBWorldItemRow& Row)
+{
+	switch (Key)
+	{
+		case FKey::HashKey("world_item_id"): Row.WorldItemId = Reader.ReadU64(); break;
+		case FKey::HashKey("instance_id"): Row.InstanceId = Reader.ReadU64(); break;
+		case FKey::HashKey("item_id"): Row.ItemId = Reader.ReadString(); break;
+		case FKey::HashKey("quantity"): Row.Quantity = Reader.ReadU32(); break;
+		case FKey::HashKey("position_x"): Row.Position.X = Reader.ReadFloat(); break;
+		case FKey::HashKey("position_y"): Row.Position.Y = Reader.ReadFloat(); break;
+		case FKey::HashKey("position_z"): Row.Position.Z = Reader.ReadFloat(); break;
+		case FKey::HashKey("is_collected"): Row.bIsCollected = Reader.ReadBool(); break;
+		default: Reader.SkipValue(); break;
+	}
+}
+
+void WriteJsonColumns(FTypedJsonWriter& Writer, const FSpaceTimeDBWorldItemRow& Row)
+{
+	Writer.WriteValue(TEXT("world_item_id"), static_cast<int64>(Row.WorldItemId));
+	Writer.WriteValue(TEXT("instance_id"), static_cast<int64>(Row.InstanceId));
+	Writer.WriteValue(TEXT("item_id"), Row.ItemId);
+	Writer.WriteValue(TEXT("quantity"), static_cast<int64>(Row.Quantity));
+	Writer.WriteValue(TEXT("position_x"), Row.Position.X);
+	Writer.WriteValue(TEXT("position_y"), Row.Position.Y);
+	Writer.WriteValue(TEXT("position_z"), Row.Position.Z);
+	Writer.WriteValue(TEXT("is_collected"), Row.bIsCollected);
+}
+
+void ReadRow(FBsatnReader& Reader, FSpaceTimeDBInteractableRow& Row)
+{
+	Row.InteractableId = Reader.ReadString();
+	Row.InstanceId = Reader.ReadU64();
+	Row.bIsActive = Reader.ReadBool();
+	Row.StateData = Reader.ReadString();
+}
+
+void ReadJsonField(FUtf8JsonReader& Reader, uint32 Key, FSpaceTimeDBInteractableRow& Row)
+{
+	switch (Key)
+	{
+		case FKey::HashKey("interactable_id"): Row.InteractableId = Reader.ReadString(); break;
+		case FKey::HashKey("instance_id"): Row.InstanceId = Reader.ReadU64(); break;
+		case FKey::HashKey("is_active"): Row.bIsActive = Reader.ReadBool(); break;
+		case FKey::HashKey("state_data"): Row.StateData = Reader.ReadString(); break;
+		default: Reader.SkipValue(); break;
+	}
+}
+
+void WriteJsonColumns(FTypedJsonWriter& Writer, const FSpaceTimeDBInteractableRow& Row)
+{
+	Writer.WriteValue(TEXT("interactable_id"), Row.InteractableId);
+	Writer.WriteValue(TEXT("instance_id"), static_cast<int64>(Row.InstanceId));
+	Writer.WriteValue(TEXT("is_active"), Row.bIsActive);
+	Writer.WriteValue(TEXT("state_data"), Row.StateData);
+}
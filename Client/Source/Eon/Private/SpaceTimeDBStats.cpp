@@ -0,0 +1,36 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBStats.h"
+
+const float FSpaceTimeDBDecodeHistogram::BucketBoundsMicros[NumBuckets] = { 50.0f, 100.0f, 250.0f, 500.0f, 1000.0f, 2500.0f, 5000.0f, MAX_flt };
+
+void FSpaceTimeDBDecodeHistogram::Record(double Seconds)
+{
+	const float Micros = static_cast<float>(Seconds * 1000000.0);
+
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && Micros > BucketBoundsMicros[Bucket])
+	{
+		++Bucket;
+	}
+	Counts[Bucket].fetch_add(1, std::memory_order_relaxed);
+	TotalMicros.fetch_add(static_cast<uint64>(Micros), std::memory_order_relaxed);
+}
+
+void FSpaceTimeDBDecodeHistogram::Snapshot(TArray<int32>& OutCounts) const
+{
+	OutCounts.SetNum(NumBuckets);
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		OutCounts[i] = static_cast<int32>(Counts[i].load(std::memory_order_relaxed));
+	}
+}
+
+void FSpaceTimeDBDecodeHistogram::Reset()
+{
+	for (std::atomic<uint32>& Count : Counts)
+	{
+		Count.store(0, std::memory_order_relaxed);
+	}
+	TotalMicros.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,52 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBSubscriptions.h"
+
+TArray<FString> FSpaceTimeDBSubscriptions::BuildQueries() const
+{
+	TArray<FString> Queries;
+	Queries.Add(TEXT("SELECT * FROM instance WHERE is_public = true"));
+	// Display names, stack limits and rarity for every item id the other tables reference
+	Queries.Add(TEXT("SELECT * FROM item_definition"));
+
+	if (Identity.IsValid())
+	{
+		// Our own player row is always needed: its instance_id tells us when a join/leave completed
+		const FString IdentityHex = Identity.ToHex();
+		Queries.Add(FString::Printf(TEXT("SELECT * FROM player WHERE identity = 0x%s"), *IdentityHex));
+		Queries.Add(FString::Printf(TEXT("SELECT * FROM inventory_item WHERE owner_identity = 0x%s"), *IdentityHex));
+	}
+
+	if (InstanceId.IsSet())
+	{
+		const uint64 Id = InstanceId.GetValue();
+		Queries.Add(FString::Printf(TEXT("SELECT * FROM player WHERE instance_id = %llu"), Id));
+		Queries.Add(FString::Printf(TEXT("SELECT * FROM world_item WHERE instance_id = %llu"), Id));
+		Queries.Add(FString::Printf(TEXT("SELECT * FROM interactable_state WHERE instance_id = %llu"), Id));
+	}
+
+	return Queries;
+}
+
+bool FSpaceTimeDBSubscriptions::Diff(TArray<FString>& OutAdded, TArray<FString>& OutRemoved) const
+{
+	const TArray<FString> Desired = BuildQueries();
+
+	for (const FString& Query : Desired)
+	{
+		if (!ActiveQueries.Contains(Query))
+		{
+			OutAdded.Add(Query);
+		}
+	}
+
+	for (const FString& Query : ActiveQueries)
+	{
+		if (!Desired.Contains(Query))
+		{
+			OutRemoved.Add(Query);
+		}
+	}
+
+	return OutAdded.Num() > 0 || OutRemoved.Num() > 0;
+}
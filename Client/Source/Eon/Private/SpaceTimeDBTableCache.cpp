@@ -0,0 +1,274 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBTableCache.h"
+#include "SpaceTimeDBManager.h"
+#include "SpaceTimeDBStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Cache Apply"), STAT_EonNetCacheApply, STATGROUP_EonNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Cache Applies"), STAT_EonNetPendingApplies, STATGROUP_EonNet);
+
+namespace
+{
+	// Tables in the order a queued message applies them
+	constexpr int32 NumCachedTables = 6;
+
+	// Rows applied between clock reads
+	constexpr int32 RowsPerDeadlineCheck = 16;
+
+	int32 CountRows(const FSpaceTimeDBServerMessage& Message)
+	{
+		return Message.Players.Num() + Message.InventoryItems.Num() + Message.Instances.Num() +
+			Message.WorldItems.Num() + Message.Interactables.Num() + Message.ItemDefinitions.Num();
+	}
+}
+
+template <typename RowType>
+void USpaceTimeDBTableCache::ApplyTable(TSpaceTimeDBTable<RowType>& Table, const TArray<TSpaceTimeDBRowUpdate<RowType>>& Updates, bool bSnapshot)
+{
+	if (bSnapshot)
+	{
+		Table.ApplySnapshot(Updates);
+		return;
+	}
+
+	for (const TSpaceTimeDBRowUpdate<RowType>& Update : Updates)
+	{
+		Table.Apply(Update);
+	}
+}
+
+template <typename RowType>
+bool USpaceTimeDBTableCache::ApplyTableSlice(TSpaceTimeDBTable<RowType>& Table, const TArray<TSpaceTimeDBRowUpdate<RowType>>& Updates, bool bSnapshot, int32& RowIndex, double Deadline)
+{
+	if (bSnapshot && RowIndex == 0)
+	{
+		Table.RemoveMissing(Updates);
+	}
+
+	while (RowIndex < Updates.Num())
+	{
+		const int32 End = FMath::Min(RowIndex + RowsPerDeadlineCheck, Updates.Num());
+		for (; RowIndex < End; ++RowIndex)
+		{
+			Table.Apply(Updates[RowIndex]);
+		}
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
+	return RowIndex >= Updates.Num();
+}
+
+void USpaceTimeDBTableCache::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Manager = Collection.InitializeDependency<USpaceTimeDBManager>();
+	if (Manager.IsValid())
+	{
+		ServerMessageHandle = Manager->OnServerMessage.AddUObject(this, &USpaceTimeDBTableCache::ApplyServerMessage);
+		InstanceChangedHandle = Manager->OnInstanceChanged.AddUObject(this, &USpaceTimeDBTableCache::HandleInstanceChanged);
+	}
+}
+
+void USpaceTimeDBTableCache::Deinitialize()
+{
+	if (Manager.IsValid())
+	{
+		Manager->OnServerMessage.Remove(ServerMessageHandle);
+		Manager->OnInstanceChanged.Remove(InstanceChangedHandle);
+	}
+	Reset();
+	Super::Deinitialize();
+}
+
+bool USpaceTimeDBTableCache::IsInteractableActive(const FString& InteractableId) const
+{
+	const FSpaceTimeDBInteractableRow* Row = InteractableTable.Find(InteractableId);
+	return Row && Row->bIsActive;
+}
+
+void USpaceTimeDBTableCache::Reset()
+{
+	PlayerTable.Reset();
+	InventoryTable.Reset();
+	InstanceTable.Reset();
+	WorldItemTable.Reset();
+	InteractableTable.Reset();
+	ItemDefinitionTable.Reset();
+	PendingApplies.Reset();
+	SET_DWORD_STAT(STAT_EonNetPendingApplies, 0);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(ApplyTickerHandle);
+	ApplyTickerHandle.Reset();
+}
+
+void USpaceTimeDBTableCache::SetApplyBudget(float BudgetMs, int32 InMinRowsToTimeSlice)
+{
+	ApplyBudgetMs = FMath::Max(BudgetMs, 0.0f);
+	MinRowsToTimeSlice = FMath::Max(InMinRowsToTimeSlice, 0);
+	DeadlineFrame = MAX_uint64;
+}
+
+void USpaceTimeDBTableCache::ApplyServerMessage(const FSpaceTimeDBServerMessage& Message)
+{
+	if (Message.Type != ESpaceTimeDBMessageType::InitialSubscription &&
+		Message.Type != ESpaceTimeDBMessageType::TransactionUpdate)
+	{
+		return;
+	}
+
+	// A subscription replaces the whole query set, so its initial rows are the complete table contents
+	const bool bSnapshot = Message.Type == ESpaceTimeDBMessageType::InitialSubscription;
+
+	// Small batches apply on arrival, unless they would overtake a queued one
+	if (PendingApplies.Num() == 0 && (ApplyBudgetMs <= 0.0f || CountRows(Message) < MinRowsToTimeSlice))
+	{
+		SCOPE_CYCLE_COUNTER(STAT_EonNetCacheApply);
+		ApplyTable(PlayerTable, Message.Players, bSnapshot);
+		ApplyTable(InventoryTable, Message.InventoryItems, bSnapshot);
+		ApplyTable(InstanceTable, Message.Instances, bSnapshot);
+		ApplyTable(WorldItemTable, Message.WorldItems, bSnapshot);
+		ApplyTable(InteractableTable, Message.Interactables, bSnapshot);
+		ApplyTable(ItemDefinitionTable, Message.ItemDefinitions, bSnapshot);
+		FinishMessage(bSnapshot);
+		return;
+	}
+
+	FPendingApply& Pending = PendingApplies.AddDefaulted_GetRef();
+	Pending.Message = Message;
+	Pending.bSnapshot = bSnapshot;
+
+	if (!ApplyTickerHandle.IsValid())
+	{
+		ApplyTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &USpaceTimeDBTableCache::TickPendingUpdates));
+	}
+
+	// Spend what is left of this frame's budget right away; several large
+	// messages in one frame must not each get a budget of their own
+	if (DeadlineFrame != GFrameCounter || FPlatformTime::Seconds() < FrameDeadline)
+	{
+		ProcessPendingUpdates();
+	}
+}
+
+double USpaceTimeDBTableCache::GetFrameDeadline()
+{
+	if (DeadlineFrame != GFrameCounter)
+	{
+		DeadlineFrame = GFrameCounter;
+		FrameDeadline = FPlatformTime::Seconds() + ApplyBudgetMs / 1000.0;
+	}
+	return FrameDeadline;
+}
+
+void USpaceTimeDBTableCache::ProcessPendingUpdates()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EonNetCacheApply);
+
+	const double Deadline = GetFrameDeadline();
+	while (PendingApplies.Num() > 0)
+	{
+		FPendingApply& Pending = PendingApplies[0];
+		if (Pending.bInstanceChange)
+		{
+			const TOptional<uint64> InstanceId = Pending.InstanceId;
+			PendingApplies.RemoveAt(0);
+			PurgeOtherInstances(InstanceId);
+		}
+		else if (ApplyPendingSlice(Pending, Deadline))
+		{
+			const bool bSnapshot = Pending.bSnapshot;
+			PendingApplies.RemoveAt(0);
+			FinishMessage(bSnapshot);
+		}
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_EonNetPendingApplies, PendingApplies.Num());
+}
+
+bool USpaceTimeDBTableCache::ApplyPendingSlice(FPendingApply& Pending, double Deadline)
+{
+	const FSpaceTimeDBServerMessage& Message = Pending.Message;
+	for (; Pending.TableIndex < NumCachedTables; ++Pending.TableIndex, Pending.RowIndex = 0)
+	{
+		bool bTableDone = true;
+		switch (Pending.TableIndex)
+		{
+		case 0: bTableDone = ApplyTableSlice(PlayerTable, Message.Players, Pending.bSnapshot, Pending.RowIndex, Deadline); break;
+		case 1: bTableDone = ApplyTableSlice(InventoryTable, Message.InventoryItems, Pending.bSnapshot, Pending.RowIndex, Deadline); break;
+		case 2: bTableDone = ApplyTableSlice(InstanceTable, Message.Instances, Pending.bSnapshot, Pending.RowIndex, Deadline); break;
+		case 3: bTableDone = ApplyTableSlice(WorldItemTable, Message.WorldItems, Pending.bSnapshot, Pending.RowIndex, Deadline); break;
+		case 4: bTableDone = ApplyTableSlice(InteractableTable, Message.Interactables, Pending.bSnapshot, Pending.RowIndex, Deadline); break;
+		case 5: bTableDone = ApplyTableSlice(ItemDefinitionTable, Message.ItemDefinitions, Pending.bSnapshot, Pending.RowIndex, Deadline); break;
+		default: break;
+		}
+
+		if (!bTableDone)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void USpaceTimeDBTableCache::FinishMessage(bool bSnapshot)
+{
+	OnCacheUpdated.Broadcast();
+	if (bSnapshot)
+	{
+		OnSnapshotComplete.Broadcast();
+	}
+}
+
+bool USpaceTimeDBTableCache::TickPendingUpdates(float DeltaTime)
+{
+	ProcessPendingUpdates();
+	if (PendingApplies.Num() > 0)
+	{
+		return true;
+	}
+
+	ApplyTickerHandle.Reset();
+	return false;
+}
+
+void USpaceTimeDBTableCache::HandleInstanceChanged(TOptional<uint64> InstanceId)
+{
+	// Rows still queued may belong to the old instance, so purge after them
+	if (PendingApplies.Num() > 0)
+	{
+		FPendingApply& Pending = PendingApplies.AddDefaulted_GetRef();
+		Pending.bInstanceChange = true;
+		Pending.InstanceId = InstanceId;
+		return;
+	}
+
+	PurgeOtherInstances(InstanceId);
+}
+
+void USpaceTimeDBTableCache::PurgeOtherInstances(TOptional<uint64> InstanceId)
+{
+	// The new subscription's snapshot only covers the new instance; rows from the
+	// old one would otherwise linger (the JSON protocol has no snapshot at all).
+	const FSpaceTimeDBIdentity OwnIdentity = Manager.IsValid() ? Manager->GetIdentity() : FSpaceTimeDBIdentity();
+	auto IsOtherInstance = [&InstanceId](uint64 RowInstanceId) { return !InstanceId.IsSet() || RowInstanceId != InstanceId.GetValue(); };
+
+	const int32 Removed =
+		PlayerTable.RemoveWhere([&](const FSpaceTimeDBPlayerRow& Row) { return Row.Identity != OwnIdentity && (!Row.InstanceId.IsSet() || IsOtherInstance(Row.InstanceId.GetValue())); }) +
+		WorldItemTable.RemoveWhere([&](const FSpaceTimeDBWorldItemRow& Row) { return IsOtherInstance(Row.InstanceId); }) +
+		InteractableTable.RemoveWhere([&](const FSpaceTimeDBInteractableRow& Row) { return IsOtherInstance(Row.InstanceId); });
+
+	if (Removed > 0)
+	{
+		OnCacheUpdated.Broadcast();
+	}
+}
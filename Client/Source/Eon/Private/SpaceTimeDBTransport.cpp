@@ -0,0 +1,179 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#include "SpaceTimeDBTransport.h"
+#include "WebSocketsModule.h"
+#include "IWebSocket.h"
+
+// ============================================================================
+// WEBSOCKET
+// ============================================================================
+
+FSpaceTimeDBWebSocketTransport::FSpaceTimeDBWebSocketTransport(const FSpaceTimeDBTransportParams& Params)
+{
+	WebSocket = FWebSocketsModule::Get().CreateWebSocket(Params.Url, Params.Subprotocol, Params.UpgradeHeaders);
+
+	WebSocket->OnConnected().AddLambda([this]()
+	{
+		OnConnected.ExecuteIfBound();
+	});
+
+	WebSocket->OnConnectionError().AddLambda([this](const FString& Error)
+	{
+		OnConnectionError.ExecuteIfBound(Error);
+	});
+
+	WebSocket->OnClosed().AddLambda([this](int32 StatusCode, const FString& Reason, bool bWasClean)
+	{
+		OnClosed.ExecuteIfBound(StatusCode, Reason, bWasClean);
+	});
+
+	// Text frames are taken as raw UTF-8 so they never go through FString; OnMessage stays unbound
+	WebSocket->OnRawMessage().AddLambda([this](const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
+	{
+		TextReceiveBuffer.Append(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+		if (BytesRemaining > 0)
+		{
+			return;
+		}
+
+		OnFrame.ExecuteIfBound(TextReceiveBuffer, false);
+		TextReceiveBuffer.Reset();
+	});
+
+	WebSocket->OnBinaryMessage().AddLambda([this](const void* Data, SIZE_T Size, bool bIsLastFragment)
+	{
+		BinaryReceiveBuffer.Append(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+		if (!bIsLastFragment)
+		{
+			return;
+		}
+
+		OnFrame.ExecuteIfBound(BinaryReceiveBuffer, true);
+		BinaryReceiveBuffer.Reset();
+	});
+}
+
+FSpaceTimeDBWebSocketTransport::~FSpaceTimeDBWebSocketTransport()
+{
+	// The socket's lambdas capture this; nothing may reach them once we are gone
+	WebSocket->OnConnected().Clear();
+	WebSocket->OnConnectionError().Clear();
+	WebSocket->OnClosed().Clear();
+	WebSocket->OnRawMessage().Clear();
+	WebSocket->OnBinaryMessage().Clear();
+	WebSocket->Close();
+}
+
+void FSpaceTimeDBWebSocketTransport::Connect()
+{
+	WebSocket->Connect();
+}
+
+void FSpaceTimeDBWebSocketTransport::Close()
+{
+	WebSocket->Close();
+}
+
+bool FSpaceTimeDBWebSocketTransport::IsConnected() const
+{
+	return WebSocket->IsConnected();
+}
+
+void FSpaceTimeDBWebSocketTransport::SendText(const FString& Text)
+{
+	WebSocket->Send(Text);
+}
+
+void FSpaceTimeDBWebSocketTransport::SendBinary(const uint8* Data, int32 Size)
+{
+	WebSocket->Send(Data, Size, true);
+}
+
+// ============================================================================
+// LOOPBACK
+// ============================================================================
+
+void FSpaceTimeDBLoopbackTransport::Connect()
+{
+	if (!bAcceptConnections)
+	{
+		OnConnectionError.ExecuteIfBound(TEXT("Loopback is not accepting connections"));
+		return;
+	}
+
+	bConnected = true;
+	OnConnected.ExecuteIfBound();
+}
+
+void FSpaceTimeDBLoopbackTransport::Close()
+{
+	if (!bConnected)
+	{
+		return;
+	}
+
+	// Client-initiated closes are clean, as with a WebSocket close handshake
+	bConnected = false;
+	OnClosed.ExecuteIfBound(1000, TEXT("Closed by client"), true);
+}
+
+void FSpaceTimeDBLoopbackTransport::SendText(const FString& Text)
+{
+	if (!bConnected)
+	{
+		return;
+	}
+
+	FTCHARToUTF8 Utf8(*Text, Text.Len());
+	DeliverToServer(TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), false);
+}
+
+void FSpaceTimeDBLoopbackTransport::SendBinary(const uint8* Data, int32 Size)
+{
+	if (!bConnected)
+	{
+		return;
+	}
+
+	DeliverToServer(TArray<uint8>(Data, Size), true);
+}
+
+void FSpaceTimeDBLoopbackTransport::DeliverToServer(TArray<uint8>&& Bytes, bool bBinary)
+{
+	if (OnClientFrame.IsBound())
+	{
+		OnClientFrame.Execute(Bytes, bBinary);
+		return;
+	}
+
+	FFrame& Frame = ClientFrames.AddDefaulted_GetRef();
+	Frame.Bytes = MoveTemp(Bytes);
+	Frame.bBinary = bBinary;
+}
+
+void FSpaceTimeDBLoopbackTransport::ServerSend(TArray<uint8> Bytes, bool bBinary)
+{
+	if (!bConnected)
+	{
+		return;
+	}
+
+	OnFrame.ExecuteIfBound(Bytes, bBinary);
+}
+
+void FSpaceTimeDBLoopbackTransport::ServerSendText(const FString& Text)
+{
+	FTCHARToUTF8 Utf8(*Text, Text.Len());
+	ServerSend(TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), false);
+}
+
+void FSpaceTimeDBLoopbackTransport::ServerClose(const FString& Reason, bool bWasClean)
+{
+	if (!bConnected)
+	{
+		return;
+	}
+
+	bConnected = false;
+	OnClosed.ExecuteIfBound(bWasClean ? 1000 : 1006, Reason, bWasClean);
+}
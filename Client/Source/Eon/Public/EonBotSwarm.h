@@ -0,0 +1,151 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+#include "SpaceTimeDBManager.h"
+
+class UGameInstance;
+
+// Builds the transport for one bot; lets tests stand in for the server
+using FEonBotTransportFactory = TFunction<TSharedRef<ISpaceTimeDBTransport>(int32 BotIndex, const FSpaceTimeDBTransportParams&)>;
+
+struct EON_API FEonBotSwarmConfig
+{
+	int32 NumBots = 100;
+
+	// Host, module, protocol and batching for every bot. The network thread
+	// is always off: bots are ticked from one thread.
+	FSpaceTimeDBConfig Connection;
+
+	// Instance to join. When 0, bot 0 creates a public instance named
+	// InstanceName with room for every bot, and the rest join it once its row arrives.
+	uint64 InstanceId = 0;
+	FString InstanceName = TEXT("botswarm");
+
+	// update_player_position calls per bot per second
+	float PositionHz = 10.0f;
+	// Seconds between inventory / interactable operations per bot; 0 disables them
+	float ActionInterval = 2.0f;
+	// Bots connect this many per second, so the server sees a ramp rather than a stampede
+	float ConnectsPerSecond = 50.0f;
+	// Seconds before a join that has not taken effect is sent again
+	float JoinRetrySeconds = 5.0f;
+
+	int32 Seed = 1;
+};
+
+// Aggregate over an interval. Transactions are reducer calls the server
+// committed and answered, counted from the TransactionUpdates carrying our
+// request ids, so they measure server throughput as the clients see it.
+// Per-client figures are means over bots that were connected.
+struct EON_API FEonBotSwarmReport
+{
+	double Seconds = 0.0;
+	int32 NumBots = 0;
+	int32 NumConnected = 0;
+	int32 NumInInstance = 0;
+
+	double CallsPerSecond = 0.0;
+	double TransactionsPerSecond = 0.0;
+	double MeanRttMs = 0.0;
+	double MaxRttMs = 0.0;
+
+	// Receive fan-out: what each client has to take in for everyone else's traffic
+	double MessagesInPerClientPerSecond = 0.0;
+	double PlayerRowsPerClientPerSecond = 0.0;
+	double BytesInPerClientPerSecond = 0.0;
+
+	// Decode cost: game-thread time per client per second, and per message
+	double DecodeMsPerClientPerSecond = 0.0;
+	double DecodeMicrosPerMessage = 0.0;
+
+	FString ToString() const;
+};
+
+// Many lightweight clients in one process, for load testing a SpaceTimeDB
+// module. Each bot is its own USpaceTimeDBManager and connection. A bot
+// registers, joins the swarm's instance, then streams position updates in a
+// circle and periodically adds and uses consumables and toggles interactables.
+// Drive it with Tick() from the game thread; managers also need the core
+// ticker to run, as UEonBotSwarmCommandlet does.
+class EON_API FEonBotSwarm
+{
+public:
+	explicit FEonBotSwarm(const FEonBotSwarmConfig& InConfig);
+	~FEonBotSwarm();
+
+	// Before Start(); bots connect through the websocket transport otherwise
+	void SetTransportFactory(FEonBotTransportFactory InFactory) { TransportFactory = MoveTemp(InFactory); }
+
+	void Start();
+	void Stop();
+	void Tick(float DeltaTime);
+
+	// Totals since the previous call (or Start), then starts a new interval
+	FEonBotSwarmReport TakeIntervalReport();
+	// Totals since Start
+	FEonBotSwarmReport GetTotalReport() const;
+
+	int32 GetNumBots() const { return Bots.Num(); }
+	USpaceTimeDBManager* GetManager(int32 BotIndex) const { return Bots.IsValidIndex(BotIndex) ? Bots[BotIndex].Manager.Get() : nullptr; }
+	TOptional<uint64> GetTargetInstance() const { return TargetInstance; }
+
+private:
+	enum class EBotState : uint8
+	{
+		Idle,
+		Connecting,
+		Joining,
+		Running
+	};
+
+	struct FBot
+	{
+		TStrongObjectPtr<USpaceTimeDBManager> Manager;
+		EBotState State = EBotState::Idle;
+		double StateSince = 0.0;
+		double NextPositionAt = 0.0;
+		double NextActionAt = 0.0;
+		int32 NumActions = 0;
+		float Phase = 0.0f;
+		// Our consumables that can be used
+		TArray<uint64> Consumables;
+	};
+
+	// Sums over every bot since Start
+	struct FTotals
+	{
+		double Seconds = 0.0;
+		int64 Calls = 0;
+		int64 Transactions = 0;
+		int64 MessagesIn = 0;
+		int64 BytesIn = 0;
+		int64 PlayerRows = 0;
+		double DecodeMs = 0.0;
+	};
+
+	void ConnectBot(int32 BotIndex);
+	void TickBot(int32 BotIndex);
+	// Bound per manager with the bot's index as payload
+	void HandleServerMessage(const FSpaceTimeDBServerMessage& Message, int32 BotIndex);
+	FTotals GatherTotals() const;
+	FEonBotSwarmReport MakeReport(const FTotals& From, const FTotals& To) const;
+
+	FEonBotSwarmConfig Config;
+	FEonBotTransportFactory TransportFactory;
+	TStrongObjectPtr<UGameInstance> GameInstance;
+	TArray<FBot> Bots;
+	FRandomStream Random;
+
+	TOptional<uint64> TargetInstance;
+	bool bCreatedInstance = false;
+	TArray<FString> Interactables;
+
+	double Now = 0.0;
+	double ConnectBudget = 0.0;
+	int32 NextBotToConnect = 0;
+	int64 CallsIssued = 0;
+	FTotals IntervalStart;
+};
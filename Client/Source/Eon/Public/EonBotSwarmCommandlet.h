@@ -0,0 +1,36 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EonBotSwarmCommandlet.generated.h"
+
+/**
+ * Runs FEonBotSwarm headless against a SpaceTimeDB server and logs its reports.
+ *
+ * UnrealEditor-Cmd Eon.uproject -run=EonBotSwarm -Bots=200 -Seconds=120
+ *   -Bots=N            simulated clients (default 100)
+ *   -Seconds=N         run length (default 60)
+ *   -Host= -Module=    server and module (default: the manager's defaults)
+ *   -Binary            BSATN instead of JSON
+ *   -Instance=ID       join an existing instance instead of creating one
+ *   -InstanceName=S    name of the instance to create / look for
+ *   -PositionHz=N      position updates per bot per second (default 10)
+ *   -ActionInterval=N  seconds between inventory / interactable operations (default 2)
+ *   -ConnectRate=N     new connections per second (default 50)
+ *   -ReportInterval=N  seconds between interval reports (default 5)
+ *   -NetProfile=NAME   network simulation profile for every bot (see Eon.NetSim.Profile)
+ *
+ * Returns non-zero when the server committed no transactions.
+ */
+UCLASS()
+class EON_API UEonBotSwarmCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEonBotSwarmCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,66 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Where other clients show a player between position updates: moving on at
+// the velocity of its last two samples, for a short while. Receivers
+// (UPlayerSyncComponent) run it on player rows; the sender runs it on what it
+// sent, to know what the others are showing. Both sides must agree, so times
+// are server seconds since the Unix epoch: a row's last_seen, or
+// USpaceTimeDBManager::GetServerTime() when sending. Samples without a time are held.
+class EON_API FEonDeadReckoning
+{
+public:
+	// Samples further apart than this give no velocity, e.g. the first step after standing still
+	static constexpr double MaxVelocityGapSeconds = 1.0;
+	// Extrapolation stops this long after the last sample, so a lost or
+	// suppressed stop never carries a player off
+	static constexpr double MaxExtrapolationSeconds = 0.5;
+
+	// Samples no newer than the last one are ignored
+	void AddSample(const FVector& InPosition, const FRotator& InRotation, double InTime);
+	void Reset() { *this = FEonDeadReckoning(); }
+
+	bool HasSample() const { return bHasSample; }
+	FVector PredictLocation(double Now) const;
+	const FRotator& GetRotation() const { return Rotation; }
+	const FVector& GetVelocity() const { return Velocity; }
+
+private:
+	FVector Position = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	double Time = 0.0;
+	bool bHasSample = false;
+};
+
+// Decides which of the local player's periodic position samples are worth a
+// reducer call: those where the others' dead reckoning has drifted past a
+// tolerance, and one per keepalive interval so an idle player's row stays fresh.
+class EON_API FEonPositionSyncGate
+{
+public:
+	// Centimetres
+	float PositionTolerance = 10.0f;
+	// Degrees, on any axis
+	float RotationTolerance = 5.0f;
+	// Seconds; 0 sends only on error
+	double KeepaliveInterval = 2.0;
+
+	// True if this sample should be sent; it is then what the others extrapolate from
+	bool ShouldSend(const FVector& Position, const FRotator& Rotation, double Time);
+
+	// The others know nothing of us (e.g. after a reconnect): the next sample goes out
+	void Reset() { Remote.Reset(); }
+
+	int32 GetNumSent() const { return NumSent; }
+	int32 GetNumSuppressed() const { return NumSuppressed; }
+
+private:
+	FEonDeadReckoning Remote;
+	double LastSendTime = 0.0;
+	int32 NumSent = 0;
+	int32 NumSuppressed = 0;
+};
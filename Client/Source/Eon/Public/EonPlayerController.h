@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "EonDeadReckoning.h"
 #include "EonPlayerController.generated.h"
 
 class USpaceTimeDBManager;
@@ -42,6 +43,14 @@ public:
 	UFUNCTION(Exec, BlueprintCallable, Category = "Debug")
 	void ListInventory();
 
+	// Position samples sent to the server, and those skipped because the
+	// other clients' extrapolation was still close enough
+	UFUNCTION(BlueprintCallable, Category = "Sync")
+	int32 GetPositionUpdatesSent() const { return PositionSyncGate.GetNumSent(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Sync")
+	int32 GetPositionUpdatesSuppressed() const { return PositionSyncGate.GetNumSuppressed(); }
+
 protected:
 	virtual void SetupInputComponent() override;
 
@@ -49,9 +58,25 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "SpaceTimeDB")
 	bool bEnableSpaceTimeDB = true; // Server deployed to maincloud.spacetimedb.com/eon
 
+	// Run inventory and world reducers in process (solo instances); always on when SpaceTimeDB is disabled
+	UPROPERTY(EditDefaultsOnly, Category = "SpaceTimeDB")
+	bool bSoloLocalAuthority = false;
+
 	// Position sync settings
 	UPROPERTY(EditDefaultsOnly, Category = "Sync")
-	float PositionSyncInterval = 0.1f; // 10 Hz update rate
+	float PositionSyncInterval = 0.1f; // 10 Hz sample rate
+
+	// A sample is only sent once what other clients extrapolate is this far off (cm)
+	UPROPERTY(EditDefaultsOnly, Category = "Sync")
+	float PositionSyncTolerance = 10.0f;
+
+	// ... or the rotation is this far off on any axis (degrees)
+	UPROPERTY(EditDefaultsOnly, Category = "Sync")
+	float RotationSyncTolerance = 5.0f;
+
+	// Seconds between updates of a player standing still; 0 sends none
+	UPROPERTY(EditDefaultsOnly, Category = "Sync")
+	float PositionKeepaliveInterval = 2.0f;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Mobile")
 	bool bIsMobileDevice = false;
@@ -64,6 +89,7 @@ private:
 	void OnSpaceTimeDBConnected();
 
 	float LastSyncTime = 0.0f;
+	FEonPositionSyncGate PositionSyncGate;
 
 	UPROPERTY()
 	UEonHUD* EonHUD;
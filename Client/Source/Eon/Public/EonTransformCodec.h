@@ -0,0 +1,44 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// A transform packed for frequent updates: 12 bytes instead of six floats.
+// Roll is not sent; characters stay upright. Nor is velocity: receivers
+// derive it from successive rows (FEonDeadReckoning).
+//
+//   Position     bits 0-21 X, 22-43 Y, 44-63 Z: centimetres from an origin,
+//                offset binary. X and Y reach +-20.9 km, Z +-5.2 km; beyond
+//                that they clamp.
+//   Orientation  bits 0-15 yaw over [0, 360), 16-31 pitch over [-90, 90]
+//
+// The server's update_player_transform reducer (Server/eonserver/src/lib.rs)
+// unpacks the same layout; keep the two in step.
+struct EON_API FEonCompactTransform
+{
+	uint64 Position = 0;
+	uint32 Orientation = 0;
+};
+
+class EON_API FEonTransformCodec
+{
+public:
+	static constexpr int32 PositionBitsXY = 22;
+	static constexpr int32 PositionBitsZ = 20;
+	static constexpr double PositionStepCm = 1.0;
+
+	// Worst round-trip error per component inside the ranges above
+	static constexpr double MaxPositionErrorCm = PositionStepCm * 0.5;
+	static constexpr double MaxYawErrorDegrees = 360.0 / 65536.0 * 0.5;
+	static constexpr double MaxPitchErrorDegrees = 180.0 / 65535.0 * 0.5;
+
+	// Position relative to Origin, e.g. an instance's or a replicated actor's frame
+	static FEonCompactTransform Encode(const FVector& Position, const FRotator& Rotation, const FVector& Origin = FVector::ZeroVector);
+	static void Decode(const FEonCompactTransform& Transform, FVector& OutPosition, FRotator& OutRotation, const FVector& Origin = FVector::ZeroVector);
+
+	static uint64 EncodePosition(const FVector& Offset);
+	static FVector DecodePosition(uint64 Packed);
+	static uint32 EncodeOrientation(const FRotator& Rotation);
+	static FRotator DecodeOrientation(uint32 Packed);
+};
@@ -4,8 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "SpaceTimeDBRows.h"
 #include "InventoryComponent.generated.h"
 
+struct FSpaceTimeDBServerMessage;
+class USpaceTimeDBManager;
+
 // ============================================================================
 // PHASE 8: ENUMS
 // ============================================================================
@@ -245,6 +249,7 @@ public:
 	UInventoryComponent();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	// ========================================================================
@@ -278,8 +283,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	int32 GetMaxSlots() const { return MaxSlots; }
 
-	UFUNCTION()
-	void OnInventoryDataReceived(const FString& JsonData);
+	// Applies a batch of server inventory rows with a single sort and change notification.
+	// Rows owned by anyone other than OwnerIdentity are ignored. A snapshot (a
+	// subscription's initial rows) is the whole inventory: held items it leaves out are removed.
+	void ApplyServerInventoryRows(TArrayView<const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>> Rows, const FSpaceTimeDBIdentity& OwnerIdentity, bool bSnapshot = false);
+
+	// Stores item_definition rows and refreshes display name, stack limit, type and rarity of held items
+	void ApplyServerItemDefinitions(TArrayView<const TSpaceTimeDBRowUpdate<FSpaceTimeDBItemDefinitionRow>> Rows);
 
 	// ========================================================================
 	// PHASE 8.1: WEIGHT SYSTEM
@@ -662,11 +672,16 @@ private:
 	bool bTransactionLoggingEnabled = true;
 	int32 CapacityLevel = 0;
 
+	// item_definition rows from the server, by item id
+	TSpaceTimeDBKeyMap<FString, FSpaceTimeDBItemDefinitionRow> ItemDefinitions;
+
 	// ========================================================================
 	// INTERNAL HELPERS
 	// ========================================================================
 
 	void RefreshFromServer();
+	void OnServerMessageReceived(const FSpaceTimeDBServerMessage& Message);
+	USpaceTimeDBManager* GetReducerManager() const;
 	void AddItemLocal(const FString& ItemId, int32 Quantity);
 	void RemoveItemLocal(int64 EntryId, int32 Quantity);
 	void LogTransaction(const FString& Action, const FString& ItemId, int32 Quantity, bool bSuccess, const FString& Details = TEXT(""));
@@ -675,4 +690,5 @@ private:
 	int32 FindFirstEmptySlotIndex() const;
 	void ReassignSlotIndices();
 	FInventorySlot CreateItemSlot(const FString& ItemId, int32 Quantity);
+	bool ApplyItemDefinition(FInventorySlot& Slot) const;
 };
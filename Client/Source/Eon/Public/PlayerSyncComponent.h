@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "SpaceTimeDBRows.h"
+#include "EonDeadReckoning.h"
 #include "PlayerSyncComponent.generated.h"
 
 USTRUCT(BlueprintType)
@@ -11,6 +13,9 @@ struct FOtherPlayer
 {
 	GENERATED_BODY()
 
+	// Native code keys players by Identity; PlayerId is its hex form for Blueprint
+	FSpaceTimeDBIdentity Identity;
+
 	UPROPERTY(BlueprintReadOnly)
 	FString PlayerId;
 
@@ -30,9 +35,13 @@ struct FOtherPlayer
 	bool bIsOnline = false;
 };
 
+class USpaceTimeDBTableCache;
+class USpaceTimeDBManager;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerJoined, const FOtherPlayer&, Player);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerLeft, const FString&, PlayerId);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerUpdated, const FOtherPlayer&, Player);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlayerSnapshotComplete);
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class EON_API UPlayerSyncComponent : public UActorComponent
@@ -43,20 +52,31 @@ public:
 	UPlayerSyncComponent();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	UFUNCTION(BlueprintCallable, Category = "PlayerSync")
-	TArray<FOtherPlayer> GetOtherPlayers() const { return OtherPlayers; }
+	TArray<FOtherPlayer> GetOtherPlayers() const;
 
+	// PlayerId is the hex identity, as in FOtherPlayer::PlayerId
 	UFUNCTION(BlueprintCallable, Category = "PlayerSync")
 	FOtherPlayer GetPlayerById(const FString& PlayerId) const;
 
+	FOtherPlayer GetPlayer(const FSpaceTimeDBIdentity& PlayerIdentity) const;
+
 	UFUNCTION(BlueprintCallable, Category = "PlayerSync")
-	int32 GetPlayerCount() const { return OtherPlayers.Num(); }
+	int32 GetPlayerCount() const { return OnlinePlayerCount; }
+
+	// Listens to Cache's player table. BeginPlay binds to the game instance's
+	// subsystems; automation can bind to its own.
+	void Bind(USpaceTimeDBTableCache* InCache, USpaceTimeDBManager* InManager);
+	void Unbind();
+
+	// Moves every representation towards its latest row. Called from Tick.
+	void InterpolatePlayers(float DeltaTime);
 
-	// Called when receiving player data from SpaceTimeDB
-	UFUNCTION()
-	void OnPlayerDataReceived(const FString& PlayerId, const FString& JsonData);
+	// Where a player is being shown, i.e. the interpolated position
+	TOptional<FVector> GetDisplayLocation(const FSpaceTimeDBIdentity& PlayerIdentity) const;
 
 	UPROPERTY(BlueprintAssignable, Category = "PlayerSync")
 	FOnPlayerJoined OnPlayerJoined;
@@ -67,19 +87,44 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "PlayerSync")
 	FOnPlayerUpdated OnPlayerUpdated;
 
+	// Every player of a new subscription (connect or instance join) has been applied
+	UPROPERTY(BlueprintAssignable, Category = "PlayerSync")
+	FOnPlayerSnapshotComplete OnSnapshotComplete;
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "PlayerSync")
 	float InterpolationSpeed = 10.0f;
 
 private:
-	UPROPERTY()
-	TArray<FOtherPlayer> OtherPlayers;
-
-	// Map of player representations in world
-	UPROPERTY()
-	TMap<FString, AActor*> PlayerActors;
+	TWeakObjectPtr<USpaceTimeDBTableCache> Cache;
+	TWeakObjectPtr<USpaceTimeDBManager> Manager;
+	int32 OnlinePlayerCount = 0;
+
+	// What is shown for another player: the interpolated transform, the
+	// dead-reckoned target it moves towards, and the actor it drives once one is spawned
+	struct FPlayerRepresentation
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		FEonDeadReckoning Motion;
+	};
+
+	// Not a UPROPERTY (the key is not a reflected type); the level owns the
+	// actors, so weak pointers are enough.
+	TMap<FSpaceTimeDBIdentity, FPlayerRepresentation> PlayerRepresentations;
 
 	void SpawnPlayerRepresentation(const FOtherPlayer& Player);
 	void UpdatePlayerRepresentation(const FOtherPlayer& Player);
-	void RemovePlayerRepresentation(const FString& PlayerId);
+	void RemovePlayerRepresentation(const FSpaceTimeDBIdentity& PlayerIdentity);
+	void AddMotionSample(const FSpaceTimeDBPlayerRow& Row);
+
+	// Player table callbacks
+	void HandlePlayerInserted(const FSpaceTimeDBPlayerRow& Row);
+	void HandlePlayerUpdated(const FSpaceTimeDBPlayerRow& OldRow, const FSpaceTimeDBPlayerRow& NewRow);
+	void HandlePlayerDeleted(const FSpaceTimeDBPlayerRow& Row);
+	void HandleSnapshotComplete();
+
+	bool IsTrackedPlayer(const FSpaceTimeDBPlayerRow& Row) const;
+	static FOtherPlayer ToOtherPlayer(const FSpaceTimeDBPlayerRow& Row);
 };
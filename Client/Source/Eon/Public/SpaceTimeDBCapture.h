@@ -0,0 +1,104 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+class FSpaceTimeDBLoopbackTransport;
+
+// One websocket frame as seen by the client, with its time since capture start
+struct FSpaceTimeDBCaptureFrame
+{
+	double Seconds = 0.0;
+	bool bOutbound = false;
+	bool bBinary = false;
+	TArray<uint8> Bytes;
+};
+
+// Capture files (.eoncap): a magic and version, then one record per frame:
+//   u8 flags (1 = outbound, 2 = binary), u32 microseconds since the previous
+//   frame, u32 size, payload. Text frames are stored as UTF-8.
+class EON_API FSpaceTimeDBCapture
+{
+public:
+	static constexpr uint32 Magic = 0x50414345; // "ECAP"
+	static constexpr uint32 Version = 1;
+
+	static bool Load(const FString& Path, TArray<FSpaceTimeDBCaptureFrame>& OutFrames);
+	static bool Parse(TArrayView<const uint8> Bytes, TArray<FSpaceTimeDBCaptureFrame>& OutFrames);
+
+	// Saved/NetCaptures/<Name>.eoncap unless Name is already a path
+	static FString ResolvePath(const FString& Name);
+};
+
+// Appends frames to a capture file as they happen. Game thread only.
+class EON_API FSpaceTimeDBCaptureWriter
+{
+public:
+	~FSpaceTimeDBCaptureWriter();
+
+	bool Open(const FString& Path);
+	void Close();
+	bool IsOpen() const { return Archive.IsValid(); }
+	int32 GetNumFrames() const { return NumFrames; }
+
+	void Record(bool bOutbound, bool bBinary, const uint8* Data, int32 Size);
+
+private:
+	TUniquePtr<FArchive> Archive;
+	double LastFrameTime = 0.0;
+	int32 NumFrames = 0;
+};
+
+// Timing of one replay. Processing time covers decode, dispatch and every
+// listener that runs synchronously with it (components, the table cache when
+// not time-slicing); it assumes the manager runs without the network thread.
+struct EON_API FSpaceTimeDBReplayReport
+{
+	int32 FramesReplayed = 0;
+	int32 Ticks = 0;
+	double CaptureSeconds = 0.0;
+	double TotalProcessMs = 0.0;
+	double MeanProcessMs = 0.0;
+	double P50ProcessMs = 0.0;
+	double P95ProcessMs = 0.0;
+	double MaxProcessMs = 0.0;
+
+	// Worst single tick, i.e. the largest hitch the replay would cause in a game frame
+	double MaxTickMs = 0.0;
+
+	FString ToString() const;
+};
+
+// Feeds the inbound frames of a capture to the client end of a loopback
+// transport, so they go through the same path as live traffic. Outbound
+// frames are skipped: the client produces its own. Time advances only by the
+// DeltaTime passed to Tick(), so a replay is repeatable.
+class EON_API FSpaceTimeDBReplayDriver
+{
+public:
+	// Speed 1 replays at the recorded pace, 4 four times faster; 0 as fast as possible
+	FSpaceTimeDBReplayDriver(TArray<FSpaceTimeDBCaptureFrame>&& InFrames, TSharedRef<FSpaceTimeDBLoopbackTransport> InTransport, float InSpeed);
+
+	// Delivers every frame due by now; returns false once the capture is exhausted
+	bool Tick(float DeltaTime);
+
+	// Delivers all remaining frames at once
+	void RunToEnd();
+
+	bool IsFinished() const { return NextFrame >= Frames.Num(); }
+	FSpaceTimeDBReplayReport GetReport() const;
+
+private:
+	void Deliver(FSpaceTimeDBCaptureFrame& Frame);
+
+	TArray<FSpaceTimeDBCaptureFrame> Frames;
+	TSharedRef<FSpaceTimeDBLoopbackTransport> Transport;
+	float Speed = 1.0f;
+	int32 NextFrame = 0;
+	double Elapsed = 0.0;
+	int32 Ticks = 0;
+	double MaxTickMs = 0.0;
+	TArray<double> ProcessMs;
+};
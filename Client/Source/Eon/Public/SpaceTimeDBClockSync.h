@@ -0,0 +1,55 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Estimates the server's clock from reducer round trips, NTP style. An answered
+// call brackets the timestamp of its transaction between our send and receive
+// times, so each round trip gives the offset between the clocks to within half
+// of it. Queueing only ever lengthens a round trip, so the estimate is taken
+// from the shortest ones: the best sample of each few seconds is kept, and a
+// line through the best quarter of those gives offset and drift.
+//
+// Local times are FPlatformTime::Seconds(); server times are seconds since the
+// Unix epoch, as in SpaceTimeDB's Timestamp.
+class EON_API FSpaceTimeDBClockSync
+{
+public:
+	// A call sent at LocalSendSeconds was answered at LocalReceiveSeconds by a
+	// transaction the server ran at ServerMicros
+	void AddSample(double LocalSendSeconds, double LocalReceiveSeconds, int64 ServerMicros);
+	void Reset();
+
+	bool IsSynchronized() const { return Samples.Num() > 0; }
+
+	// Server time at LocalSeconds, and the reverse, e.g. to place a Timestamp
+	// column such as player.last_seen on the local clock
+	double ToServerTime(double LocalSeconds) const;
+	double ToLocalTime(double ServerSeconds) const;
+
+	// How much faster the server's clock runs than ours, in parts per million
+	double GetDriftPpm() const { return Drift * 1e6; }
+	// Half the shortest round trip the estimate rests on: its error bound
+	double GetUncertaintySeconds() const { return Uncertainty; }
+	int32 GetNumSamples() const { return Samples.Num(); }
+
+private:
+	struct FSample
+	{
+		double LocalTime = 0.0;
+		double Offset = 0.0;
+		double RoundTrip = 0.0;
+	};
+
+	void Refit();
+
+	// Best sample per bucket of local time, oldest first
+	TArray<FSample> Samples;
+
+	// Server time = LocalTime + Offset + Drift * (LocalTime - FitTime)
+	double FitTime = 0.0;
+	double Offset = 0.0;
+	double Drift = 0.0;
+	double Uncertainty = 0.0;
+};
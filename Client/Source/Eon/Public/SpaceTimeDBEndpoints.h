@@ -0,0 +1,119 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBTransport.h"
+
+// What probing one host found
+struct EON_API FSpaceTimeDBEndpointResult
+{
+	FString Host;
+	bool bHealthy = false;
+	// Connect() until the connection is up
+	double HandshakeMs = 0.0;
+	// A subscribe sent on the new connection until its answer
+	double RoundTripMs = 0.0;
+	FString Error;
+
+	// Time to a first answer, which is what a connecting player waits for
+	double GetScoreMs() const { return HandshakeMs + RoundTripMs; }
+};
+
+// Connects to every candidate host at once, times the handshake and one
+// subscribe round trip on each, then closes them. Probe connections carry no
+// auth token, so they never touch our player row. Factory creates each
+// connection, as USpaceTimeDBManager::SetTransportFactory does. Game thread only.
+class EON_API FSpaceTimeDBEndpointProbe
+{
+public:
+	FSpaceTimeDBEndpointProbe(const TArray<FString>& Hosts, const FString& ModuleName, bool bBinary, FSpaceTimeDBTransportFactory Factory);
+	~FSpaceTimeDBEndpointProbe();
+
+	// Clock for every timing; FPlatformTime::Seconds unless a test drives time itself
+	void SetClock(TFunction<double()> InClock) { Clock = MoveTemp(InClock); }
+	// Seconds a host may take to answer before it counts as down
+	void SetTimeout(double InTimeoutSeconds) { TimeoutSeconds = InTimeoutSeconds; }
+
+	// Called once every host has answered, failed or timed out. May run inside
+	// a probe transport's callback, so it must not destroy the probe.
+	TFunction<void()> OnComplete;
+
+	void Start();
+	// Times out hosts that are taking too long
+	void Tick();
+
+	bool IsDone() const { return bDone; }
+	const TArray<FSpaceTimeDBEndpointResult>& GetResults() const { return Results; }
+
+	// Every host, healthy ones first and fastest first; the rest in the order given
+	TArray<FString> GetRanking() const;
+
+private:
+	enum class EStage : uint8
+	{
+		Connecting,
+		AwaitingAnswer,
+		Finished
+	};
+
+	struct FProbe
+	{
+		TSharedPtr<ISpaceTimeDBTransport> Transport;
+		EStage Stage = EStage::Connecting;
+		double StartTime = 0.0;
+		double SentTime = 0.0;
+	};
+
+	double GetTime() const { return Clock ? Clock() : FPlatformTime::Seconds(); }
+	void HandleConnected(int32 Index);
+	void HandleFrame(int32 Index, const TArray<uint8>& Frame, bool bFrameBinary);
+	void Fail(int32 Index, const FString& Error);
+	void Finish(int32 Index);
+
+	TArray<FSpaceTimeDBEndpointResult> Results;
+	TArray<FProbe> Probes;
+	FString ModuleName;
+	bool bBinary = false;
+	FSpaceTimeDBTransportFactory Factory;
+	TFunction<double()> Clock;
+	double TimeoutSeconds = 3.0;
+	bool bStarted = false;
+	bool bDone = false;
+};
+
+// The hosts a connection may use, best first. The first is the one in use;
+// repeated failures rotate it to the back. Kept between sessions in a small
+// JSON file so later sessions can skip the probe.
+class EON_API FSpaceTimeDBEndpointList
+{
+public:
+	// Starts over with Hosts in the order given
+	void Reset(const TArray<FString>& Hosts);
+	// A probe's ranking; Ranked must hold the same hosts
+	void SetRanking(const TArray<FString>& Ranked);
+
+	const FString& GetCurrent() const { return Ranking[0]; }
+	const TArray<FString>& GetRanking() const { return Ranking; }
+	int32 Num() const { return Ranking.Num(); }
+
+	// A connection to the current host failed. True when that was the
+	// FailoverAfterErrors-th failure in a row and the next host is now current.
+	bool NoteFailure(int32 FailoverAfterErrors);
+	void NoteConnected() { ConsecutiveFailures = 0; }
+
+	// Relative names go under Saved/
+	static FString ResolveCachePath(const FString& Name);
+
+	// Takes the cached ranking if it is for the same hosts and at most MaxAgeSeconds old
+	bool LoadCache(const FString& Path, double MaxAgeSeconds);
+	void SaveCache(const FString& Path) const;
+
+private:
+	// As configured, sorted: a cache only applies to the same set
+	TArray<FString> Candidates;
+	TArray<FString> Ranking;
+	int32 ConsecutiveFailures = 0;
+	// Unix time of the probe behind Ranking; 0 if it was never probed
+	double ProbedAt = 0.0;
+};
@@ -0,0 +1,50 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// A SpaceTimeDB Identity: 32 bytes, held in the little-endian order BSATN
+// sends them. The hash is computed once when the identity is built, so map
+// lookups and comparisons cost a few word compares rather than hashing a
+// 64-character hex string. Convert with ToHex() only where text is needed:
+// subscription queries, logs and Blueprint-facing APIs.
+struct EON_API FSpaceTimeDBIdentity
+{
+	static constexpr int32 NumBytes = 32;
+
+	// The zero identity, which the server never hands out
+	FSpaceTimeDBIdentity() = default;
+
+	// Wire (little-endian) byte order
+	static FSpaceTimeDBIdentity FromBytes(const uint8* Bytes);
+
+	// Big-endian hex as SpaceTimeDB prints it, with or without a 0x prefix.
+	// Shorter strings are zero-extended on the left. Returns false on anything
+	// that is not 1-64 hex digits, leaving OutIdentity untouched.
+	static bool FromHex(FStringView Hex, FSpaceTimeDBIdentity& OutIdentity);
+	static bool FromHex(const UTF8CHAR* Hex, int32 Length, FSpaceTimeDBIdentity& OutIdentity);
+
+	// Parses Hex, or returns the zero identity when it is not valid hex
+	static FSpaceTimeDBIdentity FromHex(FStringView Hex);
+
+	// 64 lowercase hex digits, big-endian
+	FString ToHex() const;
+
+	bool IsValid() const { return (Words[0] | Words[1] | Words[2] | Words[3]) != 0; }
+	const uint8* GetBytes() const { return reinterpret_cast<const uint8*>(Words); }
+
+	bool operator==(const FSpaceTimeDBIdentity& Other) const
+	{
+		return Hash == Other.Hash && Words[0] == Other.Words[0] && Words[1] == Other.Words[1] &&
+			Words[2] == Other.Words[2] && Words[3] == Other.Words[3];
+	}
+	bool operator!=(const FSpaceTimeDBIdentity& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FSpaceTimeDBIdentity& Identity) { return Identity.Hash; }
+
+private:
+	uint64 Words[4] = { 0, 0, 0, 0 };
+	// Zero for the zero identity, so the default constructor needs no work
+	uint32 Hash = 0;
+};
@@ -0,0 +1,109 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBIdentity.h"
+
+// Percentiles over one set of latency samples, in milliseconds
+struct EON_API FSpaceTimeDBLatencyPercentiles
+{
+	int32 Samples = 0;
+	double MeanMs = 0.0;
+	double P50Ms = 0.0;
+	double P90Ms = 0.0;
+	double P99Ms = 0.0;
+	double MaxMs = 0.0;
+
+	static FSpaceTimeDBLatencyPercentiles FromSamples(TArray<double> SamplesMs);
+	FString ToString() const;
+};
+
+// One probe session. Receive latency runs from the sender's
+// update_player_position call to the row reaching the observer's
+// PlayerSyncComponent; display latency runs on to the observer's
+// interpolated position converging on it.
+struct EON_API FSpaceTimeDBLatencyReport
+{
+	double Seconds = 0.0;
+	int32 Sent = 0;
+	// Per observer: a sent update seen by two observers counts twice
+	int32 Received = 0;
+	int32 Displayed = 0;
+	// Received but overtaken by a newer position before interpolation settled on it
+	int32 Superseded = 0;
+
+	FSpaceTimeDBLatencyPercentiles ToReceive;
+	FSpaceTimeDBLatencyPercentiles ToDisplay;
+
+	FString ToString() const;
+};
+
+// Motion-to-display latency between clients running in one process, such as
+// two automation clients or a multi-client PIE session run under one process.
+// Position updates are tagged with a sequence and send time here rather than
+// on the wire: the row a peer receives carries the position that was sent,
+// which is enough to find the tag again without growing the player table.
+// Game thread only. Off until Begin(), so the hooks cost one branch.
+class EON_API FSpaceTimeDBLatencyProbe
+{
+public:
+	static FSpaceTimeDBLatencyProbe& Get();
+	static bool IsActive() { return bActive; }
+
+	// Starts a session, dropping every earlier sample
+	void Begin();
+	// Ends the session and returns its report
+	FSpaceTimeDBLatencyReport End();
+	FSpaceTimeDBLatencyReport GetReport() const;
+
+	// Clock for every timestamp; FPlatformTime::Seconds unless a test drives time itself
+	void SetClock(TFunction<double()> InClock) { Clock = MoveTemp(InClock); }
+
+	// Distance at which an interpolated position counts as converged
+	void SetToleranceCm(float InToleranceCm) { ToleranceCm = InToleranceCm; }
+
+	// Sender: an update_player_position call for Position left the client.
+	// Repeats of the sender's last position are not motion and are ignored.
+	void NoteSent(const FSpaceTimeDBIdentity& Sender, const FVector3f& Position);
+
+	// Observer (any stable pointer, e.g. its PlayerSyncComponent) received Sender's row
+	void NoteReceived(const void* Observer, const FSpaceTimeDBIdentity& Sender, const FVector3f& Position);
+
+	// Observer's interpolated position for Sender this frame
+	void NoteDisplayed(const void* Observer, const FSpaceTimeDBIdentity& Sender, const FVector& DisplayPosition);
+
+private:
+	struct FSent
+	{
+		uint32 Sequence = 0;
+		double Time = 0.0;
+		FVector3f Position = FVector3f::ZeroVector;
+	};
+
+	// What one observer has seen of one sender
+	struct FTrack
+	{
+		uint32 LastReceived = 0;
+		// Received, oldest first, not yet reached by interpolation
+		TArray<FSent> AwaitingDisplay;
+	};
+
+	double GetTime() const { return Clock ? Clock() : FPlatformTime::Seconds(); }
+
+	static bool bActive;
+
+	TFunction<double()> Clock;
+	float ToleranceCm = 5.0f;
+	double BeginTime = 0.0;
+	uint32 NextSequence = 1;
+	int32 NumSent = 0;
+	int32 NumSuperseded = 0;
+
+	// Recent sends per sender, oldest first and bounded
+	TMap<FSpaceTimeDBIdentity, TArray<FSent>> Sends;
+	TMap<TPair<const void*, FSpaceTimeDBIdentity>, FTrack> Tracks;
+
+	TArray<double> ReceiveMs;
+	TArray<double> DisplayMs;
+};
@@ -0,0 +1,154 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBProtocol.h"
+#include "SpaceTimeDBNetWorker.h"
+
+class USpaceTimeDBTableCache;
+
+// Runs the inventory, world item and interactable reducers of
+// Server/eonserver/src/lib.rs in process, for solo and offline play. Calls apply
+// to an in-memory copy of our rows at once and are queued for the server, which
+// stays authoritative: its rows are the confirmed state, and the rows listeners
+// see are the confirmed state with every unanswered call replayed on top.
+//
+// Inventory rows a call inserts get a local entry id until the server answers
+// with the real one. Listeners keep seeing the local id for that row; calls that
+// name it are rewritten, and held back until the server has assigned it.
+//
+// Owned by USpaceTimeDBManager (see SetLocalAuthority); game thread only.
+class EON_API FSpaceTimeDBLocalAuthority
+{
+public:
+	// The rows the ported reducers read and write
+	struct FStore
+	{
+		TSpaceTimeDBKeyMap<uint64, FSpaceTimeDBInventoryRow> Inventory;
+		TSpaceTimeDBKeyMap<uint64, FSpaceTimeDBWorldItemRow> WorldItems;
+		TSpaceTimeDBKeyMap<FString, FSpaceTimeDBInteractableRow> Interactables;
+		TSpaceTimeDBKeyMap<FString, FSpaceTimeDBItemDefinitionRow> ItemDefinitions;
+		// Our own player row, for use_consumable's effects
+		TOptional<FSpaceTimeDBPlayerRow> Player;
+	};
+
+	// Ports of the lib.rs reducers. Each changes Store as the server changes its
+	// tables for a call from Sender, including its quirks (stacks clamp at
+	// max_stack and drop the excess). NewEntryId is the key of an inserted row.
+	static void AddItemToInventory(FStore& Store, const FSpaceTimeDBIdentity& Sender, const FString& ItemId, uint32 Quantity, uint64 NewEntryId);
+	static void RemoveItemFromInventory(FStore& Store, const FSpaceTimeDBIdentity& Sender, uint64 EntryId, uint32 Quantity);
+	static void UseConsumable(FStore& Store, const FSpaceTimeDBIdentity& Sender, uint64 EntryId);
+	static void CollectWorldItem(FStore& Store, const FSpaceTimeDBIdentity& Sender, uint64 WorldItemId, uint64 NewEntryId);
+	static void ToggleInteractable(FStore& Store, const FString& InteractableId);
+
+	// Whether calls to ReducerName run here; everything else goes straight to the server
+	static bool HandlesReducer(const FString& ReducerName);
+
+	// Local entry ids start here, far above anything the server's auto_inc hands out
+	static constexpr uint64 LocalEntryIdBase = 1ull << 62;
+
+	void SetIdentity(const FSpaceTimeDBIdentity& InIdentity) { Identity = InIdentity; }
+
+	// Starts from rows listeners already hold, when enabled mid-session
+	void Seed(const USpaceTimeDBTableCache& Cache);
+
+	// Adds the standard item definitions seeded by lib.rs's init() that are not
+	// known yet, so offline play stacks by the same rules. The server's replace them.
+	void AddDefaultItemDefinitions(FSpaceTimeDBServerMessage& OutChanges);
+
+	// Runs a call locally and queues it for the server. OutChanges receives the
+	// rows whose visible state changed. False, with nothing queued, if the
+	// reducer is not run here or the arguments do not match it.
+	bool Call(const FString& ReducerName, const FSpaceTimeDBArgList& Args, FSpaceTimeDBServerMessage& OutChanges);
+
+	// A server message in; the message listeners should see out. Other tables
+	// pass through, ours are replaced by the change in what listeners see.
+	void ApplyServerMessage(const FSpaceTimeDBServerMessage& Message, FSpaceTimeDBServerMessage& OutMessage);
+
+	// Queued calls that can go to the server now, oldest first, with entry ids
+	// rewritten. A call naming a row the server has not assigned yet waits, and
+	// so does everything behind it.
+	void TakeCallsToSend(TArray<FSpaceTimeDBReducerCall>& OutCalls, double Now);
+
+	// A call from TakeCallsToSend left in the batch that got RequestId
+	void NoteSent(uint32 LocalCallId, uint32 RequestId);
+
+	// A call reported sent never reached the socket; the manager queued it again
+	void NoteUnsent(uint32 LocalCallId);
+
+	// The manager dropped or handed back its queued local calls: they are kept for the next connection
+	void NoteQueueDropped();
+
+	// The connection was lost: whether calls in flight ran shows in the next snapshot
+	void NoteConnectionLost();
+
+	// Gives up on calls the server never answered and replays the rest
+	void Tick(double Now, FSpaceTimeDBServerMessage& OutChanges);
+
+	// Drops world items and interactables of other instances, as the table cache does
+	void HandleInstanceChanged(TOptional<uint64> InstanceId);
+
+	// Everything listeners should hold now, as upserts; for listeners that bind late
+	void GetVisibleRows(FSpaceTimeDBServerMessage& OutRows) const;
+
+	const FStore& GetConfirmed() const { return Confirmed; }
+	const FStore& GetPredicted() const { return Predicted; }
+	int32 GetNumPendingCalls() const { return Pending.Num(); }
+	// Pending calls not handed to the manager yet
+	int32 GetNumUnsentCalls() const;
+
+private:
+	enum class EReducer : uint8
+	{
+		AddItemToInventory,
+		RemoveItemFromInventory,
+		UseConsumable,
+		CollectWorldItem,
+		ToggleInteractable
+	};
+
+	struct FPendingCall
+	{
+		uint32 LocalCallId = 0;
+		EReducer Reducer = EReducer::AddItemToInventory;
+		FString ReducerName;
+		FSpaceTimeDBArgList Args;
+		// Key for the inventory row this call may insert; the same on every replay
+		uint64 NewEntryId = 0;
+		// Handed to the manager, and when
+		bool bReleased = false;
+		double ReleasedAt = 0.0;
+		uint32 RequestId = 0;
+		// In flight when the connection dropped
+		bool bAwaitingSnapshot = false;
+	};
+
+	static bool ParseCall(const FString& ReducerName, const FSpaceTimeDBArgList& Args, EReducer& OutReducer);
+	void ApplyCall(FStore& Store, const FPendingCall& Call) const;
+	uint64 ResolveEntryId(uint64 EntryId) const;
+	bool IsEntryIdAssigned(uint64 EntryId) const;
+	void ConfirmCall(const FPendingCall& Call, const FSpaceTimeDBServerMessage& Message, const TSet<uint64>& InsertedEntryIds);
+	void ApplyConfirmedRows(const FSpaceTimeDBServerMessage& Message, bool bSnapshot, TSet<uint64>& OutInsertedEntryIds);
+	void CommitOldestCall();
+
+	// Predicted = Confirmed + every pending call, then the visible change into OutChanges
+	void Rebase(FSpaceTimeDBServerMessage& OutChanges, bool bSnapshot);
+	void EmitVisibleChanges(FSpaceTimeDBServerMessage& OutChanges, bool bSnapshot);
+
+	FSpaceTimeDBIdentity Identity;
+
+	// The server's rows, the rows with pending calls applied, and those rows as listeners last saw them
+	FStore Confirmed;
+	FStore Predicted;
+	FStore Visible;
+
+	TArray<FPendingCall> Pending;
+	uint32 NextLocalCallId = 1;
+	uint64 NextLocalEntryId = LocalEntryIdBase;
+
+	// Local entry id -> the server's, once a call that inserted a row has been answered
+	TMap<uint64, uint64> EntryIdAliases;
+	// Server entry id -> the local id listeners know that row by
+	TMap<uint64, uint64> VisibleEntryIds;
+};
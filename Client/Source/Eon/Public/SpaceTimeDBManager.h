@@ -5,7 +5,18 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Interfaces/IHttpRequest.h"
-#include "IWebSocket.h"
+#include "Containers/Ticker.h"
+#include "SpaceTimeDBProtocol.h"
+#include "SpaceTimeDBReducers.h"
+#include "SpaceTimeDBTransport.h"
+#include "SpaceTimeDBNetSim.h"
+#include "SpaceTimeDBCapture.h"
+#include "SpaceTimeDBSubscriptions.h"
+#include "SpaceTimeDBNetWorker.h"
+#include "SpaceTimeDBStats.h"
+#include "SpaceTimeDBLocalAuthority.h"
+#include "SpaceTimeDBClockSync.h"
+#include "SpaceTimeDBEndpoints.h"
 #include "SpaceTimeDBManager.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnConnected);
@@ -14,22 +25,220 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPlayerDataReceived, const FStrin
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInstanceListReceived, const TArray<FString>&, Instances);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryUpdated, const FString&, JsonData);
 
+// Native row delegates: rows are decoded once and passed by const reference
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSpaceTimeDBServerMessage, const FSpaceTimeDBServerMessage&);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSpaceTimeDBPlayerRow, const FSpaceTimeDBPlayerRow&, ESpaceTimeDBRowOp);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSpaceTimeDBInventoryRow, const FSpaceTimeDBInventoryRow&, ESpaceTimeDBRowOp);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSpaceTimeDBInstanceChanged, TOptional<uint64>);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSpaceTimeDBReplayFinished, const FSpaceTimeDBReplayReport&);
+
+UENUM(BlueprintType)
+enum class ESpaceTimeDBProtocol : uint8
+{
+	Json UMETA(DisplayName = "JSON (text)"),
+	Binary UMETA(DisplayName = "BSATN (binary)")
+};
+
 USTRUCT(BlueprintType)
 struct FSpaceTimeDBConfig
 {
 	GENERATED_BODY()
 
+	// Overridden by -SpaceTimeDBHost= on the command line, then by Host in the [SpaceTimeDB]
+	// section of Game.ini. "loopback://" connects to an in-process transport instead.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FString Host = TEXT("wss://maincloud.spacetimedb.com");
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FString ModuleName = TEXT("eon");
 
+	// Delay before the first reconnect attempt; doubles per failed attempt up to MaxReconnectDelay, with jitter
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ReconnectDelay = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MaxReconnectDelay = 30.0f;
+
+	// Further hosts serving the same database. With any set, Connect() probes
+	// them and Host in parallel and uses the one that answers first.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Endpoints")
+	TArray<FString> CandidateHosts;
+
+	// Seconds a probed host may take to answer before it is passed over
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Endpoints")
+	float EndpointProbeTimeout = 3.0f;
+
+	// Failed connection attempts in a row before moving to the next best host
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Endpoints")
+	int32 FailoverAfterErrors = 3;
+
+	// Where the ranking is kept between sessions, under Saved/ unless absolute; empty keeps none
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Endpoints")
+	FString EndpointCacheFile = TEXT("SpaceTimeDBEndpoints.json");
+
+	// A cached ranking older than this is probed again
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Endpoints")
+	float EndpointCacheHours = 24.0f;
+
+	// 0 keeps retrying until Disconnect()
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxReconnectAttempts = 10;
+
+	// Reducer calls kept while reconnecting and replayed once connected; the oldest are dropped first
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxQueuedCallsWhileDisconnected = 64;
+
+	// Binary uses SpaceTimeDB's BSATN framing in both directions; Json is the original text protocol
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	float ReconnectDelay = 5.0f;
+	ESpaceTimeDBProtocol Protocol = ESpaceTimeDBProtocol::Json;
 
+	// Send positions as update_player_transform (see FEonTransformCodec): 12 bytes of
+	// arguments instead of six floats. Needs a server module that has that reducer.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	int32 MaxReconnectAttempts = 5;
+	bool bCompactTransforms = false;
+
+	// Queue reducer calls and send them once per flush instead of one socket send per call
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching")
+	bool bBatchOutgoingCalls = true;
+
+	// Seconds between flushes; 0 flushes once per frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching")
+	float FlushInterval = 0.0f;
+
+	// Reducers where only the most recent call per flush matters
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching")
+	TArray<FString> CoalescedReducers = { TEXT("update_player_position"), TEXT("update_player_transform") };
+
+	// Reducers sent ahead of everything else in a flush
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority")
+	TArray<FString> CriticalReducers = {
+		TEXT("add_item_to_inventory"), TEXT("remove_item_from_inventory"), TEXT("use_consumable"),
+		TEXT("collect_world_item"), TEXT("purchase_premium_item"), TEXT("gift_premium_item")
+	};
+
+	// Reducers sent last, and thinned out under backpressure. Coalesce them too,
+	// so a held call is replaced by the newest one instead of queueing up.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority")
+	TArray<FString> TelemetryReducers = { TEXT("update_player_position"), TEXT("update_player_transform") };
+
+	// Backpressure starts when the transport holds this many unsent bytes...
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority")
+	int32 BackpressureBufferedBytes = 8 * 1024;
+
+	// ...or reducer round trips run this far above the best seen; 0 ignores RTT.
+	// The only signal on transports that cannot report buffered bytes.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority")
+	float BackpressureRttMs = 400.0f;
+
+	// Seconds between telemetry calls while backpressure lasts
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority")
+	float BackpressureTelemetryInterval = 0.5f;
+
+	// Decode incoming frames and encode reducer calls on a dedicated thread.
+	// Falls back to the game thread on platforms without multithreading.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Threading")
+	bool bUseNetworkThread = true;
+
+	// Milliseconds per frame spent applying large batches to the table cache; 0 applies on arrival
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Apply")
+	float ApplyBudgetMs = 2.0f;
+
+	// Batches with fewer rows than this always apply on arrival
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Apply")
+	int32 MinRowsToTimeSlice = 256;
+};
+
+// Snapshot of the SpaceTimeDB link returned by USpaceTimeDBManager::GetNetStats().
+// Rates cover the last whole second; totals, histograms and RTT run since ResetNetStats().
+USTRUCT(BlueprintType)
+struct FSpaceTimeDBNetStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Rates")
+	float BytesInPerSecond = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Rates")
+	float BytesOutPerSecond = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Rates")
+	float MessagesInPerSecond = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Rates")
+	float MessagesOutPerSecond = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Totals")
+	int64 TotalBytesIn = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Totals")
+	int64 TotalBytesOut = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Totals")
+	int32 TotalMessagesIn = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Totals")
+	int32 TotalMessagesOut = 0;
+
+	// Row updates received, keyed by server table name
+	UPROPERTY(BlueprintReadOnly, Category = "Totals")
+	TMap<FString, int32> TableRowUpdates;
+
+	// Decodes per bucket; bucket i counts decodes that took up to DecodeBucketBoundsMicros[i]
+	UPROPERTY(BlueprintReadOnly, Category = "Decode")
+	TArray<int32> DecodeTimeHistogram;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Decode")
+	TArray<float> DecodeBucketBoundsMicros;
+
+	// Time spent decoding every message counted in the histogram
+	UPROPERTY(BlueprintReadOnly, Category = "Decode")
+	float TotalDecodeMs = 0.0f;
+
+	// Reducer calls waiting for the next flush
+	UPROPERTY(BlueprintReadOnly, Category = "Queue")
+	int32 QueuedReducerCalls = 0;
+
+	// Sent reducer calls whose transaction update has not arrived yet
+	UPROPERTY(BlueprintReadOnly, Category = "Queue")
+	int32 CallsAwaitingReply = 0;
+
+	// Bytes the transport has not sent yet, where it can tell
+	UPROPERTY(BlueprintReadOnly, Category = "Queue")
+	int32 BufferedBytesOut = 0;
+
+	// Telemetry calls are being held back for the other lanes
+	UPROPERTY(BlueprintReadOnly, Category = "Queue")
+	bool bBackpressure = false;
+
+	// Telemetry calls replaced by a newer one while held back
+	UPROPERTY(BlueprintReadOnly, Category = "Queue")
+	int32 StaleTelemetryDropped = 0;
+
+	// Reducer round trip: from the call leaving the send queue to its transaction update being dispatched
+	UPROPERTY(BlueprintReadOnly, Category = "Latency")
+	float LastRttMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Latency")
+	float SmoothedRttMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Latency")
+	float MinRttMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Latency")
+	float MaxRttMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Latency")
+	int32 RttSamples = 0;
+
+	// Server clock estimate (see USpaceTimeDBManager::GetServerTime): its error bound and drift against ours
+	UPROPERTY(BlueprintReadOnly, Category = "Clock")
+	float ClockUncertaintyMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Clock")
+	float ClockDriftPpm = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Clock")
+	int32 ClockSamples = 0;
 };
 
 UCLASS()
@@ -50,6 +259,109 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB")
 	bool IsConnected() const;
 
+	// True between a lost connection and the next successful reconnect
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB")
+	bool IsReconnecting() const { return bWantsConnection && !IsConnected(); }
+
+	// Replaces how connections are created, e.g. to hand the manager a loopback transport
+	// a test keeps the server end of. Takes effect on the next Connect(); unset uses the
+	// WebSocket, or a loopback for "loopback://" hosts.
+	void SetTransportFactory(FSpaceTimeDBTransportFactory InFactory) { TransportFactory = MoveTemp(InFactory); }
+
+	// The current connection; null before Connect()
+	TSharedPtr<ISpaceTimeDBTransport> GetTransport() const { return Transport; }
+
+	// Network condition simulator around the current connection, driven by the
+	// Eon.NetSim.* console variables. Null before Connect() and in shipping builds.
+	FSpaceTimeDBNetSimTransport* GetNetSim() const { return NetSim.Get(); }
+
+	// Host after command line and ini overrides
+	static FString ResolveHost(const FString& ConfiguredHost);
+
+	// The host in use, or about to be once the endpoint probe is done
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB")
+	FString GetCurrentHost() const { return CurrentConfig.Host; }
+
+	// Every candidate host, best first
+	const TArray<FString>& GetEndpointRanking() const { return Endpoints.GetRanking(); }
+
+	// What the last endpoint probe found; empty if no probe ran this session
+	const TArray<FSpaceTimeDBEndpointResult>& GetEndpointProbeResults() const { return EndpointProbeResults; }
+
+	// Seconds to wait before reconnect attempt N (1-based): exponential in N, capped at
+	// MaxDelay, then jittered into [cap / 2, cap] so clients spread out after a server restart
+	static float ComputeReconnectDelay(int32 Attempt, float BaseDelay, float MaxDelay);
+
+	// Sends every queued reducer call now rather than waiting for the next flush.
+	// Encoding happens inline on the calling thread.
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB")
+	void FlushOutgoingCalls();
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB")
+	int32 GetQueuedCallCount() const { return OutgoingCalls.Num(); }
+
+	// Calls a reducer declared in SpaceTimeDBReducers.h, e.g.
+	//   CallReducer(EonReducers::JoinInstance, InstanceId);
+	// Arguments are checked against the reducer at compile time and queued without
+	// being converted to strings; the frame is encoded straight from them at flush.
+	template <typename... ArgTypes>
+	void CallReducer(const TSpaceTimeDBReducer<ArgTypes...>& Reducer, typename TCallTraits<ArgTypes>::ParamType... Args)
+	{
+		CallReducer(FString(Reducer.Name), TSpaceTimeDBReducer<ArgTypes...>::MakeArgs(Args...));
+	}
+
+	// Traffic, decode cost and reducer latency; also shown by "stat EonNet"
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Stats")
+	FSpaceTimeDBNetStats GetNetStats() const;
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Stats")
+	void ResetNetStats();
+
+	// The server's clock now, in seconds since the Unix epoch, estimated from
+	// reducer round trips. Our own UTC clock until the first call is answered.
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Clock")
+	double GetServerTime() const;
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Clock")
+	bool IsClockSynchronized() const { return ClockSync.IsSynchronized(); }
+
+	// A server Timestamp (e.g. FSpaceTimeDBPlayerRow::LastSeenMicros) on the FPlatformTime::Seconds() clock
+	double ServerTimeToLocal(int64 ServerMicros) const;
+
+	const FSpaceTimeDBClockSync& GetClockSync() const { return ClockSync; }
+
+	// Records every frame in and out to Saved/NetCaptures/<Name>.eoncap (or to Name, if it is a path).
+	// Also "Eon.Net.Capture <Name>" in the console.
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Capture")
+	bool StartCapture(const FString& Name);
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Capture")
+	void StopCapture();
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Capture")
+	bool IsCapturing() const { return CaptureWriter.IsOpen(); }
+
+	// Reconnects to a loopback and feeds it the inbound frames of a capture, so every listener
+	// runs as it would against the server. Speed 1 keeps the recorded pace, 0 runs flat out.
+	// The report is logged and passed to OnReplayFinished. Also "Eon.Net.Replay <Name> [Speed]".
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Capture")
+	bool StartReplay(const FString& Name, float Speed = 1.0f);
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Capture")
+	void StopReplay() { ReplayDriver.Reset(); }
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Capture")
+	bool IsReplaying() const { return ReplayDriver.IsValid(); }
+
+	// Identity assigned by the server; invalid (zero) until the IdentityToken arrives
+	const FSpaceTimeDBIdentity& GetIdentity() const { return Identity; }
+
+	// Instance the local player row is in, as last seen from the server
+	TOptional<uint64> GetCurrentInstance() const { return Subscriptions.GetInstance(); }
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Instance")
+	bool IsInInstance() const { return Subscriptions.GetInstance().IsSet(); }
+
 	// Player Management
 	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Player")
 	void RegisterPlayer(const FString& Username);
@@ -90,6 +402,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Interactable")
 	void ToggleInteractable(const FString& InteractableId);
 
+	// Solo and offline play: inventory, world item and interactable reducers run in
+	// process and take effect at once, then sync to the server in the background.
+	// Listeners see the result through the usual messages and delegates. Works
+	// before Connect(); calls made offline are sent once connected.
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Solo")
+	void SetLocalAuthority(bool bEnabled);
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Solo")
+	bool HasLocalAuthority() const { return LocalAuthority.IsValid(); }
+
+	// Null unless SetLocalAuthority(true)
+	const FSpaceTimeDBLocalAuthority* GetLocalAuthority() const { return LocalAuthority.Get(); }
+
+	// Typed row events (C++ only). OnServerMessage fires first with the whole decoded message.
+	FOnSpaceTimeDBServerMessage OnServerMessage;
+	FOnSpaceTimeDBPlayerRow OnPlayerRow;
+	FOnSpaceTimeDBInventoryRow OnInventoryRow;
+
+	// Fired when a join/leave has completed and subscriptions were rescoped
+	FOnSpaceTimeDBInstanceChanged OnInstanceChanged;
+
+	FOnSpaceTimeDBReplayFinished OnReplayFinished;
+
 	// Events
 	UPROPERTY(BlueprintAssignable, Category = "SpaceTimeDB|Events")
 	FOnConnected OnConnected;
@@ -97,6 +432,7 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "SpaceTimeDB|Events")
 	FOnDisconnected OnDisconnected;
 
+	// Compatibility: rows re-encoded as JSON, only when something is bound
 	UPROPERTY(BlueprintAssignable, Category = "SpaceTimeDB|Events")
 	FOnPlayerDataReceived OnPlayerDataReceived;
 
@@ -107,16 +443,107 @@ public:
 	FOnInventoryUpdated OnInventoryUpdated;
 
 protected:
-	void CallReducer(const FString& ReducerName, const TArray<FString>& Args);
-	void Subscribe(const FString& Query);
-	void HandleMessage(const FString& Message);
+	// Untyped form, for reducers only known at runtime
+	void CallReducer(const FString& ReducerName, FSpaceTimeDBArgList Args);
+	void RefreshSubscriptions();
+	void HandleMessage(const TArray<uint8>& Utf8Message);
+	void HandleBinaryMessage(const TArray<uint8>& Message);
+	void DispatchServerMessage(const FSpaceTimeDBServerMessage& Message);
 	void AttemptReconnect();
 
 private:
-	TSharedPtr<IWebSocket> WebSocket;
+	bool IsBinaryProtocol() const { return CurrentConfig.Protocol == ESpaceTimeDBProtocol::Binary; }
+	void OpenConnection();
+	TSharedRef<ISpaceTimeDBTransport> CreateTransport(const FSpaceTimeDBTransportParams& Params) const;
+	void ConnectToBestEndpoint();
+	void FinishEndpointProbe();
+	void HandleFrame(TArray<uint8>& Frame, bool bBinary);
+	bool NetTick(float DeltaTime);
+	void EnqueueCall(const FString& ReducerName, FSpaceTimeDBArgList&& Args, uint32 LocalCallId = 0);
+	void DropQueuedCalls(const TCHAR* Reason);
+	void RequeueUnsentCalls(TArray<FSpaceTimeDBReducerCall>&& Calls);
+	void RebuildCoalescedCallSlots();
+	void SubmitOutgoingCalls(bool bUseWorker);
+	ESpaceTimeDBCallLane GetCallLane(const FString& ReducerName) const;
+	void UpdateBackpressure();
+	void SendFrame(const FSpaceTimeDBOutboundFrame& Frame);
+	void DrainNetWorker();
+	void BroadcastServerMessage(const FSpaceTimeDBServerMessage& Message);
+	void UpdateInstanceFromOwnRow(const FSpaceTimeDBServerMessage& Message);
+	void SendLocalAuthorityCalls();
+	void RecordInbound(int32 Bytes);
+	void RecordOutbound(int32 Bytes);
+	void RecordServerMessage(const FSpaceTimeDBServerMessage& Message);
+	void UpdateNetStats(float DeltaTime);
+	void TickReplay(float DeltaTime);
+
+	TSharedPtr<ISpaceTimeDBTransport> Transport;
+	TSharedPtr<FSpaceTimeDBNetSimTransport> NetSim;
+	// Bumped for every transport; worker frames carry it, so ones from an older connection are spotted
+	uint32 ConnectionGeneration = 0;
+	FSpaceTimeDBTransportFactory TransportFactory;
 	FSpaceTimeDBConfig CurrentConfig;
-	FString Identity;
+
+	// Candidate hosts, best first; CurrentConfig.Host is the first
+	FSpaceTimeDBEndpointList Endpoints;
+	TUniquePtr<FSpaceTimeDBEndpointProbe> EndpointProbe;
+	TArray<FSpaceTimeDBEndpointResult> EndpointProbeResults;
+	FSpaceTimeDBIdentity Identity;
 	bool bIsConnected = false;
+
+	// Set by Connect(), cleared by Disconnect(): while set, lost connections are retried
+	bool bWantsConnection = false;
+
+	// From the IdentityToken; presented on reconnect so the server keeps our identity and rows
+	FString AuthToken;
+
+	// Desired vs. active queries; rescoped when our player row changes instance
+	FSpaceTimeDBSubscriptions Subscriptions;
+	uint32 NextRequestId = 1;
+
+	// Outgoing reducer calls waiting for the next flush, or for a reconnect; coalesced reducers keep one slot each
+	TArray<FSpaceTimeDBReducerCall> OutgoingCalls;
+	TMap<FString, int32> CoalescedCallSlots;
+	float TimeSinceFlush = 0.0f;
+
+	// Set while the link is backed up; telemetry then goes out at most every BackpressureTelemetryInterval
+	bool bBackpressure = false;
+	double LastTelemetrySendTime = 0.0;
+
+	// Decode / encode thread; null when running everything on the game thread
+	TUniquePtr<FSpaceTimeDBNetWorker> NetWorker;
+	FTSTicker::FDelegateHandle NetTickerHandle;
+
+	// Runs our own reducer calls ahead of the server; null unless SetLocalAuthority(true)
+	TUniquePtr<FSpaceTimeDBLocalAuthority> LocalAuthority;
+
+	// Instrumentation. NetStats holds totals and RTT; the window accumulates the current second.
+	struct FNetStatsWindow
+	{
+		int64 BytesIn = 0;
+		int64 BytesOut = 0;
+		int32 MessagesIn = 0;
+		int32 MessagesOut = 0;
+		float Seconds = 0.0f;
+	};
+	FSpaceTimeDBNetStats NetStats;
+	FNetStatsWindow NetStatsWindow;
+	FSpaceTimeDBDecodeHistogram DecodeHistogram;
+	// Row updates per table, in FSpaceTimeDBServerMessage order
+	int32 TableRowUpdates[6] = {};
+
+	// Each sent reducer call, by request id, until its transaction update arrives
+	struct FCallInFlight
+	{
+		double SendTime = 0.0;
+		// Its transaction stamps our player row's last_seen, which dates the reply when the message carries no timestamp
+		bool bStampsLastSeen = false;
+	};
+	TMap<uint32, FCallInFlight> CallsInFlight;
+	FSpaceTimeDBClockSync ClockSync;
+	FSpaceTimeDBCaptureWriter CaptureWriter;
+	TUniquePtr<FSpaceTimeDBReplayDriver> ReplayDriver;
+
 	int32 ReconnectAttempts = 0;
-	FTimerHandle ReconnectTimerHandle;
+	FTSTicker::FDelegateHandle ReconnectTickerHandle;
 };
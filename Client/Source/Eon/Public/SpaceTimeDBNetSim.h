@@ -0,0 +1,133 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "SpaceTimeDBTransport.h"
+
+// Network conditions to impose on a connection. All zero is a perfect link.
+struct EON_API FSpaceTimeDBNetSimSettings
+{
+	// One-way delay added to every frame and connection event, in each direction
+	float LatencyMs = 0.0f;
+	// Extra one-way delay per frame, uniform in [0, JitterMs]
+	float JitterMs = 0.0f;
+	// Chance (0-100) that a frame may overtake frames sent before it. Otherwise
+	// jitter never reorders, as on a single TCP stream.
+	float ReorderPercent = 0.0f;
+	// Chance (0-100) that a frame is lost. WebSockets run over TCP, so a loss
+	// shows up as a retransmit stall of RetransmitMs, not as a missing frame.
+	float LossPercent = 0.0f;
+	float RetransmitMs = 200.0f;
+	// Link capacity in kilobits per second; 0 is unlimited. Frames queue behind
+	// each other while the link is busy.
+	int32 DownKbps = 0;
+	int32 UpKbps = 0;
+	// Average unclean disconnects per minute of connection
+	float DisconnectsPerMinute = 0.0f;
+
+	bool IsActive() const
+	{
+		return LatencyMs > 0.0f || JitterMs > 0.0f || ReorderPercent > 0.0f || LossPercent > 0.0f ||
+			DownKbps > 0 || UpKbps > 0 || DisconnectsPerMinute > 0.0f;
+	}
+
+	// The Eon.NetSim.* console variables
+	static FSpaceTimeDBNetSimSettings FromConsoleVariables();
+
+	// Named presets ("Off", "Wifi", "LTE", "3G", "Lossy"); false if Name is unknown
+	static bool FindProfile(const FString& Name, FSpaceTimeDBNetSimSettings& OutSettings);
+	// Writes Settings to the console variables, as "Eon.NetSim.Profile <Name>" does
+	static void ApplyToConsoleVariables(const FSpaceTimeDBNetSimSettings& Settings);
+};
+
+// Wraps another transport and delays, reorders, throttles and drops its traffic
+// according to FSpaceTimeDBNetSimSettings. Time advances only through Tick(), so
+// a run against a loopback transport is repeatable for a given seed. While the
+// settings are inactive and nothing is in flight, frames pass straight through.
+// The manager puts one around every connection in non-shipping builds.
+class EON_API FSpaceTimeDBNetSimTransport : public ISpaceTimeDBTransport
+{
+public:
+	explicit FSpaceTimeDBNetSimTransport(TSharedRef<ISpaceTimeDBTransport> InInner);
+	virtual ~FSpaceTimeDBNetSimTransport() override;
+
+	virtual void Connect() override;
+	virtual void Close() override;
+	virtual bool IsConnected() const override { return bConnected; }
+	virtual void SendText(const FString& Text) override;
+	virtual void SendBinary(const uint8* Data, int32 Size) override;
+	// Frames still waiting for the simulated uplink
+	virtual int32 GetBufferedBytes() const override;
+
+	// Delivers everything due by now and rolls for a random disconnect
+	void Tick(float DeltaTime);
+
+	// Drops the connection as if the network went away: frames in flight are
+	// lost and the owner sees an unclean close.
+	void SimulateDisconnect();
+
+	// Fixed settings instead of the console variables, e.g. for automation
+	void SetSettingsOverride(const FSpaceTimeDBNetSimSettings& Settings) { SettingsOverride = Settings; }
+	void ClearSettingsOverride() { SettingsOverride.Reset(); }
+	FSpaceTimeDBNetSimSettings GetSettings() const;
+
+	void SetSeed(int32 Seed) { Random.Initialize(Seed); }
+
+	TSharedRef<ISpaceTimeDBTransport> GetInner() const { return Inner; }
+	int32 GetNumInFlight() const { return Inbound.Num() + Outbound.Num(); }
+	int32 GetNumSimulatedDisconnects() const { return NumSimulatedDisconnects; }
+
+private:
+	enum class EEvent : uint8
+	{
+		Frame,
+		Connected,
+		Error,
+		Closed
+	};
+
+	struct FPending
+	{
+		double DeliverAt = 0.0;
+		EEvent Event = EEvent::Frame;
+		bool bBinary = false;
+		bool bWasClean = false;
+		int32 StatusCode = 0;
+		TArray<uint8> Bytes;
+		// Outbound text frames, and the reason / error of close and error events
+		FString Text;
+	};
+
+	// One direction of the link
+	struct FLane
+	{
+		// Sorted by DeliverAt
+		TArray<FPending> Pending;
+		double LinkFreeAt = 0.0;
+		double LastDeliverAt = 0.0;
+		// Delivery time of the last connect / error / close, which no frame may overtake
+		double EventAt = 0.0;
+
+		int32 Num() const { return Pending.Num(); }
+	};
+
+	void Schedule(FLane& Lane, FPending&& Item, int32 Kbps, const FSpaceTimeDBNetSimSettings& Settings);
+	void DeliverInbound(FPending& Item);
+	void DeliverOutbound(FPending& Item);
+	void HandleInnerFrame(TArray<uint8>& Frame, bool bBinary);
+	void HandleInnerEvent(FPending&& Item);
+
+	TSharedRef<ISpaceTimeDBTransport> Inner;
+	TOptional<FSpaceTimeDBNetSimSettings> SettingsOverride;
+	FRandomStream Random;
+
+	FLane Inbound;
+	FLane Outbound;
+	double Now = 0.0;
+	bool bConnected = false;
+	// From a simulated drop until the next Connect(): the inner transport's events are ignored
+	bool bDropped = false;
+	int32 NumSimulatedDisconnects = 0;
+};
@@ -0,0 +1,127 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "SpaceTimeDBProtocol.h"
+#include "SpaceTimeDBStats.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+// A frame as received from the socket, before decoding. Text frames stay as
+// raw UTF-8 bytes; they are never converted to FString.
+struct FSpaceTimeDBInboundFrame
+{
+	bool bBinary = false;
+	TArray<uint8> Bytes;
+	// The manager's connection it arrived on; its decoded message carries it too
+	uint32 Generation = 0;
+};
+
+// Send lanes, most urgent first. Each flush sends the lanes in this order, and
+// under backpressure the telemetry lane is thinned out.
+enum class ESpaceTimeDBCallLane : uint8
+{
+	// Transactions the player waits on: inventory, pickups, purchases
+	Critical,
+	Gameplay,
+	// Position and other state where only the latest value matters
+	Telemetry
+};
+
+struct FSpaceTimeDBReducerCall
+{
+	FString ReducerName;
+	FSpaceTimeDBArgList Args;
+	// Set for calls the local authority already ran; reported back with the request id
+	uint32 LocalCallId = 0;
+	ESpaceTimeDBCallLane Lane = ESpaceTimeDBCallLane::Gameplay;
+};
+
+// A frame ready to hand to the socket
+struct FSpaceTimeDBOutboundFrame
+{
+	bool bBinary = false;
+	TArray<uint8> Bytes;
+	FString Text;
+	// The connection it was encoded for, and the reducer call it holds, if any,
+	// so a frame that missed its connection can be queued again for the next one
+	uint32 Generation = 0;
+	TOptional<FSpaceTimeDBReducerCall> Call;
+};
+
+// One flush worth of reducer calls. Request ids are assigned by the game thread
+// so they stay unique across the worker and subscription messages.
+struct FSpaceTimeDBCallBatch
+{
+	TArray<FSpaceTimeDBReducerCall> Calls;
+	uint32 FirstRequestId = 0;
+	bool bBinary = false;
+	uint32 Generation = 0;
+};
+
+// Decodes inbound frames and encodes outbound reducer calls on its own thread.
+// The socket itself stays on the game thread: callbacks only enqueue raw
+// frames here, and the game thread drains decoded messages and encoded frames
+// at a fixed point in its frame. All queues are lock-free (TQueue).
+class EON_API FSpaceTimeDBNetWorker : public FRunnable
+{
+public:
+	FSpaceTimeDBNetWorker();
+	virtual ~FSpaceTimeDBNetWorker() override;
+
+	// Optional; decode times are recorded into it. Set before Start().
+	void SetDecodeHistogram(FSpaceTimeDBDecodeHistogram* InHistogram) { DecodeHistogram = InHistogram; }
+
+	bool Start();
+	void Shutdown();
+	bool IsRunning() const { return Thread != nullptr; }
+
+	// Producer side (any thread)
+	void EnqueueInbound(FSpaceTimeDBInboundFrame&& Frame);
+	void EnqueueCalls(FSpaceTimeDBCallBatch&& Batch);
+
+	// Consumer side (game thread)
+	// OutGeneration receives the generation of the frame the message came from
+	bool DequeueDecoded(FSpaceTimeDBServerMessage& OutMessage, uint32* OutGeneration = nullptr);
+	bool DequeueEncoded(FSpaceTimeDBOutboundFrame& OutFrame);
+
+	int32 GetInboundDepth() const { return InboundDepth.load(std::memory_order_relaxed); }
+	int32 GetDecodedDepth() const { return DecodedDepth.load(std::memory_order_relaxed); }
+
+	// Encodes a batch of calls into frames, one call per frame. Used by the
+	// worker, and inline when the manager runs without a network thread.
+	// Each frame takes its call out of the batch.
+	static void EncodeCallBatch(FSpaceTimeDBCallBatch&& Batch, TArray<FSpaceTimeDBOutboundFrame>& OutFrames);
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FDecoded
+	{
+		FSpaceTimeDBServerMessage Message;
+		uint32 Generation = 0;
+	};
+
+	void ProcessInbound();
+	void ProcessOutbound();
+
+	TQueue<FSpaceTimeDBInboundFrame, EQueueMode::Mpsc> Inbound;
+	TQueue<FSpaceTimeDBCallBatch, EQueueMode::Mpsc> OutgoingBatches;
+	TQueue<FDecoded, EQueueMode::Mpsc> Decoded;
+	TQueue<FSpaceTimeDBOutboundFrame, EQueueMode::Mpsc> Encoded;
+
+	std::atomic<int32> InboundDepth { 0 };
+	std::atomic<int32> DecodedDepth { 0 };
+	std::atomic<bool> bStopping { false };
+
+	FSpaceTimeDBDecodeHistogram* DecodeHistogram = nullptr;
+	FEvent* WorkEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+};
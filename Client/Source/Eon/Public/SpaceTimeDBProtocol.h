@@ -0,0 +1,294 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBIdentity.h"
+#include "SpaceTimeDBRows.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "BSATN is little-endian; the Bsatn reader/writer copy scalars as-is");
+
+// ============================================================================
+// REDUCER ARGUMENTS
+// ============================================================================
+
+enum class ESpaceTimeDBArgType : uint8
+{
+	Bool,
+	U32,
+	U64,
+	F32,
+	String,
+	Identity
+};
+
+// A single reducer argument carrying its SpaceTimeDB column type, so the same
+// call can be written as a JSON string argument or as a BSATN value.
+struct EON_API FSpaceTimeDBArg
+{
+	ESpaceTimeDBArgType Type = ESpaceTimeDBArgType::Bool;
+
+	union
+	{
+		bool BoolValue;
+		uint32 U32Value;
+		uint64 U64Value;
+		float F32Value;
+	};
+
+	FString StringValue;
+	FSpaceTimeDBIdentity IdentityValue;
+
+	FSpaceTimeDBArg() : U64Value(0) {}
+
+	static FSpaceTimeDBArg Bool(bool Value);
+	static FSpaceTimeDBArg U32(uint32 Value);
+	static FSpaceTimeDBArg U64(uint64 Value);
+	static FSpaceTimeDBArg F32(float Value);
+	static FSpaceTimeDBArg String(const FString& Value);
+	static FSpaceTimeDBArg Identity(const FSpaceTimeDBIdentity& Value);
+
+	// Picked by C++ type; used by typed reducer calls
+	static FSpaceTimeDBArg From(bool Value) { return Bool(Value); }
+	static FSpaceTimeDBArg From(uint32 Value) { return U32(Value); }
+	static FSpaceTimeDBArg From(uint64 Value) { return U64(Value); }
+	static FSpaceTimeDBArg From(float Value) { return F32(Value); }
+	static FSpaceTimeDBArg From(const FString& Value) { return String(Value); }
+	static FSpaceTimeDBArg From(const FSpaceTimeDBIdentity& Value) { return Identity(Value); }
+};
+
+template <typename T>
+inline constexpr bool TIsSpaceTimeDBArgType = std::is_same_v<T, bool> || std::is_same_v<T, uint32> ||
+	std::is_same_v<T, uint64> || std::is_same_v<T, float> || std::is_same_v<T, FString> || std::is_same_v<T, FSpaceTimeDBIdentity>;
+
+// Reducer arguments stay inline for every reducer in lib.rs, so queuing a call does not allocate
+using FSpaceTimeDBArgList = TArray<FSpaceTimeDBArg, TInlineAllocator<8>>;
+
+// A reducer known at compile time: its name and argument types, mirroring a
+// #[reducer] in Server/eonserver/src/lib.rs. USpaceTimeDBManager::CallReducer
+// takes one of these and checks the arguments against ArgTypes; see
+// SpaceTimeDBReducers.h for the declarations.
+template <typename... ArgTypes>
+struct TSpaceTimeDBReducer
+{
+	static_assert((TIsSpaceTimeDBArgType<ArgTypes> && ...), "Reducer arguments must be bool, uint32, uint64, float, FString or FSpaceTimeDBIdentity");
+
+	static constexpr int32 NumArgs = sizeof...(ArgTypes);
+
+	const TCHAR* Name;
+
+	static FSpaceTimeDBArgList MakeArgs(typename TCallTraits<ArgTypes>::ParamType... Args)
+	{
+		FSpaceTimeDBArgList List;
+		(List.Add(FSpaceTimeDBArg::From(Args)), ...);
+		return List;
+	}
+};
+
+// ============================================================================
+// BSATN READER / WRITER
+// ============================================================================
+
+class EON_API FBsatnWriter
+{
+public:
+	explicit FBsatnWriter(TArray<uint8>& InBuffer) : Buffer(InBuffer) {}
+
+	void WriteU8(uint8 Value) { Buffer.Add(Value); }
+	void WriteBool(bool Value) { WriteU8(Value ? 1 : 0); }
+	void WriteU16(uint16 Value) { WriteRaw(&Value, sizeof(Value)); }
+	void WriteU32(uint32 Value) { WriteRaw(&Value, sizeof(Value)); }
+	void WriteU64(uint64 Value) { WriteRaw(&Value, sizeof(Value)); }
+	void WriteI64(int64 Value) { WriteRaw(&Value, sizeof(Value)); }
+	void WriteF32(float Value) { WriteRaw(&Value, sizeof(Value)); }
+	void WriteString(const FString& Value);
+	void WriteBytes(const uint8* Data, int32 Size);
+	void WriteRaw(const void* Data, int32 Size);
+
+	// Length-prefixed blocks (e.g. reducer args) are written by reserving the
+	// u32 prefix, writing the payload, then patching the prefix.
+	int32 BeginLengthPrefixed();
+	void EndLengthPrefixed(int32 PrefixOffset);
+
+	int32 Tell() const { return Buffer.Num(); }
+
+private:
+	TArray<uint8>& Buffer;
+};
+
+// Reads BSATN values from a borrowed buffer. Errors are sticky, like FArchive:
+// once a read runs past the end every later read returns zero and IsError() is true.
+class EON_API FBsatnReader
+{
+public:
+	FBsatnReader(const uint8* InData, int32 InSize) : Data(InData), Size(InSize) {}
+
+	uint8 ReadU8();
+	bool ReadBool() { return ReadU8() != 0; }
+	uint16 ReadU16();
+	uint32 ReadU32();
+	uint64 ReadU64();
+	int64 ReadI64();
+	float ReadF32();
+	FString ReadString();
+	// Returns a view into the underlying buffer; valid as long as the buffer is.
+	TArrayView<const uint8> ReadBytes();
+	void ReadRaw(void* Out, int32 Count);
+	void Skip(int32 Count);
+
+	bool IsError() const { return bError; }
+	bool AtEnd() const { return Offset >= Size; }
+	int32 Remaining() const { return Size - Offset; }
+
+private:
+	bool Require(int32 Count);
+
+	const uint8* Data = nullptr;
+	int32 Size = 0;
+	int32 Offset = 0;
+	bool bError = false;
+};
+
+// ============================================================================
+// UTF-8 JSON READER
+// ============================================================================
+
+// Pull-style reader over a raw UTF-8 JSON frame: values are read in document
+// order straight into the caller's structs, without building an FJsonObject
+// tree. Keys are reported as hashes so callers can switch on HashKey("name").
+// Errors are sticky, like FBsatnReader. Separators are checked loosely; this
+// parses trusted server frames, it does not validate JSON.
+class EON_API FUtf8JsonReader
+{
+public:
+	FUtf8JsonReader(const uint8* InData, int32 InSize) : Data(InData), Size(InSize) {}
+
+	// FNV-1a over the raw bytes of a key or short string value
+	static constexpr uint32 HashKey(const char* Key)
+	{
+		uint32 Hash = 2166136261u;
+		for (; *Key; ++Key)
+		{
+			Hash = (Hash ^ static_cast<uint8>(*Key)) * 16777619u;
+		}
+		return Hash;
+	}
+	static uint32 HashKey(const uint8* Bytes, int32 Count);
+
+	// Containers: call NextKey / NextElement until they return false at the closing bracket
+	bool BeginObject();
+	bool NextKey(uint32& OutKeyHash);
+	bool BeginArray();
+	bool NextElement();
+
+	// First character of the next value ('{', '[', '"', 't', 'n', '-', digit...), or 0 at the end
+	uint8 PeekChar();
+
+	FString ReadString();
+	// Hex identity string; anything that is not valid hex fails the read. Nothing is allocated
+	FSpaceTimeDBIdentity ReadIdentity();
+	// Hash of a string value, for enum-like fields; nothing is allocated
+	uint32 ReadStringHash();
+	bool ReadBool();
+	// Numbers may also arrive quoted, as large u64 ids often are
+	double ReadDouble();
+	float ReadFloat() { return static_cast<float>(ReadDouble()); }
+	uint64 ReadU64();
+	uint32 ReadU32() { return static_cast<uint32>(ReadU64()); }
+	int64 ReadI64();
+	// Consumes a null literal if one is next
+	bool TryReadNull();
+	void SkipValue();
+
+	int32 Tell() const { return Offset; }
+	void Seek(int32 InOffset) { Offset = InOffset; }
+	bool IsError() const { return bError; }
+
+private:
+	void SkipWhitespace();
+	bool Consume(uint8 Char);
+	bool ConsumeLiteral(const char* Literal);
+	// Scans a string token, leaving Offset after the closing quote
+	bool ScanString(int32& OutStart, int32& OutEnd, bool& bOutEscaped);
+	// Scans a number token (quoted or bare) into a null-terminated buffer
+	bool ScanNumber(ANSICHAR (&OutBuffer)[64], int32& OutLength);
+	void SkipValue(int32 Depth);
+	void SetError();
+
+	const uint8* Data = nullptr;
+	int32 Size = 0;
+	int32 Offset = 0;
+	bool bError = false;
+};
+
+// ============================================================================
+// DECODED SERVER MESSAGES
+// ============================================================================
+
+enum class ESpaceTimeDBMessageType : uint8
+{
+	Unknown,
+	IdentityToken,
+	InitialSubscription,
+	TransactionUpdate
+};
+
+struct FSpaceTimeDBServerMessage
+{
+	ESpaceTimeDBMessageType Type = ESpaceTimeDBMessageType::Unknown;
+	FSpaceTimeDBIdentity Identity;
+
+	// IdentityToken only: presented on reconnect so the server keeps our identity
+	FString Token;
+
+	// Set on transaction updates caused by a reducer call: the caller (when the
+	// server reports it) and the request id it sent. RequestId 0 means none.
+	FSpaceTimeDBIdentity CallerIdentity;
+	uint32 RequestId = 0;
+
+	// When the server ran the transaction, in microseconds since the Unix epoch; 0 if not sent
+	int64 TimestampMicros = 0;
+
+	TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBPlayerRow>> Players;
+	TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>> InventoryItems;
+	TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBInstanceRow>> Instances;
+	TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBWorldItemRow>> WorldItems;
+	TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBInteractableRow>> Interactables;
+	TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBItemDefinitionRow>> ItemDefinitions;
+};
+
+// ============================================================================
+// PROTOCOL ENCODE / DECODE
+// ============================================================================
+
+struct EON_API FSpaceTimeDBProtocol
+{
+	static const TCHAR* JsonSubprotocol;
+	static const TCHAR* BinarySubprotocol;
+
+	// Text frames: {"call": name, "args": ["..."], "request_id": n}, {"subscribe": query} and {"unsubscribe": query}.
+	// The server echoes request_id on the resulting TransactionUpdate.
+	// Reducer calls are appended to OutFrame directly, with no intermediate strings.
+	// Arguments are written as JSON strings, which the server parses per its column type.
+	static void EncodeReducerCallJson(const FString& ReducerName, TArrayView<const FSpaceTimeDBArg> Args, uint32 RequestId, FString& OutFrame);
+	static void EncodeSubscribeJson(const FString& Query, FString& OutFrame);
+	static void EncodeUnsubscribeJson(const FString& Query, FString& OutFrame);
+
+	// Binary frames: BSATN ClientMessage::CallReducer / ClientMessage::Subscribe.
+	// Frames are appended to OutFrame so callers can reuse one buffer.
+	static void EncodeReducerCallBinary(const FString& ReducerName, TArrayView<const FSpaceTimeDBArg> Args, uint32 RequestId, TArray<uint8>& OutFrame);
+	static void EncodeSubscribeBinary(TArrayView<const FString> Queries, uint32 RequestId, TArray<uint8>& OutFrame);
+
+	// Text frames are decoded from their raw UTF-8 bytes; the FString overload converts first
+	static bool DecodeJsonServerMessage(const uint8* Data, int32 Size, FSpaceTimeDBServerMessage& OutMessage);
+	static bool DecodeJsonServerMessage(const FString& Message, FSpaceTimeDBServerMessage& OutMessage);
+	static bool DecodeBinaryServerMessage(const uint8* Data, int32 Size, FSpaceTimeDBServerMessage& OutMessage);
+
+	// If the frame is an IdentityToken message, OutFrame receives a copy with an
+	// empty token, for anything that stores frames (captures). False otherwise.
+	static bool RedactIdentityToken(const uint8* Data, int32 Size, bool bBinary, TArray<uint8>& OutFrame);
+
+	// Compatibility encoding for the dynamic string delegates
+	static FString PlayerRowToJson(const FSpaceTimeDBPlayerRow& Row);
+	static FString InventoryRowToJson(const FSpaceTimeDBInventoryRow& Row);
+};
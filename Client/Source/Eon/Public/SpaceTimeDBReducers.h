@@ -0,0 +1,44 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBProtocol.h"
+
+// Reducers of the eon module (Server/eonserver/src/lib.rs), for
+// USpaceTimeDBManager::CallReducer. A wrong argument count or type is a compile
+// error. Keep in step with the #[reducer] signatures on the server.
+namespace EonReducers
+{
+	// Instances
+	inline constexpr TSpaceTimeDBReducer<FString, uint32, bool> CreateInstance { TEXT("create_instance") };
+	inline constexpr TSpaceTimeDBReducer<uint64> DeleteInstance { TEXT("delete_instance") };
+	inline constexpr TSpaceTimeDBReducer<uint64> JoinInstance { TEXT("join_instance") };
+	inline constexpr TSpaceTimeDBReducer<> LeaveInstance { TEXT("leave_instance") };
+
+	// Players
+	inline constexpr TSpaceTimeDBReducer<FString> RegisterPlayer { TEXT("register_player") };
+	inline constexpr TSpaceTimeDBReducer<bool> SetPlayerOnline { TEXT("set_player_online") };
+	// x, y, z, pitch, yaw, roll
+	inline constexpr TSpaceTimeDBReducer<float, float, float, float, float, float> UpdatePlayerPosition { TEXT("update_player_position") };
+	// position, orientation packed by FEonTransformCodec
+	inline constexpr TSpaceTimeDBReducer<uint64, uint32> UpdatePlayerTransform { TEXT("update_player_transform") };
+	inline constexpr TSpaceTimeDBReducer<float> UpdatePlayerHealth { TEXT("update_player_health") };
+
+	// Inventory and world
+	inline constexpr TSpaceTimeDBReducer<FString, uint32> AddItemToInventory { TEXT("add_item_to_inventory") };
+	inline constexpr TSpaceTimeDBReducer<uint64, uint32> RemoveItemFromInventory { TEXT("remove_item_from_inventory") };
+	inline constexpr TSpaceTimeDBReducer<uint64> UseConsumable { TEXT("use_consumable") };
+	inline constexpr TSpaceTimeDBReducer<uint64> CollectWorldItem { TEXT("collect_world_item") };
+	inline constexpr TSpaceTimeDBReducer<FString> ToggleInteractable { TEXT("toggle_interactable") };
+
+	// Premium
+	inline constexpr TSpaceTimeDBReducer<uint64, FString> AddPremiumCurrency { TEXT("add_premium_currency") };
+	inline constexpr TSpaceTimeDBReducer<FString> PurchasePremiumItem { TEXT("purchase_premium_item") };
+	inline constexpr TSpaceTimeDBReducer<> ReclaimPremiumItems { TEXT("reclaim_premium_items") };
+	inline constexpr TSpaceTimeDBReducer<> GetWalletBalance { TEXT("get_wallet_balance") };
+	// item_id, recipient
+	inline constexpr TSpaceTimeDBReducer<FString, FSpaceTimeDBIdentity> GiftPremiumItem { TEXT("gift_premium_item") };
+	// recipient, item_id, reason
+	inline constexpr TSpaceTimeDBReducer<FSpaceTimeDBIdentity, FString, FString> AdminGrantPremiumItem { TEXT("admin_grant_premium_item") };
+}
@@ -0,0 +1,57 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBSchema.h"
+
+// Client-side mirrors of the tables in Server/eonserver/src/lib.rs, generated into
+// SpaceTimeDBSchema.h by Scripts/generate_spacetimedb_schema.py. Rows are
+// decoded once by the manager and handed to listeners by const reference.
+// Each row exposes its #[primary_key] column through KeyType / GetKey(), and
+// compares by value (strings case-sensitively) so resyncs can skip rows that did not change.
+
+enum class ESpaceTimeDBRowOp : uint8
+{
+	Upsert,
+	Delete
+};
+
+template <typename RowType>
+struct TSpaceTimeDBRowUpdate
+{
+	RowType Row;
+	ESpaceTimeDBRowOp Op = ESpaceTimeDBRowOp::Upsert;
+};
+
+// Hashing for primary keys. SpaceTimeDB String keys are case-sensitive, but
+// UE's FString key funcs ignore case, so string keys get their own.
+template <typename KeyType, typename ValueType>
+struct TSpaceTimeDBMapKeyFuncs : TDefaultMapHashableKeyFuncs<KeyType, ValueType, false>
+{
+};
+
+template <typename ValueType>
+struct TSpaceTimeDBMapKeyFuncs<FString, ValueType> : TDefaultMapHashableKeyFuncs<FString, ValueType, false>
+{
+	static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+};
+
+template <typename KeyType>
+struct TSpaceTimeDBSetKeyFuncs : DefaultKeyFuncs<KeyType>
+{
+};
+
+template <>
+struct TSpaceTimeDBSetKeyFuncs<FString> : DefaultKeyFuncs<FString>
+{
+	static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+};
+
+template <typename KeyType, typename ValueType>
+using TSpaceTimeDBKeyMap = TMap<KeyType, ValueType, FDefaultSetAllocator, TSpaceTimeDBMapKeyFuncs<KeyType, ValueType>>;
+
+template <typename KeyType>
+using TSpaceTimeDBKeySet = TSet<KeyType, TSpaceTimeDBSetKeyFuncs<KeyType>>;
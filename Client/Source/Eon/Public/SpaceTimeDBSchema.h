@@ -0,0 +1,261 @@
+// Copyright 2026 tbassignana. MIT License.
+
+// Generated by Scripts/generate_spacetimedb_schema.py from Server/eonserver/src/lib.rs.
+// Do not edit; change the server tables and rerun the script.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBIdentity.h"
+
+// Hash of the mirrored tables' columns; changes whenever the generated code does
+constexpr uint32 SpaceTimeDBSchemaHash = 0x9e5f0dbb;
+
+struct FSpaceTimeDBInstanceRow
+{
+	uint64 InstanceId = 0;
+	FString Name;
+	uint32 MaxPlayers = 0;
+	bool bIsPublic = false;
+	int64 CreatedAtMicros = 0;
+	FSpaceTimeDBIdentity OwnerIdentity;
+
+	static constexpr const TCHAR* TableName = TEXT("instance");
+
+	// Server columns in declaration order, which is also the BSATN field order
+	enum class EColumn : uint8
+	{
+		InstanceId,
+		Name,
+		MaxPlayers,
+		IsPublic,
+		CreatedAt,
+		OwnerIdentity,
+		Num
+	};
+	static constexpr const ANSICHAR* ColumnNames[] = { "instance_id", "name", "max_players", "is_public", "created_at", "owner_identity" };
+
+	using KeyType = uint64;
+	uint64 GetKey() const { return InstanceId; }
+
+	bool operator==(const FSpaceTimeDBInstanceRow& Other) const
+	{
+		return InstanceId == Other.InstanceId &&
+			Name.Equals(Other.Name, ESearchCase::CaseSensitive) &&
+			MaxPlayers == Other.MaxPlayers &&
+			bIsPublic == Other.bIsPublic &&
+			CreatedAtMicros == Other.CreatedAtMicros &&
+			OwnerIdentity == Other.OwnerIdentity;
+	}
+};
+
+struct FSpaceTimeDBPlayerRow
+{
+	FSpaceTimeDBIdentity Identity;
+	FString Username;
+	TOptional<uint64> InstanceId;
+	FVector3f Position = FVector3f::ZeroVector;
+	FRotator3f Rotation = FRotator3f::ZeroRotator;
+	float Health = 100.0f;
+	float MaxHealth = 100.0f;
+	bool bIsOnline = false;
+	int64 LastSeenMicros = 0;
+
+	static constexpr const TCHAR* TableName = TEXT("player");
+
+	// Server columns in declaration order, which is also the BSATN field order
+	enum class EColumn : uint8
+	{
+		Identity,
+		Username,
+		InstanceId,
+		PositionX,
+		PositionY,
+		PositionZ,
+		RotationPitch,
+		RotationYaw,
+		RotationRoll,
+		Health,
+		MaxHealth,
+		IsOnline,
+		LastSeen,
+		Num
+	};
+	static constexpr const ANSICHAR* ColumnNames[] = { "identity", "username", "instance_id", "position_x", "position_y", "position_z", "rotation_pitch", "rotation_yaw", "rotation_roll", "health", "max_health", "is_online", "last_seen" };
+
+	using KeyType = FSpaceTimeDBIdentity;
+	const FSpaceTimeDBIdentity& GetKey() const { return Identity; }
+
+	bool operator==(const FSpaceTimeDBPlayerRow& Other) const
+	{
+		return Identity == Other.Identity &&
+			Username.Equals(Other.Username, ESearchCase::CaseSensitive) &&
+			InstanceId == Other.InstanceId &&
+			Position == Other.Position &&
+			Rotation == Other.Rotation &&
+			Health == Other.Health &&
+			MaxHealth == Other.MaxHealth &&
+			bIsOnline == Other.bIsOnline &&
+			LastSeenMicros == Other.LastSeenMicros;
+	}
+};
+
+struct FSpaceTimeDBItemDefinitionRow
+{
+	FString ItemId;
+	FString DisplayName;
+	FString Description;
+	FString ItemType;
+	uint32 MaxStack = 0;
+	FString IconPath;
+	bool bIsPremium = false;
+	// Price in premium currency (0 = not for sale)
+	uint32 PremiumCurrencyPrice = 0;
+	// True = can only be obtained via cash shop
+	bool bIsExclusive = false;
+	// 0=Common, 1=Uncommon, 2=Rare, 3=Epic, 4=Legendary
+	uint8 Rarity = 0;
+
+	static constexpr const TCHAR* TableName = TEXT("item_definition");
+
+	// Server columns in declaration order, which is also the BSATN field order
+	enum class EColumn : uint8
+	{
+		ItemId,
+		DisplayName,
+		Description,
+		ItemType,
+		MaxStack,
+		IconPath,
+		IsPremium,
+		PremiumCurrencyPrice,
+		IsExclusive,
+		Rarity,
+		Num
+	};
+	static constexpr const ANSICHAR* ColumnNames[] = { "item_id", "display_name", "description", "item_type", "max_stack", "icon_path", "is_premium", "premium_currency_price", "is_exclusive", "rarity" };
+
+	using KeyType = FString;
+	const FString& GetKey() const { return ItemId; }
+
+	bool operator==(const FSpaceTimeDBItemDefinitionRow& Other) const
+	{
+		return ItemId.Equals(Other.ItemId, ESearchCase::CaseSensitive) &&
+			DisplayName.Equals(Other.DisplayName, ESearchCase::CaseSensitive) &&
+			Description.Equals(Other.Description, ESearchCase::CaseSensitive) &&
+			ItemType.Equals(Other.ItemType, ESearchCase::CaseSensitive) &&
+			MaxStack == Other.MaxStack &&
+			IconPath.Equals(Other.IconPath, ESearchCase::CaseSensitive) &&
+			bIsPremium == Other.bIsPremium &&
+			PremiumCurrencyPrice == Other.PremiumCurrencyPrice &&
+			bIsExclusive == Other.bIsExclusive &&
+			Rarity == Other.Rarity;
+	}
+};
+
+struct FSpaceTimeDBInventoryRow
+{
+	uint64 EntryId = 0;
+	FSpaceTimeDBIdentity OwnerIdentity;
+	FString ItemId;
+	uint32 Quantity = 0;
+	uint32 SlotIndex = 0;
+
+	static constexpr const TCHAR* TableName = TEXT("inventory_item");
+
+	// Server columns in declaration order, which is also the BSATN field order
+	enum class EColumn : uint8
+	{
+		EntryId,
+		OwnerIdentity,
+		ItemId,
+		Quantity,
+		SlotIndex,
+		Num
+	};
+	static constexpr const ANSICHAR* ColumnNames[] = { "entry_id", "owner_identity", "item_id", "quantity", "slot_index" };
+
+	using KeyType = uint64;
+	uint64 GetKey() const { return EntryId; }
+
+	bool operator==(const FSpaceTimeDBInventoryRow& Other) const
+	{
+		return EntryId == Other.EntryId &&
+			OwnerIdentity == Other.OwnerIdentity &&
+			ItemId.Equals(Other.ItemId, ESearchCase::CaseSensitive) &&
+			Quantity == Other.Quantity &&
+			SlotIndex == Other.SlotIndex;
+	}
+};
+
+struct FSpaceTimeDBWorldItemRow
+{
+	uint64 WorldItemId = 0;
+	uint64 InstanceId = 0;
+	FString ItemId;
+	uint32 Quantity = 0;
+	FVector3f Position = FVector3f::ZeroVector;
+	bool bIsCollected = false;
+
+	static constexpr const TCHAR* TableName = TEXT("world_item");
+
+	// Server columns in declaration order, which is also the BSATN field order
+	enum class EColumn : uint8
+	{
+		WorldItemId,
+		InstanceId,
+		ItemId,
+		Quantity,
+		PositionX,
+		PositionY,
+		PositionZ,
+		IsCollected,
+		Num
+	};
+	static constexpr const ANSICHAR* ColumnNames[] = { "world_item_id", "instance_id", "item_id", "quantity", "position_x", "position_y", "position_z", "is_collected" };
+
+	using KeyType = uint64;
+	uint64 GetKey() const { return WorldItemId; }
+
+	bool operator==(const FSpaceTimeDBWorldItemRow& Other) const
+	{
+		return WorldItemId == Other.WorldItemId &&
+			InstanceId == Other.InstanceId &&
+			ItemId.Equals(Other.ItemId, ESearchCase::CaseSensitive) &&
+			Quantity == Other.Quantity &&
+			Position == Other.Position &&
+			bIsCollected == Other.bIsCollected;
+	}
+};
+
+struct FSpaceTimeDBInteractableRow
+{
+	FString InteractableId;
+	uint64 InstanceId = 0;
+	bool bIsActive = false;
+	FString StateData;
+
+	static constexpr const TCHAR* TableName = TEXT("interactable_state");
+
+	// Server columns in declaration order, which is also the BSATN field order
+	enum class EColumn : uint8
+	{
+		InteractableId,
+		InstanceId,
+		IsActive,
+		StateData,
+		Num
+	};
+	static constexpr const ANSICHAR* ColumnNames[] = { "interactable_id", "instance_id", "is_active", "state_data" };
+
+	using KeyType = FString;
+	const FString& GetKey() const { return InteractableId; }
+
+	bool operator==(const FSpaceTimeDBInteractableRow& Other) const
+	{
+		return InteractableId.Equals(Other.InteractableId, ESearchCase::CaseSensitive) &&
+			InstanceId == Other.InstanceId &&
+			bIsActive == Other.bIsActive &&
+			StateData.Equals(Other.StateData, ESearchCase::CaseSensitive);
+	}
+};
@@ -0,0 +1,32 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include <atomic>
+
+// Networking stats for the SpaceTimeDB client. View in game with "stat EonNet".
+DECLARE_STATS_GROUP(TEXT("EonNet"), STATGROUP_EonNet, STATCAT_Advanced);
+
+// Counts decode times into fixed buckets. Written by whichever thread decodes
+// (the network worker or the game thread), read by the manager's stats API.
+class EON_API FSpaceTimeDBDecodeHistogram
+{
+public:
+	static constexpr int32 NumBuckets = 8;
+
+	// Upper bound of each bucket in microseconds; the last bucket is open-ended
+	static const float BucketBoundsMicros[NumBuckets];
+
+	void Record(double Seconds);
+	void Snapshot(TArray<int32>& OutCounts) const;
+	void Reset();
+
+	// Sum of every recorded decode
+	double GetTotalMs() const { return TotalMicros.load(std::memory_order_relaxed) / 1000.0; }
+
+private:
+	std::atomic<uint32> Counts[NumBuckets] {};
+	std::atomic<uint64> TotalMicros { 0 };
+};
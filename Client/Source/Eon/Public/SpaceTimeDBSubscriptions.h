@@ -0,0 +1,39 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBIdentity.h"
+
+// Tracks which queries the client should be subscribed to and which ones the
+// server already has. Per-instance tables (player, world_item,
+// interactable_state) are scoped to the instance the local player is in, so
+// the client only downloads rows for that instance.
+class EON_API FSpaceTimeDBSubscriptions
+{
+public:
+	void SetIdentity(const FSpaceTimeDBIdentity& InIdentity) { Identity = InIdentity; }
+	const FSpaceTimeDBIdentity& GetIdentity() const { return Identity; }
+
+	void SetInstance(TOptional<uint64> InInstanceId) { InstanceId = InInstanceId; }
+	TOptional<uint64> GetInstance() const { return InstanceId; }
+
+	// The full query set for the current identity and instance
+	TArray<FString> BuildQueries() const;
+
+	// Compares BuildQueries() with the committed set. Returns false if nothing changed.
+	bool Diff(TArray<FString>& OutAdded, TArray<FString>& OutRemoved) const;
+
+	// Marks the desired set as active on the server
+	void Commit() { ActiveQueries = BuildQueries(); }
+
+	// Forget what the server has (e.g. after a reconnect); identity and instance are kept
+	void ResetActive() { ActiveQueries.Reset(); }
+
+	const TArray<FString>& GetActiveQueries() const { return ActiveQueries; }
+
+private:
+	FSpaceTimeDBIdentity Identity;
+	TOptional<uint64> InstanceId;
+	TArray<FString> ActiveQueries;
+};
@@ -0,0 +1,164 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceTimeDBRows.h"
+
+class USpaceTimeDBTableCache;
+
+// One replicated table: rows live in a contiguous array, with a hash index from
+// primary key to array slot. Deletes swap the last row into the freed slot, so
+// row order is not stable and pointers returned by Find() are only valid until
+// the next applied update.
+template <typename RowType>
+class TSpaceTimeDBTable
+{
+public:
+	using KeyType = typename RowType::KeyType;
+
+	int32 Num() const { return Rows.Num(); }
+	TArrayView<const RowType> GetRows() const { return Rows; }
+
+	const RowType* Find(const KeyType& Key) const
+	{
+		const int32* Index = KeyToIndex.Find(Key);
+		return Index ? &Rows[*Index] : nullptr;
+	}
+
+	bool Contains(const KeyType& Key) const { return KeyToIndex.Contains(Key); }
+
+	// Row-level change callbacks, fired after the table has been modified
+	TMulticastDelegate<void(const RowType& /*Row*/)> OnInsert;
+	TMulticastDelegate<void(const RowType& /*OldRow*/, const RowType& /*NewRow*/)> OnUpdate;
+	TMulticastDelegate<void(const RowType& /*Row*/)> OnDelete;
+
+private:
+	friend class USpaceTimeDBTableCache;
+
+	void Apply(const TSpaceTimeDBRowUpdate<RowType>& Update)
+	{
+		if (Update.Op == ESpaceTimeDBRowOp::Delete)
+		{
+			Remove(Update.Row.GetKey());
+		}
+		else
+		{
+			Upsert(Update.Row);
+		}
+	}
+
+	void Upsert(const RowType& Row)
+	{
+		if (const int32* Index = KeyToIndex.Find(Row.GetKey()))
+		{
+			// Resyncs resend every row; only real changes reach listeners
+			if (Rows[*Index] == Row)
+			{
+				return;
+			}
+
+			if (OnUpdate.IsBound())
+			{
+				const RowType OldRow = MoveTemp(Rows[*Index]);
+				Rows[*Index] = Row;
+				OnUpdate.Broadcast(OldRow, Rows[*Index]);
+			}
+			else
+			{
+				Rows[*Index] = Row;
+			}
+			return;
+		}
+
+		const int32 NewIndex = Rows.Add(Row);
+		KeyToIndex.Add(Row.GetKey(), NewIndex);
+		OnInsert.Broadcast(Rows[NewIndex]);
+	}
+
+	bool Remove(const KeyType& Key)
+	{
+		int32 Index = INDEX_NONE;
+		if (!KeyToIndex.RemoveAndCopyValue(Key, Index))
+		{
+			return false;
+		}
+
+		const RowType Removed = MoveTemp(Rows[Index]);
+		Rows.RemoveAtSwap(Index);
+		if (Rows.IsValidIndex(Index))
+		{
+			KeyToIndex.FindChecked(Rows[Index].GetKey()) = Index;
+		}
+
+		OnDelete.Broadcast(Removed);
+		return true;
+	}
+
+	// Deletes every row matching the predicate, firing OnDelete for each
+	template <typename PredicateType>
+	int32 RemoveWhere(PredicateType Predicate)
+	{
+		TArray<KeyType> Keys;
+		for (const RowType& Row : Rows)
+		{
+			if (Predicate(Row))
+			{
+				Keys.Add(Row.GetKey());
+			}
+		}
+
+		for (const KeyType& Key : Keys)
+		{
+			Remove(Key);
+		}
+		return Keys.Num();
+	}
+
+	// A snapshot is the complete contents of the table: rows it does not
+	// mention are deleted, the rest are upserted.
+	void ApplySnapshot(TArrayView<const TSpaceTimeDBRowUpdate<RowType>> Updates)
+	{
+		RemoveMissing(Updates);
+		for (const TSpaceTimeDBRowUpdate<RowType>& Update : Updates)
+		{
+			Apply(Update);
+		}
+	}
+
+	// First half of ApplySnapshot: deletes rows the snapshot does not mention and
+	// reserves room for the rest, which the caller may then apply in slices
+	void RemoveMissing(TArrayView<const TSpaceTimeDBRowUpdate<RowType>> Updates)
+	{
+		TSpaceTimeDBKeySet<KeyType> Present;
+		Present.Reserve(Updates.Num());
+		for (const TSpaceTimeDBRowUpdate<RowType>& Update : Updates)
+		{
+			if (Update.Op != ESpaceTimeDBRowOp::Delete)
+			{
+				Present.Add(Update.Row.GetKey());
+			}
+		}
+
+		for (int32 i = Rows.Num() - 1; i >= 0; --i)
+		{
+			if (!Present.Contains(Rows[i].GetKey()))
+			{
+				const KeyType Key = Rows[i].GetKey();
+				Remove(Key);
+			}
+		}
+
+		Rows.Reserve(Present.Num());
+		KeyToIndex.Reserve(Present.Num());
+	}
+
+	void Reset()
+	{
+		Rows.Reset();
+		KeyToIndex.Reset();
+	}
+
+	TArray<RowType> Rows;
+	TSpaceTimeDBKeyMap<KeyType, int32> KeyToIndex;
+};
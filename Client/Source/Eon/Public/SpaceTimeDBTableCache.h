@@ -0,0 +1,123 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "SpaceTimeDBTable.h"
+#include "SpaceTimeDBProtocol.h"
+#include "SpaceTimeDBTableCache.generated.h"
+
+class USpaceTimeDBManager;
+
+// Client-side mirror of every table the manager subscribes to. Rows are applied
+// in place as server messages arrive, so gameplay code can query by primary key
+// instead of keeping its own copy. Large batches (an initial subscription after
+// connecting or joining an instance) are applied over several frames under a
+// time budget; tables are partially filled until OnSnapshotComplete fires.
+UCLASS()
+class EON_API USpaceTimeDBTableCache : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Tables (C++ only). Bind to OnInsert/OnUpdate/OnDelete for row-level changes.
+	TSpaceTimeDBTable<FSpaceTimeDBPlayerRow>& Players() { return PlayerTable; }
+	TSpaceTimeDBTable<FSpaceTimeDBInventoryRow>& InventoryItems() { return InventoryTable; }
+	TSpaceTimeDBTable<FSpaceTimeDBInstanceRow>& Instances() { return InstanceTable; }
+	TSpaceTimeDBTable<FSpaceTimeDBWorldItemRow>& WorldItems() { return WorldItemTable; }
+	TSpaceTimeDBTable<FSpaceTimeDBInteractableRow>& Interactables() { return InteractableTable; }
+	TSpaceTimeDBTable<FSpaceTimeDBItemDefinitionRow>& ItemDefinitions() { return ItemDefinitionTable; }
+
+	const TSpaceTimeDBTable<FSpaceTimeDBPlayerRow>& Players() const { return PlayerTable; }
+	const TSpaceTimeDBTable<FSpaceTimeDBInventoryRow>& InventoryItems() const { return InventoryTable; }
+	const TSpaceTimeDBTable<FSpaceTimeDBInstanceRow>& Instances() const { return InstanceTable; }
+	const TSpaceTimeDBTable<FSpaceTimeDBWorldItemRow>& WorldItems() const { return WorldItemTable; }
+	const TSpaceTimeDBTable<FSpaceTimeDBInteractableRow>& Interactables() const { return InteractableTable; }
+	const TSpaceTimeDBTable<FSpaceTimeDBItemDefinitionRow>& ItemDefinitions() const { return ItemDefinitionTable; }
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Cache")
+	int32 GetPlayerRowCount() const { return PlayerTable.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Cache")
+	int32 GetWorldItemRowCount() const { return WorldItemTable.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Cache")
+	bool IsInteractableActive(const FString& InteractableId) const;
+
+	UFUNCTION(BlueprintCallable, Category = "SpaceTimeDB|Cache")
+	bool IsApplyingUpdates() const { return PendingApplies.Num() > 0; }
+
+	// Drops every cached row and pending update without firing delete callbacks
+	void Reset();
+
+	// Per-frame time budget for applying queued rows. Batches smaller than
+	// MinRowsToTimeSlice, or any batch when the budget is 0, apply on arrival.
+	void SetApplyBudget(float BudgetMs, int32 MinRowsToTimeSlice);
+
+	// Applies one decoded server message to the tables, or queues it if it is large
+	void ApplyServerMessage(const FSpaceTimeDBServerMessage& Message);
+
+	// Applies queued rows until this frame's budget is spent. Called by the
+	// cache's ticker; always makes some progress even with a tiny budget.
+	// Arrivals and the ticker share one budget per frame.
+	void ProcessPendingUpdates();
+
+	// Drops rows that belong to other instances once the local player has moved
+	void HandleInstanceChanged(TOptional<uint64> InstanceId);
+
+	// Fired once after a whole server message has been applied
+	FSimpleMulticastDelegate OnCacheUpdated;
+
+	// Fired when every row of an initial subscription has been applied
+	FSimpleMulticastDelegate OnSnapshotComplete;
+
+private:
+	// A message still being applied, or an instance purge queued behind one
+	struct FPendingApply
+	{
+		FSpaceTimeDBServerMessage Message;
+		bool bSnapshot = false;
+		bool bInstanceChange = false;
+		TOptional<uint64> InstanceId;
+
+		// Progress: current table, and rows of it applied so far
+		int32 TableIndex = 0;
+		int32 RowIndex = 0;
+	};
+
+	template <typename RowType>
+	static void ApplyTable(TSpaceTimeDBTable<RowType>& Table, const TArray<TSpaceTimeDBRowUpdate<RowType>>& Updates, bool bSnapshot);
+
+	template <typename RowType>
+	static bool ApplyTableSlice(TSpaceTimeDBTable<RowType>& Table, const TArray<TSpaceTimeDBRowUpdate<RowType>>& Updates, bool bSnapshot, int32& RowIndex, double Deadline);
+
+	// When this frame's apply budget runs out; stamped by the first apply of each frame
+	double GetFrameDeadline();
+	bool ApplyPendingSlice(FPendingApply& Pending, double Deadline);
+	void FinishMessage(bool bSnapshot);
+	void PurgeOtherInstances(TOptional<uint64> InstanceId);
+	bool TickPendingUpdates(float DeltaTime);
+
+	TSpaceTimeDBTable<FSpaceTimeDBPlayerRow> PlayerTable;
+	TSpaceTimeDBTable<FSpaceTimeDBInventoryRow> InventoryTable;
+	TSpaceTimeDBTable<FSpaceTimeDBInstanceRow> InstanceTable;
+	TSpaceTimeDBTable<FSpaceTimeDBWorldItemRow> WorldItemTable;
+	TSpaceTimeDBTable<FSpaceTimeDBInteractableRow> InteractableTable;
+	TSpaceTimeDBTable<FSpaceTimeDBItemDefinitionRow> ItemDefinitionTable;
+
+	TArray<FPendingApply> PendingApplies;
+	FTSTicker::FDelegateHandle ApplyTickerHandle;
+	float ApplyBudgetMs = 2.0f;
+	int32 MinRowsToTimeSlice = 256;
+	uint64 DeadlineFrame = MAX_uint64;
+	double FrameDeadline = 0.0;
+
+	TWeakObjectPtr<USpaceTimeDBManager> Manager;
+	FDelegateHandle ServerMessageHandle;
+	FDelegateHandle InstanceChangedHandle;
+};
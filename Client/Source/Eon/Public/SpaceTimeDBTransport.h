@@ -0,0 +1,132 @@
+// Copyright 2026 tbassignana. MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IWebSocket;
+
+// Transport events. A transport has exactly one owner (the manager), so these are
+// single-cast. All of them fire on the game thread.
+DECLARE_DELEGATE(FOnSpaceTimeDBTransportConnected);
+DECLARE_DELEGATE_OneParam(FOnSpaceTimeDBTransportError, const FString& /*Error*/);
+DECLARE_DELEGATE_ThreeParams(FOnSpaceTimeDBTransportClosed, int32 /*StatusCode*/, const FString& /*Reason*/, bool /*bWasClean*/);
+
+// One complete frame (fragments already joined). Text frames are raw UTF-8.
+// The listener may move the bytes out.
+DECLARE_DELEGATE_TwoParams(FOnSpaceTimeDBTransportFrame, TArray<uint8>& /*Frame*/, bool /*bBinary*/);
+
+// Everything the manager needs from a connection to the database. The WebSocket
+// implementation talks to a real host; the loopback one stays in process.
+class EON_API ISpaceTimeDBTransport
+{
+public:
+	virtual ~ISpaceTimeDBTransport() = default;
+
+	virtual void Connect() = 0;
+	virtual void Close() = 0;
+	virtual bool IsConnected() const = 0;
+
+	virtual void SendText(const FString& Text) = 0;
+	virtual void SendBinary(const uint8* Data, int32 Size) = 0;
+
+	// Bytes handed to Send* that have not gone out on the link yet, for
+	// transports that can tell; UE's IWebSocket does not report it
+	virtual int32 GetBufferedBytes() const { return 0; }
+
+	// Unbinds every event, e.g. before the owner drops a transport it is replacing
+	void UnbindAll()
+	{
+		OnConnected.Unbind();
+		OnConnectionError.Unbind();
+		OnClosed.Unbind();
+		OnFrame.Unbind();
+	}
+
+	FOnSpaceTimeDBTransportConnected OnConnected;
+	FOnSpaceTimeDBTransportError OnConnectionError;
+	FOnSpaceTimeDBTransportClosed OnClosed;
+	FOnSpaceTimeDBTransportFrame OnFrame;
+};
+
+// What a transport is created from
+struct FSpaceTimeDBTransportParams
+{
+	FString Url;
+	FString Subprotocol;
+	TMap<FString, FString> UpgradeHeaders;
+};
+
+using FSpaceTimeDBTransportFactory = TFunction<TSharedRef<ISpaceTimeDBTransport>(const FSpaceTimeDBTransportParams&)>;
+
+// ============================================================================
+// WEBSOCKET
+// ============================================================================
+
+class EON_API FSpaceTimeDBWebSocketTransport : public ISpaceTimeDBTransport
+{
+public:
+	explicit FSpaceTimeDBWebSocketTransport(const FSpaceTimeDBTransportParams& Params);
+	virtual ~FSpaceTimeDBWebSocketTransport() override;
+
+	virtual void Connect() override;
+	virtual void Close() override;
+	virtual bool IsConnected() const override;
+	virtual void SendText(const FString& Text) override;
+	virtual void SendBinary(const uint8* Data, int32 Size) override;
+
+private:
+	TSharedPtr<IWebSocket> WebSocket;
+	TArray<uint8> TextReceiveBuffer;
+	TArray<uint8> BinaryReceiveBuffer;
+};
+
+// ============================================================================
+// LOOPBACK
+// ============================================================================
+
+// In-process transport with no network at all. The code that owns the other
+// end plays the server: it pushes frames with ServerSend* and sees the
+// client's frames through OnClientFrame, or in GetClientFrames() when nothing
+// is bound. Delivery is synchronous, so a whole exchange runs at memory speed.
+// Selected by a "loopback://" host.
+class EON_API FSpaceTimeDBLoopbackTransport : public ISpaceTimeDBTransport
+{
+public:
+	static constexpr const TCHAR* Scheme = TEXT("loopback://");
+
+	static bool IsLoopbackUrl(const FString& Url) { return Url.StartsWith(Scheme); }
+
+	struct FFrame
+	{
+		TArray<uint8> Bytes;
+		bool bBinary = false;
+	};
+
+	virtual void Connect() override;
+	virtual void Close() override;
+	virtual bool IsConnected() const override { return bConnected; }
+	virtual void SendText(const FString& Text) override;
+	virtual void SendBinary(const uint8* Data, int32 Size) override;
+
+	// Server side. ServerSend takes frames already in wire form (UTF-8 for text).
+	void ServerSend(TArray<uint8> Bytes, bool bBinary);
+	void ServerSendText(const FString& Text);
+	void ServerSendBinary(TArray<uint8> Bytes) { ServerSend(MoveTemp(Bytes), true); }
+	void ServerClose(const FString& Reason, bool bWasClean);
+
+	// When false, Connect() fails with a connection error
+	void SetAcceptConnections(bool bAccept) { bAcceptConnections = bAccept; }
+
+	// Frames sent by the client while OnClientFrame is unbound, oldest first
+	TArray<FFrame>& GetClientFrames() { return ClientFrames; }
+
+	FOnSpaceTimeDBTransportFrame OnClientFrame;
+
+private:
+	void DeliverToServer(TArray<uint8>&& Bytes, bool bBinary);
+
+	TArray<FFrame> ClientFrames;
+	bool bConnected = false;
+	bool bAcceptConnections = true;
+};
@@ -45,6 +45,10 @@ if [ ! -f "$CLIENT_DIR/Eon.uproject" ]; then
     exit 1
 fi
 
+# Regenerate SpaceTimeDB row structs and decoders from the server tables
+echo "[INFO] Generating SpaceTimeDB schema..."
+python3 "$SCRIPT_DIR/generate_spacetimedb_schema.py"
+
 # Clean previous builds
 echo "[INFO] Cleaning previous builds..."
 rm -rf "$OUTPUT_DIR" 2>/dev/null || true
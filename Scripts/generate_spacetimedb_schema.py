@@ -0,0 +1,342 @@
+#!/usr/bin/env python3
+# Eon Project - SpaceTimeDB schema generator
+# Reads the #[table] structs in Server/eonserver/src/lib.rs and writes the
+# client's row structs, their BSATN / JSON decoders and JSON writers:
+#   Client/Source/Eon/Public/SpaceTimeDBSchema.h
+#   Client/Source/Eon/Private/SpaceTimeDBSchema.inl
+#
+# Usage: generate_spacetimedb_schema.py [--check]
+#   --check  exit 1 if the generated files are out of date instead of writing them
+
+import os
+import re
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+PROJECT_ROOT = os.path.dirname(SCRIPT_DIR)
+SERVER_SOURCE = os.path.join(PROJECT_ROOT, "Server", "eonserver", "src", "lib.rs")
+HEADER_PATH = os.path.join(PROJECT_ROOT, "Client", "Source", "Eon", "Public", "SpaceTimeDBSchema.h")
+DECODERS_PATH = os.path.join(PROJECT_ROOT, "Client", "Source", "Eon", "Private", "SpaceTimeDBSchema.inl")
+
+# Tables the client mirrors, by server table name, and the C++ row struct for each
+CLIENT_TABLES = [
+    ("instance", "FSpaceTimeDBInstanceRow"),
+    ("player", "FSpaceTimeDBPlayerRow"),
+    ("item_definition", "FSpaceTimeDBItemDefinitionRow"),
+    ("inventory_item", "FSpaceTimeDBInventoryRow"),
+    ("world_item", "FSpaceTimeDBWorldItemRow"),
+    ("interactable_state", "FSpaceTimeDBInteractableRow"),
+]
+
+# Client-side defaults that differ from zero, by table and column
+DEFAULTS = {
+    "player": {"health": "100.0f", "max_health": "100.0f"},
+}
+
+# Rust type -> (C++ type, default initializer, BSATN read, JSON read)
+SCALARS = {
+    "bool": ("bool", "false", "Reader.ReadBool()", "Reader.ReadBool()"),
+    "u8": ("uint8", "0", "Reader.ReadU8()", "static_cast<uint8>(Reader.ReadU32())"),
+    "u32": ("uint32", "0", "Reader.ReadU32()", "Reader.ReadU32()"),
+    "u64": ("uint64", "0", "Reader.ReadU64()", "Reader.ReadU64()"),
+    "i64": ("int64", "0", "Reader.ReadI64()", "Reader.ReadI64()"),
+    "f32": ("float", "0.0f", "Reader.ReadF32()", "Reader.ReadFloat()"),
+    "String": ("FString", None, "Reader.ReadString()", "Reader.ReadString()"),
+    # 32 raw bytes over BSATN, hex over JSON
+    "Identity": ("FSpaceTimeDBIdentity", None, "ReadIdentity(Reader)", "Reader.ReadIdentity()"),
+    # Microseconds since the Unix epoch
+    "Timestamp": ("int64", "0", "Reader.ReadI64()", "Reader.ReadI64()"),
+}
+
+# Columns named <prefix>_x/_y/_z or <prefix>_pitch/_yaw/_roll become one vector / rotator member
+COMPOSITES = [
+    (("x", "y", "z"), ("X", "Y", "Z"), "FVector3f", "FVector3f::ZeroVector"),
+    (("pitch", "yaw", "roll"), ("Pitch", "Yaw", "Roll"), "FRotator3f", "FRotator3f::ZeroRotator"),
+]
+
+TABLE_RE = re.compile(r"#\[table\(name\s*=\s*(\w+)[^\]]*\)\]\s*pub struct (\w+)\s*\{(.*?)\n\}", re.S)
+FIELD_RE = re.compile(r"^\s*pub (\w+):\s*([\w<>]+),\s*(?://\s*(.*))?$")
+
+
+class Column:
+    def __init__(self, name, rust_type, comment, primary_key):
+        self.name = name
+        self.rust_type = rust_type
+        self.comment = comment
+        self.primary_key = primary_key
+        self.optional = rust_type.startswith("Option<")
+        self.base_type = rust_type[len("Option<"):-1] if self.optional else rust_type
+        if self.base_type not in SCALARS:
+            raise SystemExit("Unsupported column type %s for %s" % (rust_type, name))
+
+
+class Member:
+    """One C++ member: a single column, or a vector/rotator built from several."""
+
+    def __init__(self, name, cpp_type, default, columns, components=None):
+        self.name = name
+        self.cpp_type = cpp_type
+        self.default = default
+        self.columns = columns
+        self.components = components
+
+    def is_string(self):
+        return self.cpp_type == "FString"
+
+    def by_reference(self):
+        return self.cpp_type in ("FString", "FSpaceTimeDBIdentity")
+
+
+def pascal(snake):
+    return "".join(part[:1].upper() + part[1:] for part in snake.split("_"))
+
+
+def parse_tables(source):
+    tables = {}
+    for match in TABLE_RE.finditer(source):
+        table_name, body = match.group(1), match.group(3)
+        columns = []
+        primary_key = False
+        for line in body.splitlines():
+            if "#[primary_key]" in line:
+                primary_key = True
+                continue
+            field = FIELD_RE.match(line)
+            if field:
+                columns.append(Column(field.group(1), field.group(2), field.group(3), primary_key))
+                primary_key = False
+        tables[table_name] = columns
+    return tables
+
+
+def build_members(table_name, columns):
+    members = []
+    index = 0
+    while index < len(columns):
+        column = columns[index]
+        composite = None
+        for suffixes, component_names, cpp_type, default in COMPOSITES:
+            names = [c.name for c in columns[index:index + len(suffixes)]]
+            prefix = column.name.rsplit("_", 1)[0]
+            if names == ["%s_%s" % (prefix, s) for s in suffixes] and all(c.rust_type == "f32" for c in columns[index:index + len(suffixes)]):
+                composite = Member(pascal(prefix), cpp_type, default, columns[index:index + len(suffixes)], component_names)
+                break
+        if composite:
+            members.append(composite)
+            index += len(composite.columns)
+            continue
+
+        cpp_type, default, _, _ = SCALARS[column.base_type]
+        name = pascal(column.name)
+        if column.base_type == "bool":
+            name = "b" + name
+        elif column.base_type == "Timestamp":
+            name += "Micros"
+        default = DEFAULTS.get(table_name, {}).get(column.name, default)
+        if column.optional:
+            cpp_type, default = "TOptional<%s>" % cpp_type, None
+        members.append(Member(name, cpp_type, default, [column]))
+        index += 1
+    return members
+
+
+def fnv1a(text):
+    value = 2166136261
+    for byte in text.encode("utf-8"):
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def schema_hash(tables):
+    parts = []
+    for table_name, _ in CLIENT_TABLES:
+        parts.append(table_name + "(" + ",".join("%s:%s" % (c.name, c.rust_type) for c in tables[table_name]) + ")")
+    return fnv1a(";".join(parts))
+
+
+def emit_row(table_name, struct_name, columns):
+    members = build_members(table_name, columns)
+    keys = [m for m in members if any(c.primary_key for c in m.columns)]
+    if len(keys) != 1:
+        raise SystemExit("Table %s needs exactly one #[primary_key] column" % table_name)
+    key = keys[0]
+
+    out = ["struct %s" % struct_name, "{"]
+    for member in members:
+        comment = member.columns[0].comment
+        if comment:
+            out.append("\t// %s" % comment)
+        if member.default:
+            out.append("\t%s %s = %s;" % (member.cpp_type, member.name, member.default))
+        else:
+            out.append("\t%s %s;" % (member.cpp_type, member.name))
+    out.append("")
+    out.append("\tstatic constexpr const TCHAR* TableName = TEXT(\"%s\");" % table_name)
+    out.append("")
+    out.append("\t// Server columns in declaration order, which is also the BSATN field order")
+    out.append("\tenum class EColumn : uint8")
+    out.append("\t{")
+    for column in columns:
+        out.append("\t\t%s," % pascal(column.name))
+    out.append("\t\tNum")
+    out.append("\t};")
+    out.append("\tstatic constexpr const ANSICHAR* ColumnNames[] = { %s };" % ", ".join("\"%s\"" % c.name for c in columns))
+    out.append("")
+    if key.by_reference():
+        out.append("\tusing KeyType = %s;" % key.cpp_type)
+        out.append("\tconst %s& GetKey() const { return %s; }" % (key.cpp_type, key.name))
+    else:
+        out.append("\tusing KeyType = %s;" % key.cpp_type)
+        out.append("\t%s GetKey() const { return %s; }" % (key.cpp_type, key.name))
+    out.append("")
+
+    comparisons = []
+    for member in members:
+        if member.is_string():
+            comparisons.append("%s.Equals(Other.%s, ESearchCase::CaseSensitive)" % (member.name, member.name))
+        else:
+            comparisons.append("%s == Other.%s" % (member.name, member.name))
+    out.append("\tbool operator==(const %s& Other) const" % struct_name)
+    out.append("\t{")
+    out.append("\t\treturn %s;" % " &&\n\t\t\t".join(comparisons))
+    out.append("\t}")
+    out.append("};")
+    return out
+
+
+def member_targets(member):
+    if member.components:
+        return ["Row.%s.%s" % (member.name, component) for component in member.components]
+    return ["Row.%s" % member.name]
+
+
+def emit_decoders(table_name, struct_name, columns):
+    members = build_members(table_name, columns)
+
+    out = ["void ReadRow(FBsatnReader& Reader, %s& Row)" % struct_name, "{"]
+    for member in members:
+        for target, column in zip(member_targets(member), member.columns):
+            read = SCALARS[column.base_type][2]
+            if column.optional:
+                out.append("\tif (Reader.ReadU8() == OptionSome)")
+                out.append("\t{")
+                out.append("\t\t%s = %s;" % (target, read))
+                out.append("\t}")
+            else:
+                out.append("\t%s = %s;" % (target, read))
+    out.append("}")
+    out.append("")
+
+    out.append("void ReadJsonField(FUtf8JsonReader& Reader, uint32 Key, %s& Row)" % struct_name)
+    out.append("{")
+    out.append("\tswitch (Key)")
+    out.append("\t{")
+    for member in members:
+        for target, column in zip(member_targets(member), member.columns):
+            read = SCALARS[column.base_type][3]
+            if column.optional:
+                out.append("\t\tcase FKey::HashKey(\"%s\"):" % column.name)
+                out.append("\t\t\tif (!Reader.TryReadNull())")
+                out.append("\t\t\t{")
+                out.append("\t\t\t\t%s = %s;" % (target, read))
+                out.append("\t\t\t}")
+                out.append("\t\t\tbreak;")
+            else:
+                out.append("\t\tcase FKey::HashKey(\"%s\"): %s = %s; break;" % (column.name, target, read))
+    out.append("\t\tdefault: Reader.SkipValue(); break;")
+    out.append("\t}")
+    out.append("}")
+    out.append("")
+
+    out.append("void WriteJsonColumns(FTypedJsonWriter& Writer, const %s& Row)" % struct_name)
+    out.append("{")
+    for member in members:
+        for target, column in zip(member_targets(member), member.columns):
+            cpp_type = SCALARS[column.base_type][0]
+            value = target + ".GetValue()" if column.optional else target
+            if cpp_type in ("uint8", "uint32", "uint64"):
+                value = "static_cast<int64>(%s)" % value
+            elif cpp_type == "FSpaceTimeDBIdentity":
+                value += ".ToHex()"
+            write = "Writer.WriteValue(TEXT(\"%s\"), %s);" % (column.name, value)
+            if column.optional:
+                out.append("\tif (%s.IsSet())" % target)
+                out.append("\t{")
+                out.append("\t\t%s" % write)
+                out.append("\t}")
+            else:
+                out.append("\t%s" % write)
+    out.append("}")
+    return out
+
+
+def generate(source):
+    tables = parse_tables(source)
+    for table_name, _ in CLIENT_TABLES:
+        if table_name not in tables:
+            raise SystemExit("Table %s not found in %s" % (table_name, SERVER_SOURCE))
+
+    banner = [
+        "// Copyright 2026 tbassignana. MIT License.",
+        "",
+        "// Generated by Scripts/generate_spacetimedb_schema.py from Server/eonserver/src/lib.rs.",
+        "// Do not edit; change the server tables and rerun the script.",
+        "",
+    ]
+
+    header = banner + [
+        "#pragma once",
+        "",
+        "#include \"CoreMinimal.h\"",
+        "#include \"SpaceTimeDBIdentity.h\"",
+        "",
+        "// Hash of the mirrored tables' columns; changes whenever the generated code does",
+        "constexpr uint32 SpaceTimeDBSchemaHash = 0x%08x;" % schema_hash(tables),
+    ]
+    for table_name, struct_name in CLIENT_TABLES:
+        header.append("")
+        header.extend(emit_row(table_name, struct_name, tables[table_name]))
+
+    decoders = banner + [
+        "// Row decoders, included by SpaceTimeDBProtocol.cpp inside its anonymous namespace.",
+        "// ReadRow reads BSATN columns in declaration order; ReadJsonField reads one JSON",
+        "// column and skips unknown ones, so older clients tolerate new server columns.",
+        "// WriteJsonColumns writes a row back out with the server's column names.",
+    ]
+    for table_name, struct_name in CLIENT_TABLES:
+        decoders.append("")
+        decoders.extend(emit_decoders(table_name, struct_name, tables[table_name]))
+
+    return {HEADER_PATH: "\n".join(header) + "\n", DECODERS_PATH: "\n".join(decoders) + "\n"}
+
+
+def main():
+    check = "--check" in sys.argv[1:]
+    with open(SERVER_SOURCE, encoding="utf-8") as f:
+        outputs = generate(f.read())
+
+    stale = []
+    for path, text in outputs.items():
+        current = None
+        if os.path.exists(path):
+            with open(path, encoding="utf-8") as f:
+                current = f.read()
+        if current == text:
+            continue
+        stale.append(os.path.relpath(path, PROJECT_ROOT))
+        if not check:
+            with open(path, "w", encoding="utf-8", newline="\n") as f:
+                f.write(text)
+
+    if check and stale:
+        print("[ERROR] SpaceTimeDB schema is out of date: %s" % ", ".join(stale))
+        print("Run Scripts/generate_spacetimedb_schema.py")
+        return 1
+
+    for path in stale:
+        print("[INFO] Generated %s" % path)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
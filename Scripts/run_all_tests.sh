@@ -42,6 +42,20 @@ run_test() {
 chmod +x "$TESTS_DIR"/integration/*.sh 2>/dev/null || true
 chmod +x "$TESTS_DIR"/performance/*.sh 2>/dev/null || true
 
+# Generated client schema must match the server tables
+echo ""
+echo "========== SCHEMA CHECK =========="
+echo ""
+
+TESTS_RUN=$((TESTS_RUN + 1))
+if python3 "$SCRIPT_DIR/generate_spacetimedb_schema.py" --check; then
+    TOTAL_PASSED=$((TOTAL_PASSED + 1))
+    echo "[SUITE] SpaceTimeDB Schema: PASSED"
+else
+    TOTAL_FAILED=$((TOTAL_FAILED + 1))
+    echo "[SUITE] SpaceTimeDB Schema: FAILED"
+fi
+
 # Run Integration Tests
 echo ""
 echo "========== INTEGRATION TESTS =========="
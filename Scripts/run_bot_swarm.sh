@@ -0,0 +1,42 @@
+#!/bin/bash
+# Eon Project - Bot Swarm Load Test
+# Runs hundreds of headless clients against a SpaceTimeDB server from one process
+#
+# Usage: run_bot_swarm.sh [bots] [seconds] [extra commandlet args...]
+#   e.g. run_bot_swarm.sh 300 120 -NetProfile=LTE -Binary
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
+CLIENT_DIR="$PROJECT_ROOT/Client"
+UE_ROOT="/Users/Shared/Epic Games/UE_5.5"
+EDITOR="$UE_ROOT/Engine/Binaries/Mac/UnrealEditor.app/Contents/MacOS/UnrealEditor"
+
+BOTS="${1:-100}"
+SECONDS_TO_RUN="${2:-60}"
+shift 2 2>/dev/null || shift $#
+
+echo "=========================================="
+echo "Eon Project - Bot Swarm"
+echo "=========================================="
+echo "Bots: $BOTS"
+echo "Duration: ${SECONDS_TO_RUN}s"
+echo ""
+
+if [ ! -x "$EDITOR" ]; then
+    echo "[ERROR] Unreal Editor not found at $UE_ROOT"
+    echo "Please install UE 5.5.4 via Epic Games Launcher"
+    exit 1
+fi
+
+"$EDITOR" "$CLIENT_DIR/Eon.uproject" \
+    -run=EonBotSwarm \
+    -Bots="$BOTS" \
+    -Seconds="$SECONDS_TO_RUN" \
+    -unattended \
+    -nullrhi \
+    -nosplash \
+    -stdout \
+    -utf8output \
+    "$@"
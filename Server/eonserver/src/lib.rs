@@ -545,6 +545,45 @@ pub fn update_player_position(
     }
 }
 
+/// Bit widths and steps of the compact transform; must match FEonTransformCodec on the client
+const POSITION_BITS_XY: u32 = 22;
+const POSITION_BITS_Z: u32 = 20;
+const POSITION_STEP_CM: f64 = 1.0;
+
+/// A Bits-wide offset-binary field of Word, in Steps
+fn unpack_signed(word: u64, shift: u32, bits: u32, step: f64) -> f32 {
+    let field = (word >> shift) & ((1u64 << bits) - 1);
+    ((field as i64 - (1i64 << (bits - 1))) as f64 * step) as f32
+}
+
+/// (x, y, z) in centimetres from the origin
+fn unpack_position(position: u64) -> (f32, f32, f32) {
+    (
+        unpack_signed(position, 0, POSITION_BITS_XY, POSITION_STEP_CM),
+        unpack_signed(position, POSITION_BITS_XY, POSITION_BITS_XY, POSITION_STEP_CM),
+        unpack_signed(position, 2 * POSITION_BITS_XY, POSITION_BITS_Z, POSITION_STEP_CM),
+    )
+}
+
+/// (pitch, yaw) in degrees, yaw in (-180, 180]
+fn unpack_orientation(orientation: u32) -> (f32, f32) {
+    let mut yaw = (orientation & 0xFFFF) as f64 * 360.0 / 65536.0;
+    if yaw > 180.0 {
+        yaw -= 360.0;
+    }
+    let pitch = (orientation >> 16) as f64 * 180.0 / 65535.0 - 90.0;
+    (pitch as f32, yaw as f32)
+}
+
+/// update_player_position in 12 bytes: fixed-point position in centimetres
+/// from the origin and a 16-bit yaw/pitch pair. Roll is always zero.
+#[reducer]
+pub fn update_player_transform(ctx: &ReducerContext, position: u64, orientation: u32) {
+    let (x, y, z) = unpack_position(position);
+    let (pitch, yaw) = unpack_orientation(orientation);
+    update_player_position(ctx, x, y, z, pitch, yaw, 0.0);
+}
+
 #[reducer]
 pub fn update_player_health(ctx: &ReducerContext, health: f32) {
     if let Some(player) = ctx.db.player().identity().find(ctx.sender) {
@@ -1041,3 +1080,36 @@ pub fn get_wallet_balance(ctx: &ReducerContext) {
     let wallet = get_or_create_wallet(ctx, ctx.sender);
     log::info!("Wallet balance for {:?}: {} premium currency", ctx.sender, wallet.premium_currency);
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Words from FEonTransformCodec::Encode on the client; Eon.TransformCodec.RoundTrip pins the same ones
+    #[test]
+    fn unpacks_client_position_vectors() {
+        // (0, 0, 0)
+        assert_eq!(unpack_position(9223380832949895168), (0.0, 0.0, 0.0));
+        // (12345.67, -8910.11, 215.5), rounded to the centimetre
+        assert_eq!(unpack_position(9227180707764252730), (12346.0, -8910.0, 216.0));
+        // (1e9, -1e9, 1e9), clamped to the field range
+        assert_eq!(unpack_position(18446726481527701503), (2097151.0, -2097152.0, 524287.0));
+        // (-2097152.4, 2097151.2, -524288), the field edges
+        assert_eq!(unpack_position(17592181850112), (-2097152.0, 2097151.0, -524288.0));
+    }
+
+    #[test]
+    fn unpacks_client_orientation_vectors() {
+        let close = |(pitch, yaw): (f32, f32), (want_pitch, want_yaw): (f32, f32)| {
+            (pitch - want_pitch).abs() < 0.002 && (yaw - want_yaw).abs() < 0.006
+        };
+        // Pitch 0, yaw 0
+        assert!(close(unpack_orientation(2147483648), (0.0, 0.0)));
+        // Pitch -12.5, yaw 137.25
+        assert!(close(unpack_orientation(1849188762), (-12.5, 137.25)));
+        // Pitch 90, yaw -90: yaw comes back in (-180, 180]
+        assert!(close(unpack_orientation(4294950912), (90.0, -90.0)));
+        // Pitch -90, yaw 359.99
+        assert!(close(unpack_orientation(65534), (-90.0, -0.01)));
+    }
+}
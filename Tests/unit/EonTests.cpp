@@ -5,6 +5,28 @@
 #include "InventoryComponent.h"
 #include "EonCharacter.h"
 #include "InteractionComponent.h"
+#include "SpaceTimeDBProtocol.h"
+#include "SpaceTimeDBReducers.h"
+#include "SpaceTimeDBNetWorker.h"
+#include "SpaceTimeDBTableCache.h"
+#include "SpaceTimeDBSubscriptions.h"
+#include "SpaceTimeDBManager.h"
+#include "SpaceTimeDBTransport.h"
+#include "SpaceTimeDBCapture.h"
+#include "SpaceTimeDBNetSim.h"
+#include "EonBotSwarm.h"
+#include "SpaceTimeDBLatencyProbe.h"
+#include "SpaceTimeDBLocalAuthority.h"
+#include "SpaceTimeDBClockSync.h"
+#include "SpaceTimeDBEndpoints.h"
+#include "EonDeadReckoning.h"
+#include "EonTransformCodec.h"
+#include "PlayerSyncComponent.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Engine/GameInstance.h"
+#include "Json.h"
 
 // ============================================================================
 // INVENTORY COMPONENT TESTS - ORIGINAL
@@ -904,3 +926,2308 @@ bool FInteractionPromptTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+// ============================================================================
+// SPACETIMEDB PROTOCOL TESTS
+// ============================================================================
+
+namespace EonProtocolTest
+{
+    constexpr int32 NumCalls = 1000;
+    constexpr int32 NumPlayers = 50;
+
+    FSpaceTimeDBArgList MakePositionArgs(int32 Index)
+    {
+        return EonReducers::UpdatePlayerPosition.MakeArgs(1234.5f + Index, -987.25f, 100.0f, 0.0f, 90.0f + Index * 0.1f, 0.0f);
+    }
+
+    // Builds the frames a server would send for a TransactionUpdate touching NumPlayers player rows
+    void BuildPlayerUpdate(FString& OutJson, TArray<uint8>& OutBinary)
+    {
+        TArray<uint8> Rows;
+        FBsatnWriter RowWriter(Rows);
+
+        OutJson = TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[");
+        for (int32 i = 0; i < NumPlayers; ++i)
+        {
+            uint8 IdentityBytes[32] = {};
+            IdentityBytes[0] = static_cast<uint8>(i + 1);
+            const FString IdentityHex = FSpaceTimeDBIdentity::FromBytes(IdentityBytes).ToHex();
+
+            RowWriter.WriteRaw(IdentityBytes, sizeof(IdentityBytes));
+            RowWriter.WriteString(FString::Printf(TEXT("Player_%d"), 1000 + i));
+            RowWriter.WriteU8(0); // Some(instance_id)
+            RowWriter.WriteU64(7);
+            for (float Value : { 1234.5f, -987.25f, 100.0f, 0.0f, 90.0f, 0.0f, 100.0f, 100.0f })
+            {
+                RowWriter.WriteF32(Value);
+            }
+            RowWriter.WriteBool(true);
+            RowWriter.WriteI64(1767225600000000);
+
+            OutJson += FString::Printf(TEXT("%s{\"table\":\"player\",\"identity\":\"%s\",\"username\":\"Player_%d\",\"instance_id\":7,")
+                TEXT("\"position_x\":1234.5,\"position_y\":-987.25,\"position_z\":100,\"rotation_pitch\":0,\"rotation_yaw\":90,")
+                TEXT("\"rotation_roll\":0,\"health\":100,\"max_health\":100,\"is_online\":true,\"last_seen\":1767225600000000}"),
+                i > 0 ? TEXT(",") : TEXT(""), *IdentityHex, 1000 + i);
+        }
+        OutJson += TEXT("]}");
+
+        FBsatnWriter Writer(OutBinary);
+        Writer.WriteU8(0); // uncompressed
+        Writer.WriteU8(2); // TransactionUpdateLight
+        Writer.WriteU32(1); // request_id
+        Writer.WriteU32(1); // one table
+        Writer.WriteU32(1); // table_id
+        Writer.WriteString(TEXT("player"));
+        Writer.WriteU64(NumPlayers);
+        Writer.WriteU32(1); // one query update
+        Writer.WriteU8(0); // uncompressed
+        Writer.WriteU8(1); Writer.WriteU32(0); Writer.WriteBytes(nullptr, 0); // no deletes
+        Writer.WriteU8(1); Writer.WriteU32(0); Writer.WriteBytes(Rows.GetData(), Rows.Num());
+    }
+}
+
+bool FSpaceTimeDBProtocolEncodeTest::RunTest(const FString& Parameters)
+{
+    using namespace EonProtocolTest;
+
+    int64 JsonBytes = 0;
+    const double JsonStart = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        FString Frame;
+        FSpaceTimeDBProtocol::EncodeReducerCallJson(TEXT("update_player_position"), MakePositionArgs(i), i, Frame);
+        JsonBytes += FTCHARToUTF8(*Frame).Length();
+    }
+    const double JsonSeconds = FPlatformTime::Seconds() - JsonStart;
+
+    int64 BinaryBytes = 0;
+    TArray<uint8> Frame;
+    const double BinaryStart = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        Frame.Reset();
+        FSpaceTimeDBProtocol::EncodeReducerCallBinary(TEXT("update_player_position"), MakePositionArgs(i), i, Frame);
+        BinaryBytes += Frame.Num();
+    }
+    const double BinarySeconds = FPlatformTime::Seconds() - BinaryStart;
+
+    AddInfo(FString::Printf(TEXT("update_player_position x%d: json %lld bytes / %.3f ms, binary %lld bytes / %.3f ms"),
+        NumCalls, JsonBytes, JsonSeconds * 1000.0, BinaryBytes, BinarySeconds * 1000.0));
+
+    TestTrue(TEXT("Binary reducer calls should be smaller than JSON"), BinaryBytes < JsonBytes);
+
+    // tag + "update_player_position" + 6 x f32 args + request_id + flags
+    TestEqual(TEXT("Binary call frame has the expected BSATN size"), Frame.Num(), 1 + 4 + 22 + 4 + 24 + 4 + 1);
+
+    return true;
+}
+
+bool FSpaceTimeDBProtocolDecodeTest::RunTest(const FString& Parameters)
+{
+    using namespace EonProtocolTest;
+
+    FString JsonFrame;
+    TArray<uint8> BinaryFrame;
+    BuildPlayerUpdate(JsonFrame, BinaryFrame);
+
+    // Text frames arrive as raw UTF-8, which is what the streaming decoder reads
+    const FTCHARToUTF8 JsonUtf8(*JsonFrame);
+    FSpaceTimeDBServerMessage JsonMessage;
+    const double JsonStart = FPlatformTime::Seconds();
+    const bool bJsonOk = FSpaceTimeDBProtocol::DecodeJsonServerMessage(reinterpret_cast<const uint8*>(JsonUtf8.Get()), JsonUtf8.Length(), JsonMessage);
+    const double JsonSeconds = FPlatformTime::Seconds() - JsonStart;
+
+    FSpaceTimeDBServerMessage BinaryMessage;
+    const double BinaryStart = FPlatformTime::Seconds();
+    const bool bBinaryOk = FSpaceTimeDBProtocol::DecodeBinaryServerMessage(BinaryFrame.GetData(), BinaryFrame.Num(), BinaryMessage);
+    const double BinarySeconds = FPlatformTime::Seconds() - BinaryStart;
+
+    const int32 JsonBytes = JsonUtf8.Length();
+    AddInfo(FString::Printf(TEXT("%d player rows: json %d bytes / %.3f ms, binary %d bytes / %.3f ms"),
+        NumPlayers, JsonBytes, JsonSeconds * 1000.0, BinaryFrame.Num(), BinarySeconds * 1000.0));
+
+    TestTrue(TEXT("JSON frame should decode"), bJsonOk);
+    TestTrue(TEXT("Binary frame should decode"), bBinaryOk);
+    TestEqual(TEXT("Both protocols should yield the same row count"), BinaryMessage.Players.Num(), JsonMessage.Players.Num());
+    TestTrue(TEXT("Binary frame should be smaller than JSON"), BinaryFrame.Num() < JsonBytes);
+
+    if (BinaryMessage.Players.Num() == NumPlayers && JsonMessage.Players.Num() == NumPlayers)
+    {
+        const FSpaceTimeDBPlayerRow& JsonRow = JsonMessage.Players[NumPlayers - 1].Row;
+        const FSpaceTimeDBPlayerRow& BinaryRow = BinaryMessage.Players[NumPlayers - 1].Row;
+        TestTrue(TEXT("Identity should match"), BinaryRow.Identity == JsonRow.Identity);
+        TestEqual(TEXT("Username should match"), BinaryRow.Username, JsonRow.Username);
+        TestEqual(TEXT("Instance should match"), BinaryRow.InstanceId.Get(0), JsonRow.InstanceId.Get(0));
+        TestEqual(TEXT("Position should match"), BinaryRow.Position.Y, JsonRow.Position.Y);
+        TestEqual(TEXT("Online flag should match"), BinaryRow.bIsOnline, JsonRow.bIsOnline);
+        TestEqual(TEXT("Last seen should match"), BinaryRow.LastSeenMicros, JsonRow.LastSeenMicros);
+    }
+
+    return true;
+}
+
+bool FSpaceTimeDBJsonReaderTest::RunTest(const FString& Parameters)
+{
+    // Columns before "table", an unknown nested column, escapes, a quoted u64, and "type" after the payload
+    const FString Frame = TEXT("{\"updates\":[")
+        TEXT("{\"quantity\":3,\"extra\":{\"a\":[1,{\"b\":null}]},\"table\":\"world_item\",\"world_item_id\":\"18446744073709551615\",")
+        TEXT("\"item_id\":\"potion \\\"large\\\" \\u00e9\\ud83d\\ude00\",\"position_x\":-1.5e2,\"is_collected\":false},")
+        TEXT("{\"table\":\"player\",\"identity\":\"ab\",\"instance_id\":null,\"is_online\":true},")
+        TEXT("{\"table\":\"unknown_table\",\"x\":1},")
+        TEXT("42],\"type\":\"TransactionUpdate\"}");
+
+    FSpaceTimeDBServerMessage Message;
+    TestTrue(TEXT("Frame should decode"), FSpaceTimeDBProtocol::DecodeJsonServerMessage(Frame, Message));
+    TestTrue(TEXT("Type should be read after the payload"), Message.Type == ESpaceTimeDBMessageType::TransactionUpdate);
+
+    if (TestEqual(TEXT("One world item"), Message.WorldItems.Num(), 1))
+    {
+        const FSpaceTimeDBWorldItemRow& Row = Message.WorldItems[0].Row;
+        TestEqual(TEXT("Column before table should be kept"), static_cast<int32>(Row.Quantity), 3);
+        TestTrue(TEXT("Quoted u64 should be exact"), Row.WorldItemId == MAX_uint64);
+        TestEqual(TEXT("Escapes should be decoded"), Row.ItemId, FString(TEXT("potion \"large\" \u00e9")) + FString(TEXT("\U0001F600")));
+        TestEqual(TEXT("Exponent should parse"), Row.Position.X, -150.0f);
+    }
+
+    if (TestEqual(TEXT("One player"), Message.Players.Num(), 1))
+    {
+        TestFalse(TEXT("Null instance should stay unset"), Message.Players[0].Row.InstanceId.IsSet());
+        TestTrue(TEXT("Bool should parse"), Message.Players[0].Row.bIsOnline);
+    }
+
+    FSpaceTimeDBServerMessage Identity;
+    TestTrue(TEXT("Identity frame should decode"),
+        FSpaceTimeDBProtocol::DecodeJsonServerMessage(TEXT("{\"identity\":\"c0ffee\",\"type\":\"IdentityToken\",\"token\":\"x\"}"), Identity));
+    TestTrue(TEXT("Identity type"), Identity.Type == ESpaceTimeDBMessageType::IdentityToken);
+    TestEqual(TEXT("Identity value"), Identity.Identity.ToHex().Right(6), FString(TEXT("c0ffee")));
+    TestEqual(TEXT("Token kept for reconnect"), Identity.Token, FString(TEXT("x")));
+
+    FSpaceTimeDBServerMessage Broken;
+    TestFalse(TEXT("Truncated frame should fail"), FSpaceTimeDBProtocol::DecodeJsonServerMessage(TEXT("{\"type\":\"Transac"), Broken));
+    TestFalse(TEXT("Non-hex identity should fail"), FSpaceTimeDBProtocol::DecodeJsonServerMessage(
+        TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"player\",\"identity\":\"player_1\"}]}"), Broken));
+
+    return true;
+}
+
+bool FSpaceTimeDBRequestIdTest::RunTest(const FString& Parameters)
+{
+    // Full TransactionUpdate for our own reducer call: committed, no table changes
+    uint8 CallerBytes[32] = {};
+    CallerBytes[0] = 0xAB;
+
+    TArray<uint8> Frame;
+    FBsatnWriter Writer(Frame);
+    Writer.WriteU8(0); // uncompressed
+    Writer.WriteU8(1); // TransactionUpdate
+    Writer.WriteU8(0); // Committed
+    Writer.WriteU32(0); // no tables
+    Writer.WriteI64(1767225600000000); // timestamp
+    Writer.WriteRaw(CallerBytes, sizeof(CallerBytes));
+    for (int32 i = 0; i < 16; ++i)
+    {
+        Writer.WriteU8(0); // connection id
+    }
+    Writer.WriteString(TEXT("update_player_position"));
+    Writer.WriteU32(3); // reducer_id
+    Writer.WriteBytes(nullptr, 0); // args
+    Writer.WriteU32(42); // request_id
+
+    FSpaceTimeDBServerMessage Binary;
+    TestTrue(TEXT("Binary update should decode"), FSpaceTimeDBProtocol::DecodeBinaryServerMessage(Frame.GetData(), Frame.Num(), Binary));
+    TestEqual(TEXT("Binary request id"), static_cast<int32>(Binary.RequestId), 42);
+    TestTrue(TEXT("Binary caller"), Binary.CallerIdentity == FSpaceTimeDBIdentity::FromBytes(CallerBytes));
+
+    FString CallFrame;
+    FSpaceTimeDBProtocol::EncodeReducerCallJson(TEXT("toggle_interactable"), { FSpaceTimeDBArg::String(TEXT("door_1")) }, 7, CallFrame);
+    TestTrue(TEXT("JSON calls should carry their request id"), CallFrame.Contains(TEXT("\"request_id\":7")));
+
+    FSpaceTimeDBServerMessage Json;
+    FSpaceTimeDBProtocol::DecodeJsonServerMessage(TEXT("{\"type\":\"TransactionUpdate\",\"request_id\":7,\"caller_identity\":\"ab\",\"updates\":[]}"), Json);
+    TestEqual(TEXT("JSON request id"), static_cast<int32>(Json.RequestId), 7);
+    TestTrue(TEXT("JSON caller"), Json.CallerIdentity == FSpaceTimeDBIdentity::FromHex(TEXT("ab")));
+
+    // Decode-time histogram buckets
+    FSpaceTimeDBDecodeHistogram Histogram;
+    Histogram.Record(0.00003);
+    Histogram.Record(0.0003);
+    Histogram.Record(1.0);
+    TArray<int32> Counts;
+    Histogram.Snapshot(Counts);
+    TestEqual(TEXT("Histogram bucket count"), Counts.Num(), FSpaceTimeDBDecodeHistogram::NumBuckets);
+    TestEqual(TEXT("30us lands in the first bucket"), Counts[0], 1);
+    TestEqual(TEXT("300us lands in the 500us bucket"), Counts[3], 1);
+    TestEqual(TEXT("Slow decodes land in the last bucket"), Counts.Last(), 1);
+
+    return true;
+}
+
+bool FSpaceTimeDBTypedReducerTest::RunTest(const FString& Parameters)
+{
+    // Argument types come from the descriptor
+    const FSpaceTimeDBArgList Args = EonReducers::CreateInstance.MakeArgs(TEXT("Hub \"A\"\n"), 16u, true);
+    TestEqual(TEXT("One arg per reducer parameter"), Args.Num(), EonReducers::CreateInstance.NumArgs);
+    TestTrue(TEXT("Arg types follow the reducer"), Args[0].Type == ESpaceTimeDBArgType::String
+        && Args[1].Type == ESpaceTimeDBArgType::U32 && Args[2].Type == ESpaceTimeDBArgType::Bool);
+
+    FString Frame;
+    FSpaceTimeDBProtocol::EncodeReducerCallJson(EonReducers::CreateInstance.Name, Args, 3, Frame);
+    TestEqual(TEXT("JSON call frame"), Frame,
+        FString(TEXT("{\"call\":\"create_instance\",\"args\":[\"Hub \\\"A\\\"\\n\",\"16\",\"true\"],\"request_id\":3}")));
+
+    TSharedPtr<FJsonObject> Parsed;
+    TestTrue(TEXT("Escaped frame should be valid JSON"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Frame), Parsed) && Parsed.IsValid());
+
+    // Encoding appends, so packed frames are built in place
+    FString Packed;
+    FSpaceTimeDBProtocol::EncodeReducerCallJson(EonReducers::JoinInstance.Name, EonReducers::JoinInstance.MakeArgs(MAX_uint64), 1, Packed);
+    FSpaceTimeDBProtocol::EncodeReducerCallJson(EonReducers::UpdatePlayerHealth.Name, EonReducers::UpdatePlayerHealth.MakeArgs(0.1f), 2, Packed);
+    TestEqual(TEXT("Calls should append"), Packed,
+        FString(TEXT("{\"call\":\"join_instance\",\"args\":[\"18446744073709551615\"],\"request_id\":1}")
+            TEXT("{\"call\":\"update_player_health\",\"args\":[\"0.100000001\"],\"request_id\":2}")));
+
+    // Floats are written with enough digits to read back exactly
+    const float Health = FCString::Atof(TEXT("0.100000001"));
+    TestEqual(TEXT("f32 should round-trip"), Health, 0.1f);
+
+    return true;
+}
+
+bool FSpaceTimeDBIdentityTest::RunTest(const FString& Parameters)
+{
+    // Wire bytes are little-endian; hex is printed big-endian
+    uint8 Bytes[FSpaceTimeDBIdentity::NumBytes] = {};
+    Bytes[0] = 0xEE;
+    Bytes[1] = 0xFF;
+    Bytes[2] = 0xC0;
+    Bytes[31] = 0x01;
+    const FSpaceTimeDBIdentity FromWire = FSpaceTimeDBIdentity::FromBytes(Bytes);
+    const FString Hex = FromWire.ToHex();
+    TestEqual(TEXT("Hex is 64 digits"), Hex.Len(), 64);
+    TestTrue(TEXT("Most significant byte first"), Hex.StartsWith(TEXT("01")) && Hex.EndsWith(TEXT("c0ffee"), ESearchCase::CaseSensitive));
+
+    FSpaceTimeDBIdentity Parsed;
+    TestTrue(TEXT("0x-prefixed hex parses"), FSpaceTimeDBIdentity::FromHex(TEXT("0x") + Hex.ToUpper(), Parsed));
+    TestTrue(TEXT("Hex round-trips"), Parsed == FromWire);
+    TestEqual(TEXT("Equal identities hash equally"), GetTypeHash(Parsed), GetTypeHash(FromWire));
+    TestTrue(TEXT("Short hex is zero-extended"), FSpaceTimeDBIdentity::FromHex(TEXT("c0ffee")).ToHex().EndsWith(TEXT("0000c0ffee")));
+    TestFalse(TEXT("Non-hex is rejected"), FSpaceTimeDBIdentity::FromHex(TEXT("player_1"), Parsed));
+    TestTrue(TEXT("Rejected input leaves the output alone"), Parsed == FromWire);
+    TestFalse(TEXT("Default identity is invalid"), FSpaceTimeDBIdentity().IsValid());
+    TestEqual(TEXT("Zero identity hashes like the default"), GetTypeHash(FSpaceTimeDBIdentity::FromHex(TEXT("00"))), GetTypeHash(FSpaceTimeDBIdentity()));
+
+    // Identities key maps directly
+    TMap<FSpaceTimeDBIdentity, int32> Players;
+    for (int32 i = 1; i <= 256; ++i)
+    {
+        Players.Add(FSpaceTimeDBIdentity::FromHex(FString::Printf(TEXT("%x"), i * 7919)), i);
+    }
+    const int32* Found = Players.Find(FSpaceTimeDBIdentity::FromHex(FString::Printf(TEXT("%x"), 100 * 7919)));
+    TestTrue(TEXT("Lookup by identity"), Found && *Found == 100);
+
+    // Reducers taking an Identity send hex over JSON and the raw bytes over BSATN
+    FString Frame;
+    FSpaceTimeDBProtocol::EncodeReducerCallJson(EonReducers::GiftPremiumItem.Name, EonReducers::GiftPremiumItem.MakeArgs(TEXT("cape"), FromWire), 1, Frame);
+    TestTrue(TEXT("JSON identity argument"), Frame.Contains(FString::Printf(TEXT("\"0x%s\""), *Hex)));
+
+    TArray<uint8> BinaryFrame;
+    FSpaceTimeDBProtocol::EncodeReducerCallBinary(EonReducers::GiftPremiumItem.Name, EonReducers::GiftPremiumItem.MakeArgs(TEXT("cape"), FromWire), 1, BinaryFrame);
+    // The identity is the last argument, followed by request_id (u32) and flags (u8)
+    const int32 IdentityOffset = BinaryFrame.Num() - FSpaceTimeDBIdentity::NumBytes - 5;
+    TestTrue(TEXT("BSATN identity argument"), IdentityOffset > 0 &&
+        FMemory::Memcmp(BinaryFrame.GetData() + IdentityOffset, Bytes, FSpaceTimeDBIdentity::NumBytes) == 0);
+
+    return true;
+}
+
+bool FSpaceTimeDBSchemaTest::RunTest(const FString& Parameters)
+{
+    // Generated column tables line up with the row structs
+    TestEqual(TEXT("Player column names"), static_cast<int32>(UE_ARRAY_COUNT(FSpaceTimeDBPlayerRow::ColumnNames)),
+        static_cast<int32>(FSpaceTimeDBPlayerRow::EColumn::Num));
+    TestEqual(TEXT("Item definition column names"), static_cast<int32>(UE_ARRAY_COUNT(FSpaceTimeDBItemDefinitionRow::ColumnNames)),
+        static_cast<int32>(FSpaceTimeDBItemDefinitionRow::EColumn::Num));
+    TestEqual(TEXT("Table names come from the server"), FString(FSpaceTimeDBInventoryRow::TableName), FString(TEXT("inventory_item")));
+
+    FSpaceTimeDBServerMessage Message;
+    TestTrue(TEXT("Item definitions should decode"), FSpaceTimeDBProtocol::DecodeJsonServerMessage(
+        TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[")
+        TEXT("{\"table\":\"item_definition\",\"item_id\":\"health_potion\",\"display_name\":\"Health Potion\",")
+        TEXT("\"description\":\"Restores 50 HP\",\"item_type\":\"consumable\",\"max_stack\":20,\"icon_path\":\"\",")
+        TEXT("\"is_premium\":false,\"premium_currency_price\":0,\"is_exclusive\":false,\"rarity\":2},")
+        TEXT("{\"table\":\"inventory_item\",\"entry_id\":5,\"owner_identity\":\"aa\",\"item_id\":\"health_potion\",\"quantity\":3,\"slot_index\":0}]}"),
+        Message));
+    TestEqual(TEXT("One definition row"), Message.ItemDefinitions.Num(), 1);
+    if (Message.ItemDefinitions.Num() == 1)
+    {
+        const FSpaceTimeDBItemDefinitionRow& Definition = Message.ItemDefinitions[0].Row;
+        TestEqual(TEXT("max_stack is read"), static_cast<int32>(Definition.MaxStack), 20);
+        TestEqual(TEXT("display_name is read"), Definition.DisplayName, FString(TEXT("Health Potion")));
+        TestEqual(TEXT("u8 columns are read"), static_cast<int32>(Definition.Rarity), 2);
+    }
+
+    // Definitions reach the inventory the rows land in
+    UInventoryComponent* Inventory = NewObject<UInventoryComponent>();
+    Inventory->ApplyServerItemDefinitions(Message.ItemDefinitions);
+    Inventory->ApplyServerInventoryRows(Message.InventoryItems, FSpaceTimeDBIdentity::FromHex(TEXT("aa")));
+    const TArray<FInventorySlot> Slots = Inventory->GetAllItems();
+    TestEqual(TEXT("Row applied"), Slots.Num(), 1);
+    if (Slots.Num() == 1)
+    {
+        const FInventorySlot& Slot = Slots[0];
+        TestEqual(TEXT("Slot takes the server display name"), Slot.DisplayName, FString(TEXT("Health Potion")));
+        TestEqual(TEXT("Slot takes the server stack limit"), Slot.MaxStack, 20);
+        TestTrue(TEXT("Slot takes the server rarity"), Slot.Rarity == EItemRarity::Rare);
+    }
+
+    return true;
+}
+
+bool FSpaceTimeDBNetWorkerTest::RunTest(const FString& Parameters)
+{
+    using namespace EonProtocolTest;
+
+    FSpaceTimeDBNetWorker Worker;
+    if (!Worker.Start())
+    {
+        AddInfo(TEXT("Platform has no multithreading; skipping"));
+        return true;
+    }
+
+    FString JsonFrame;
+    TArray<uint8> BinaryFrame;
+    BuildPlayerUpdate(JsonFrame, BinaryFrame);
+
+    const FTCHARToUTF8 JsonUtf8(*JsonFrame);
+    const TArray<uint8> JsonBytes(reinterpret_cast<const uint8*>(JsonUtf8.Get()), JsonUtf8.Length());
+
+    constexpr int32 NumFrames = 20;
+    for (int32 i = 0; i < NumFrames; ++i)
+    {
+        FSpaceTimeDBInboundFrame Frame;
+        Frame.bBinary = (i % 2) == 0;
+        Frame.Bytes = Frame.bBinary ? BinaryFrame : JsonBytes;
+        Frame.Generation = 3;
+        Worker.EnqueueInbound(MoveTemp(Frame));
+    }
+
+    FSpaceTimeDBCallBatch Batch;
+    Batch.bBinary = true;
+    Batch.Generation = 4;
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        Batch.Calls.Add({ TEXT("update_player_position"), MakePositionArgs(i) });
+    }
+    Worker.EnqueueCalls(MoveTemp(Batch));
+
+    int32 DecodedCount = 0;
+    int32 EncodedCount = 0;
+    const double Deadline = FPlatformTime::Seconds() + 5.0;
+    while ((DecodedCount < NumFrames || EncodedCount < NumCalls) && FPlatformTime::Seconds() < Deadline)
+    {
+        FSpaceTimeDBServerMessage Message;
+        uint32 Generation = 0;
+        while (Worker.DequeueDecoded(Message, &Generation))
+        {
+            TestEqual(TEXT("Decoded message should carry every row"), Message.Players.Num(), NumPlayers);
+            TestEqual(TEXT("Decoded message should keep its frame's connection"), Generation, 3u);
+            ++DecodedCount;
+        }
+
+        // Frames keep their connection and call, so the manager can queue them again if that connection is gone
+        FSpaceTimeDBOutboundFrame Frame;
+        while (Worker.DequeueEncoded(Frame))
+        {
+            TestTrue(TEXT("Encoded frame should be binary"), Frame.bBinary && Frame.Bytes.Num() > 0);
+            TestEqual(TEXT("Encoded frame should keep its batch's connection"), Frame.Generation, 4u);
+            TestTrue(TEXT("Encoded frame should hold its call"), Frame.Call.IsSet() && Frame.Call->ReducerName == TEXT("update_player_position"));
+            ++EncodedCount;
+        }
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    TestEqual(TEXT("All inbound frames should be decoded"), DecodedCount, NumFrames);
+    TestEqual(TEXT("Each call should get its own frame"), EncodedCount, NumCalls);
+    TestEqual(TEXT("Queues should be empty"), Worker.GetInboundDepth() + Worker.GetDecodedDepth(), 0);
+
+    Worker.Shutdown();
+    return true;
+}
+
+bool FSpaceTimeDBCallBatchingTest::RunTest(const FString& Parameters)
+{
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    FSpaceTimeDBConfig Config;
+    Config.bUseNetworkThread = false;
+    Config.bBatchOutgoingCalls = true;
+    Manager->Connect(Config);
+    Loopback->GetClientFrames().Reset();
+
+    // Positions interleaved with calls that must all arrive, in order
+    Manager->UpdatePlayerPosition(FVector(100.0, 0.0, 0.0), FRotator::ZeroRotator);
+    Manager->SetPlayerOnline(true);
+    Manager->UpdatePlayerPosition(FVector(200.0, 0.0, 0.0), FRotator::ZeroRotator);
+    Manager->CreateInstance(TEXT("Hall"), 4, true);
+    Manager->SetPlayerOnline(false);
+    Manager->UpdatePlayerPosition(FVector(300.0, 0.0, 0.0), FRotator::ZeroRotator);
+    TestEqual(TEXT("Nothing should be sent before the flush"), Loopback->GetClientFrames().Num(), 0);
+
+    Manager->FlushOutgoingCalls();
+
+    TArray<FString> Reducers;
+    TArray<TSharedPtr<FJsonObject>> Calls;
+    for (const FSpaceTimeDBLoopbackTransport::FFrame& Frame : Loopback->GetClientFrames())
+    {
+        FUTF8ToTCHAR Utf8(reinterpret_cast<const ANSICHAR*>(Frame.Bytes.GetData()), Frame.Bytes.Num());
+        TSharedPtr<FJsonObject> Call;
+        if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(Utf8.Length(), Utf8.Get())), Call) || !Call.IsValid())
+        {
+            AddError(TEXT("Each frame should hold one JSON call"));
+            return false;
+        }
+        Reducers.Add(Call->GetStringField(TEXT("call")));
+        Calls.Add(Call);
+    }
+
+    // Gameplay calls keep their order; the telemetry lane follows with one position
+    const TArray<FString> Expected = { TEXT("set_player_online"), TEXT("create_instance"), TEXT("set_player_online"), TEXT("update_player_position") };
+    TestTrue(TEXT("Calls should keep their order, with positions collapsed to one"), Reducers == Expected);
+    if (Calls.Num() == Expected.Num())
+    {
+        TestEqual(TEXT("The first online call should be the first sent"), Calls[0]->GetArrayField(TEXT("args"))[0]->AsString(), FString(TEXT("true")));
+        TestEqual(TEXT("The surviving position should be the last one"),
+            FCString::Atof(*Calls[3]->GetArrayField(TEXT("args"))[0]->AsString()), 300.0f);
+    }
+
+    Manager->FlushOutgoingCalls();
+    TestEqual(TEXT("A flush with nothing queued should send nothing"), Loopback->GetClientFrames().Num(), Expected.Num());
+
+    Manager->Disconnect();
+    return true;
+}
+
+// ============================================================================
+// SPACETIMEDB TABLE CACHE TESTS
+// ============================================================================
+
+namespace EonCacheTest
+{
+    TSpaceTimeDBRowUpdate<FSpaceTimeDBWorldItemRow> MakeWorldItem(uint64 Id, uint32 Quantity, ESpaceTimeDBRowOp Op = ESpaceTimeDBRowOp::Upsert)
+    {
+        TSpaceTimeDBRowUpdate<FSpaceTimeDBWorldItemRow> Update;
+        Update.Row.WorldItemId = Id;
+        Update.Row.InstanceId = 1;
+        Update.Row.ItemId = TEXT("health_potion");
+        Update.Row.Quantity = Quantity;
+        Update.Op = Op;
+        return Update;
+    }
+}
+
+bool FSpaceTimeDBTableCacheDeltaTest::RunTest(const FString& Parameters)
+{
+    using namespace EonCacheTest;
+
+    USpaceTimeDBTableCache* Cache = NewObject<USpaceTimeDBTableCache>();
+    TSpaceTimeDBTable<FSpaceTimeDBWorldItemRow>& WorldItems = Cache->WorldItems();
+
+    int32 Inserts = 0, Updates = 0, Deletes = 0;
+    WorldItems.OnInsert.AddLambda([&Inserts](const FSpaceTimeDBWorldItemRow&) { ++Inserts; });
+    WorldItems.OnUpdate.AddLambda([&Updates](const FSpaceTimeDBWorldItemRow& Old, const FSpaceTimeDBWorldItemRow& New) { ++Updates; });
+    WorldItems.OnDelete.AddLambda([&Deletes](const FSpaceTimeDBWorldItemRow&) { ++Deletes; });
+
+    FSpaceTimeDBServerMessage Message;
+    Message.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+    Message.WorldItems = { MakeWorldItem(10, 1), MakeWorldItem(20, 2), MakeWorldItem(30, 3) };
+    Cache->ApplyServerMessage(Message);
+
+    Message.WorldItems = { MakeWorldItem(20, 5), MakeWorldItem(10, 0, ESpaceTimeDBRowOp::Delete) };
+    Cache->ApplyServerMessage(Message);
+
+    TestEqual(TEXT("Insert callbacks"), Inserts, 3);
+    TestEqual(TEXT("Update callbacks"), Updates, 1);
+    TestEqual(TEXT("Delete callbacks"), Deletes, 1);
+    TestEqual(TEXT("Two rows should remain"), WorldItems.Num(), 2);
+    TestNull(TEXT("Deleted row should be gone"), WorldItems.Find(10));
+
+    // Row 30 was swapped into the deleted slot; its index entry must follow it
+    const FSpaceTimeDBWorldItemRow* Moved = WorldItems.Find(30);
+    TestTrue(TEXT("Swapped row should still be indexed"), Moved && Moved->Quantity == 3);
+
+    const FSpaceTimeDBWorldItemRow* Updated = WorldItems.Find(20);
+    TestTrue(TEXT("Updated row should hold the new value"), Updated && Updated->Quantity == 5);
+
+    return true;
+}
+
+bool FSpaceTimeDBTableCacheSnapshotTest::RunTest(const FString& Parameters)
+{
+    using namespace EonCacheTest;
+
+    USpaceTimeDBTableCache* Cache = NewObject<USpaceTimeDBTableCache>();
+
+    FSpaceTimeDBServerMessage Message;
+    Message.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+    Message.WorldItems = { MakeWorldItem(1, 1), MakeWorldItem(2, 1), MakeWorldItem(3, 1) };
+    Cache->ApplyServerMessage(Message);
+
+    // A fresh subscription only contains rows 2 and 4: 1 and 3 must be dropped
+    Message.Type = ESpaceTimeDBMessageType::InitialSubscription;
+    Message.WorldItems = { MakeWorldItem(2, 7), MakeWorldItem(4, 1) };
+    Cache->ApplyServerMessage(Message);
+
+    const TSpaceTimeDBTable<FSpaceTimeDBWorldItemRow>& WorldItems = Cache->WorldItems();
+    TestEqual(TEXT("Snapshot should replace table contents"), WorldItems.Num(), 2);
+    TestFalse(TEXT("Row missing from snapshot should be removed"), WorldItems.Contains(1));
+    TestFalse(TEXT("Row missing from snapshot should be removed"), WorldItems.Contains(3));
+    TestTrue(TEXT("New row should be present"), WorldItems.Contains(4));
+
+    const FSpaceTimeDBWorldItemRow* Kept = WorldItems.Find(2);
+    TestTrue(TEXT("Kept row should be updated"), Kept && Kept->Quantity == 7);
+
+    return true;
+}
+
+bool FSpaceTimeDBTableCacheResyncTest::RunTest(const FString& Parameters)
+{
+    using namespace EonCacheTest;
+
+    USpaceTimeDBTableCache* Cache = NewObject<USpaceTimeDBTableCache>();
+    TSpaceTimeDBTable<FSpaceTimeDBWorldItemRow>& WorldItems = Cache->WorldItems();
+
+    FSpaceTimeDBServerMessage Snapshot;
+    Snapshot.Type = ESpaceTimeDBMessageType::InitialSubscription;
+    Snapshot.WorldItems = { MakeWorldItem(1, 1), MakeWorldItem(2, 2), MakeWorldItem(3, 3) };
+    Cache->ApplyServerMessage(Snapshot);
+
+    int32 Inserts = 0, Updates = 0, Deletes = 0;
+    WorldItems.OnInsert.AddLambda([&Inserts](const FSpaceTimeDBWorldItemRow&) { ++Inserts; });
+    WorldItems.OnUpdate.AddLambda([&Updates](const FSpaceTimeDBWorldItemRow& Old, const FSpaceTimeDBWorldItemRow& New) { ++Updates; });
+    WorldItems.OnDelete.AddLambda([&Deletes](const FSpaceTimeDBWorldItemRow&) { ++Deletes; });
+
+    // Reconnecting resends the same rows: nothing changed, so nothing fires
+    Cache->ApplyServerMessage(Snapshot);
+    TestEqual(TEXT("Identical resync should not fire updates"), Updates, 0);
+    TestEqual(TEXT("Identical resync should not insert"), Inserts, 0);
+    TestEqual(TEXT("Identical resync should not delete"), Deletes, 0);
+
+    // Changes made while offline arrive as a diff against the cached rows
+    Snapshot.WorldItems = { MakeWorldItem(1, 1), MakeWorldItem(2, 5), MakeWorldItem(4, 1) };
+    Cache->ApplyServerMessage(Snapshot);
+    TestEqual(TEXT("Only the changed row should update"), Updates, 1);
+    TestEqual(TEXT("Only the new row should insert"), Inserts, 1);
+    TestEqual(TEXT("Only the missing row should delete"), Deletes, 1);
+
+    return true;
+}
+
+bool FSpaceTimeDBTableCacheStringKeyTest::RunTest(const FString& Parameters)
+{
+    USpaceTimeDBTableCache* Cache = NewObject<USpaceTimeDBTableCache>();
+
+    // SpaceTimeDB String keys are case-sensitive: these are two rows
+    FSpaceTimeDBServerMessage Message;
+    Message.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+    for (const TCHAR* Id : { TEXT("Lever_A"), TEXT("lever_a") })
+    {
+        TSpaceTimeDBRowUpdate<FSpaceTimeDBInteractableRow>& Update = Message.Interactables.AddDefaulted_GetRef();
+        Update.Row.InteractableId = Id;
+        Update.Row.InstanceId = 1;
+        Update.Row.bIsActive = FCString::Strcmp(Id, TEXT("Lever_A")) == 0;
+    }
+    Cache->ApplyServerMessage(Message);
+
+    TestEqual(TEXT("Keys differing in case should be separate rows"), Cache->Interactables().Num(), 2);
+    TestTrue(TEXT("Lookups should match case"), Cache->IsInteractableActive(TEXT("Lever_A")) && !Cache->IsInteractableActive(TEXT("lever_a")));
+    TestNull(TEXT("A key in neither case should not be found"), Cache->Interactables().Find(TEXT("LEVER_A")));
+
+    // A snapshot naming only one of them removes the other
+    Message.Type = ESpaceTimeDBMessageType::InitialSubscription;
+    Message.Interactables.RemoveAt(1);
+    Cache->ApplyServerMessage(Message);
+    TestEqual(TEXT("The snapshot should keep only the row it names"), Cache->Interactables().Num(), 1);
+    TestNull(TEXT("The other casing should be gone"), Cache->Interactables().Find(TEXT("lever_a")));
+
+    // The local authority's stores are keyed the same way
+    FSpaceTimeDBLocalAuthority::FStore Store;
+    FSpaceTimeDBItemDefinitionRow Definition;
+    Definition.ItemId = TEXT("Sword");
+    Store.ItemDefinitions.Add(Definition.ItemId, Definition);
+    TestNull(TEXT("Item definitions should match case"), Store.ItemDefinitions.Find(TEXT("sword")));
+
+    Cache->Reset();
+    return true;
+}
+
+bool FSpaceTimeDBTableCacheTimeSliceTest::RunTest(const FString& Parameters)
+{
+    using namespace EonCacheTest;
+
+    USpaceTimeDBTableCache* Cache = NewObject<USpaceTimeDBTableCache>();
+
+    // A budget this small forces one chunk of rows per slice
+    Cache->SetApplyBudget(0.0001f, 10);
+
+    int32 SnapshotsCompleted = 0;
+    Cache->OnSnapshotComplete.AddLambda([&SnapshotsCompleted]() { ++SnapshotsCompleted; });
+
+    constexpr int32 NumItems = 1000;
+    FSpaceTimeDBServerMessage Snapshot;
+    Snapshot.Type = ESpaceTimeDBMessageType::InitialSubscription;
+    for (int32 i = 0; i < NumItems; ++i)
+    {
+        Snapshot.WorldItems.Add(MakeWorldItem(i, 1));
+    }
+
+    Cache->ApplyServerMessage(Snapshot);
+    const TSpaceTimeDBTable<FSpaceTimeDBWorldItemRow>& WorldItems = Cache->WorldItems();
+    TestTrue(TEXT("Large snapshot should not apply in one call"), WorldItems.Num() < NumItems);
+    TestTrue(TEXT("Cache should report pending rows"), Cache->IsApplyingUpdates());
+
+    // A small delta arriving mid-snapshot must wait its turn, not be overwritten by it
+    FSpaceTimeDBServerMessage Delta;
+    Delta.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+    Delta.WorldItems = { MakeWorldItem(NumItems - 1, 0, ESpaceTimeDBRowOp::Delete) };
+    Cache->ApplyServerMessage(Delta);
+
+    int32 Slices = 1;
+    while (Cache->IsApplyingUpdates() && Slices < NumItems)
+    {
+        TestEqual(TEXT("Snapshot should not complete early"), SnapshotsCompleted, 0);
+        Cache->ProcessPendingUpdates();
+        ++Slices;
+    }
+    AddInfo(FString::Printf(TEXT("Applied %d rows over %d slices"), NumItems, Slices));
+
+    TestFalse(TEXT("Queue should drain"), Cache->IsApplyingUpdates());
+    TestEqual(TEXT("Snapshot complete should fire once"), SnapshotsCompleted, 1);
+    TestEqual(TEXT("Delta should apply after the snapshot"), WorldItems.Num(), NumItems - 1);
+    TestFalse(TEXT("Deleted row should be gone"), WorldItems.Contains(NumItems - 1));
+
+    Cache->Reset();
+    return true;
+}
+
+bool FSpaceTimeDBTableCacheFrameBudgetTest::RunTest(const FString& Parameters)
+{
+    using namespace EonCacheTest;
+
+    USpaceTimeDBTableCache* Cache = NewObject<USpaceTimeDBTableCache>();
+    Cache->SetApplyBudget(0.0001f, 10);
+
+    constexpr int32 NumItems = 1000;
+    FSpaceTimeDBServerMessage First;
+    First.Type = ESpaceTimeDBMessageType::TransactionUpdate;
+    FSpaceTimeDBServerMessage Second = First;
+    for (int32 i = 0; i < NumItems; ++i)
+    {
+        First.WorldItems.Add(MakeWorldItem(i, 1));
+        Second.WorldItems.Add(MakeWorldItem(NumItems + i, 1));
+    }
+
+    // The first arrival spends this frame's budget
+    Cache->ApplyServerMessage(First);
+    const int32 AfterFirst = Cache->WorldItems().Num();
+    TestTrue(TEXT("The first arrival should apply some rows"), AfterFirst > 0 && AfterFirst < NumItems);
+
+    // A second arrival in the same frame gets no budget of its own
+    Cache->ApplyServerMessage(Second);
+    TestEqual(TEXT("A second arrival in the same frame should only queue"), Cache->WorldItems().Num(), AfterFirst);
+
+    // The ticker still makes progress, and the queue drains over later calls
+    int32 Calls = 0;
+    while (Cache->IsApplyingUpdates() && Calls++ < 2 * NumItems)
+    {
+        Cache->ProcessPendingUpdates();
+    }
+    TestEqual(TEXT("Both messages should apply in the end"), Cache->WorldItems().Num(), 2 * NumItems);
+
+    Cache->Reset();
+    return true;
+}
+
+bool FSpaceTimeDBInventoryBatchTest::RunTest(const FString& Parameters)
+{
+    const FSpaceTimeDBIdentity Self = FSpaceTimeDBIdentity::FromHex(TEXT("aa"));
+    const FSpaceTimeDBIdentity Other = FSpaceTimeDBIdentity::FromHex(TEXT("bb"));
+
+    UInventoryComponent* Inventory = NewObject<UInventoryComponent>();
+    Inventory->SetAutoSortEnabled(true);
+
+    // Initial snapshot: 500 of our rows plus one row belonging to someone else
+    TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>> Rows;
+    for (int32 i = 0; i < 500; ++i)
+    {
+        TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>& Update = Rows.AddDefaulted_GetRef();
+        Update.Row.EntryId = 1000 + i;
+        Update.Row.OwnerIdentity = Self;
+        Update.Row.ItemId = FString::Printf(TEXT("item_%d"), i % 10);
+        Update.Row.Quantity = 1;
+        Update.Row.SlotIndex = i;
+    }
+    TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>& Foreign = Rows.AddDefaulted_GetRef();
+    Foreign.Row.EntryId = 1;
+    Foreign.Row.OwnerIdentity = Other;
+    Foreign.Row.ItemId = TEXT("stolen_sword");
+    Foreign.Row.Quantity = 1;
+
+    const double Start = FPlatformTime::Seconds();
+    Inventory->ApplyServerInventoryRows(Rows, Self);
+    AddInfo(FString::Printf(TEXT("Applied %d-row snapshot in %.3f ms"), Rows.Num(), (FPlatformTime::Seconds() - Start) * 1000.0));
+
+    TestEqual(TEXT("Only our rows should be applied"), Inventory->GetAllItems().Num(), 500);
+    TestFalse(TEXT("Other players' rows should be ignored"), Inventory->HasItem(TEXT("stolen_sword")));
+
+    // A transaction deleting one row and updating another
+    TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>> Delta;
+    Delta.Add(Rows[0]);
+    Delta[0].Op = ESpaceTimeDBRowOp::Delete;
+    Delta.Add(Rows[1]);
+    Delta[1].Row.Quantity = 5;
+    Inventory->ApplyServerInventoryRows(Delta, Self);
+
+    TestEqual(TEXT("Deleted row should be removed"), Inventory->GetAllItems().Num(), 499);
+    TestEqual(TEXT("Updated row should hold the new quantity"), Inventory->GetItemCount(TEXT("item_1")), 49 + 5);
+
+    return true;
+}
+
+bool FSpaceTimeDBInventoryResnapshotTest::RunTest(const FString& Parameters)
+{
+    const FSpaceTimeDBIdentity Self = FSpaceTimeDBIdentity::FromHex(TEXT("aa"));
+
+    UInventoryComponent* Inventory = NewObject<UInventoryComponent>();
+
+    TArray<TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>> Rows;
+    for (int32 i = 0; i < 3; ++i)
+    {
+        TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>& Update = Rows.AddDefaulted_GetRef();
+        Update.Row.EntryId = 100 + i;
+        Update.Row.OwnerIdentity = Self;
+        Update.Row.ItemId = FString::Printf(TEXT("item_%d"), i);
+        Update.Row.Quantity = 1;
+        Update.Row.SlotIndex = i;
+    }
+    Inventory->ApplyServerInventoryRows(Rows, Self, true);
+    TestEqual(TEXT("First snapshot should fill the inventory"), Inventory->GetAllItems().Num(), 3);
+
+    // item_1 was deleted on the server while we were disconnected; the resubscribe snapshot just omits it
+    Rows.RemoveAt(1);
+    Inventory->ApplyServerInventoryRows(Rows, Self, true);
+    TestEqual(TEXT("Rows missing from the snapshot should be removed"), Inventory->GetAllItems().Num(), 2);
+    TestFalse(TEXT("The dropped row should be gone"), Inventory->HasItem(TEXT("item_1")));
+    TestTrue(TEXT("Rows still in the snapshot should stay"), Inventory->HasItem(TEXT("item_0")) && Inventory->HasItem(TEXT("item_2")));
+
+    // A delta that omits rows removes nothing
+    Inventory->ApplyServerInventoryRows(TArrayView<const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>>(Rows.GetData(), 1), Self);
+    TestEqual(TEXT("A delta should not remove unmentioned rows"), Inventory->GetAllItems().Num(), 2);
+
+    // An empty snapshot means the inventory is empty
+    Inventory->ApplyServerInventoryRows(TArrayView<const TSpaceTimeDBRowUpdate<FSpaceTimeDBInventoryRow>>(), Self, true);
+    TestEqual(TEXT("An empty snapshot should clear the inventory"), Inventory->GetAllItems().Num(), 0);
+
+    return true;
+}
+
+// ============================================================================
+// SPACETIMEDB SUBSCRIPTION TESTS
+// ============================================================================
+
+bool FSpaceTimeDBSubscriptionScopeTest::RunTest(const FString& Parameters)
+{
+    FSpaceTimeDBSubscriptions Subscriptions;
+    Subscriptions.SetIdentity(FSpaceTimeDBIdentity::FromHex(TEXT("c0ffee")));
+
+    TArray<FString> Added, Removed;
+    TestTrue(TEXT("Initial set should need subscribing"), Subscriptions.Diff(Added, Removed));
+    Subscriptions.Commit();
+
+    for (const FString& Query : Subscriptions.GetActiveQueries())
+    {
+        TestFalse(TEXT("No unscoped world_item query outside an instance"), Query.Contains(TEXT("world_item")));
+    }
+
+    Added.Reset();
+    Removed.Reset();
+    TestFalse(TEXT("Unchanged scope should not resubscribe"), Subscriptions.Diff(Added, Removed));
+
+    Subscriptions.SetInstance(7);
+    Added.Reset();
+    Removed.Reset();
+    TestTrue(TEXT("Joining should change the set"), Subscriptions.Diff(Added, Removed));
+    TestEqual(TEXT("Joining adds the three instance queries"), Added.Num(), 3);
+    TestEqual(TEXT("Joining removes nothing"), Removed.Num(), 0);
+    TestTrue(TEXT("Queries are scoped to the instance"), Added.Contains(TEXT("SELECT * FROM world_item WHERE instance_id = 7")));
+    Subscriptions.Commit();
+
+    Subscriptions.SetInstance(9);
+    Added.Reset();
+    Removed.Reset();
+    Subscriptions.Diff(Added, Removed);
+    TestEqual(TEXT("Switching swaps the instance queries"), Added.Num(), 3);
+    TestEqual(TEXT("Switching drops the old instance queries"), Removed.Num(), 3);
+    // instance + item_definition, our player and inventory, three instance queries
+    TestEqual(TEXT("No query is duplicated"), Subscriptions.BuildQueries().Num(), 7);
+
+    return true;
+}
+
+// ============================================================================
+// SPACETIMEDB CONNECTION TESTS
+// ============================================================================
+
+bool FSpaceTimeDBReconnectBackoffTest::RunTest(const FString& Parameters)
+{
+    constexpr float Base = 1.0f;
+    constexpr float Max = 30.0f;
+
+    for (int32 Attempt = 1; Attempt <= 12; ++Attempt)
+    {
+        const float Cap = FMath::Min(Max, Base * FMath::Pow(2.0f, static_cast<float>(Attempt - 1)));
+        for (int32 Sample = 0; Sample < 50; ++Sample)
+        {
+            const float Delay = USpaceTimeDBManager::ComputeReconnectDelay(Attempt, Base, Max);
+            if (Delay < Cap * 0.5f || Delay > Cap)
+            {
+                AddError(FString::Printf(TEXT("Attempt %d delay %.3f outside [%.3f, %.3f]"), Attempt, Delay, Cap * 0.5f, Cap));
+                return true;
+            }
+        }
+    }
+
+    TestTrue(TEXT("Later attempts should wait at least half the cap"),
+        USpaceTimeDBManager::ComputeReconnectDelay(100, Base, Max) >= Max * 0.5f);
+
+    // Jitter: many clients dropped at once must not all retry at the same instant
+    TSet<int32> DistinctMillis;
+    for (int32 Sample = 0; Sample < 50; ++Sample)
+    {
+        DistinctMillis.Add(FMath::RoundToInt(USpaceTimeDBManager::ComputeReconnectDelay(5, Base, Max) * 1000.0f));
+    }
+    TestTrue(TEXT("Delays should be jittered"), DistinctMillis.Num() > 1);
+
+    return true;
+}
+
+bool FSpaceTimeDBLoopbackTransportTest::RunTest(const FString& Parameters)
+{
+    TestTrue(TEXT("loopback:// selects the loopback"), FSpaceTimeDBLoopbackTransport::IsLoopbackUrl(TEXT("loopback://test/database/subscribe/eon")));
+    TestFalse(TEXT("wss:// does not"), FSpaceTimeDBLoopbackTransport::IsLoopbackUrl(TEXT("wss://maincloud.spacetimedb.com")));
+
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+
+    // The test keeps the server end of the transport it hands the manager
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    FString RequestedUrl;
+    Manager->SetTransportFactory([Loopback, &RequestedUrl](const FSpaceTimeDBTransportParams& Params) -> TSharedRef<ISpaceTimeDBTransport>
+    {
+        RequestedUrl = Params.Url;
+        return Loopback;
+    });
+
+    FSpaceTimeDBConfig Config;
+    Config.Host = TEXT("loopback://test");
+    Config.bUseNetworkThread = false;
+    Manager->Connect(Config);
+
+    TestTrue(TEXT("Loopback should connect without a network"), Manager->IsConnected());
+    TestTrue(TEXT("Url should be built from host and module"), RequestedUrl.EndsWith(TEXT("/database/subscribe/eon")));
+    TestTrue(TEXT("Base subscription should be sent on connect"), Loopback->GetClientFrames().Num() > 0);
+
+    Loopback->GetClientFrames().Reset();
+    Loopback->ServerSendText(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"c0ffee\",\"token\":\"t\"}"));
+    TestTrue(TEXT("Identity should arrive through the pipeline"), Manager->GetIdentity() == FSpaceTimeDBIdentity::FromHex(TEXT("c0ffee")));
+    TestTrue(TEXT("Identity-scoped queries should be subscribed"), Loopback->GetClientFrames().Num() > 0);
+
+    int32 PlayerRows = 0;
+    Manager->OnPlayerRow.AddLambda([&PlayerRows](const FSpaceTimeDBPlayerRow&, ESpaceTimeDBRowOp) { ++PlayerRows; });
+    Loopback->ServerSendText(TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"player\",\"identity\":\"c0ffee\",\"username\":\"a\"}]}"));
+    TestEqual(TEXT("Rows should be dispatched"), PlayerRows, 1);
+
+    Loopback->GetClientFrames().Reset();
+    Manager->RegisterPlayer(TEXT("a"));
+    Manager->FlushOutgoingCalls();
+    TestEqual(TEXT("Reducer call should reach the server end"), Loopback->GetClientFrames().Num(), 1);
+    if (Loopback->GetClientFrames().Num() == 1)
+    {
+        const TArray<uint8>& Bytes = Loopback->GetClientFrames()[0].Bytes;
+        FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        TestTrue(TEXT("Frame should carry the reducer name"), FString(Text.Length(), Text.Get()).Contains(TEXT("register_player")));
+    }
+
+    Manager->Disconnect();
+    TestFalse(TEXT("Disconnect should close the loopback"), Loopback->IsConnected());
+
+    return true;
+}
+
+// ============================================================================
+// SPACETIMEDB CAPTURE TESTS
+// ============================================================================
+
+namespace EonCaptureTest
+{
+    void RecordText(FSpaceTimeDBCaptureWriter& Writer, bool bOutbound, const FString& Text)
+    {
+        FTCHARToUTF8 Utf8(*Text, Text.Len());
+        Writer.Record(bOutbound, false, reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    }
+}
+
+bool FSpaceTimeDBCaptureRoundTripTest::RunTest(const FString& Parameters)
+{
+    using namespace EonCaptureTest;
+
+    const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("RoundTrip.eoncap"));
+    {
+        FSpaceTimeDBCaptureWriter Writer;
+        TestTrue(TEXT("Capture should open"), Writer.Open(Path));
+        RecordText(Writer, false, TEXT("{\"type\":\"IdentityToken\",\"identity\":\"c0ffee\"}"));
+        RecordText(Writer, true, TEXT("{\"call\":\"register_player\",\"args\":[\"a\"]}"));
+        const uint8 Binary[] = { 0, 3, 0xff };
+        Writer.Record(false, true, Binary, static_cast<int32>(UE_ARRAY_COUNT(Binary)));
+        TestEqual(TEXT("Frames counted"), Writer.GetNumFrames(), 3);
+    }
+
+    TArray<FSpaceTimeDBCaptureFrame> Frames;
+    TestTrue(TEXT("Capture should load"), FSpaceTimeDBCapture::Load(Path, Frames));
+    TestEqual(TEXT("All frames should load"), Frames.Num(), 3);
+    if (Frames.Num() == 3)
+    {
+        TestFalse(TEXT("First frame is inbound"), Frames[0].bOutbound);
+        TestTrue(TEXT("Second frame is outbound"), Frames[1].bOutbound);
+        TestTrue(TEXT("Third frame is binary"), Frames[2].bBinary && !Frames[2].bOutbound);
+        TestEqual(TEXT("Binary payload should survive"), Frames[2].Bytes.Num(), 3);
+        TestTrue(TEXT("Timestamps should not go backwards"), Frames[0].Seconds <= Frames[1].Seconds && Frames[1].Seconds <= Frames[2].Seconds);
+    }
+
+    // A truncated file must be rejected rather than replayed partially garbled
+    TArray<uint8> Bytes;
+    FFileHelper::LoadFileToArray(Bytes, *Path);
+    Bytes.SetNum(Bytes.Num() - 1);
+    TArray<FSpaceTimeDBCaptureFrame> Truncated;
+    TestFalse(TEXT("Truncated capture should fail"), FSpaceTimeDBCapture::Parse(Bytes, Truncated));
+
+    IFileManager::Get().Delete(*Path);
+    return true;
+}
+
+bool FSpaceTimeDBCaptureRedactTest::RunTest(const FString& Parameters)
+{
+    // Binary: compression, tag, identity, token, connection id
+    TArray<uint8> Binary = { 0, 3 };
+    Binary.AddZeroed(FSpaceTimeDBIdentity::NumBytes);
+    Binary[2] = 0xc0;
+    FBsatnWriter Writer(Binary);
+    Writer.WriteString(TEXT("secret-bearer"));
+    Binary.AddZeroed(16);
+
+    TArray<uint8> Redacted;
+    TestTrue(TEXT("A binary identity message should be redacted"), FSpaceTimeDBProtocol::RedactIdentityToken(Binary.GetData(), Binary.Num(), true, Redacted));
+    FSpaceTimeDBServerMessage Decoded;
+    TestTrue(TEXT("The redacted binary frame should decode"), FSpaceTimeDBProtocol::DecodeBinaryServerMessage(Redacted.GetData(), Redacted.Num(), Decoded));
+    TestTrue(TEXT("The binary token should be gone"), Decoded.Token.IsEmpty());
+    TestEqual(TEXT("The identity should stay"), Decoded.Identity.GetBytes()[0], static_cast<uint8>(0xc0));
+    TestEqual(TEXT("Only the token should be removed"), Redacted.Num(), Binary.Num() - 13);
+
+    const FTCHARToUTF8 Transaction(TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[]}"));
+    TestFalse(TEXT("Other messages should be left alone"),
+        FSpaceTimeDBProtocol::RedactIdentityToken(reinterpret_cast<const uint8*>(Transaction.Get()), Transaction.Length(), false, Redacted));
+
+    // Through the manager: the session works, the capture holds no token
+    const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("Redact.eoncap"));
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    FSpaceTimeDBConfig Config;
+    Config.bUseNetworkThread = false;
+    Manager->Connect(Config);
+    TestTrue(TEXT("Capture should start"), Manager->StartCapture(Path));
+    Loopback->ServerSendText(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"c0ffee\",\"token\":\"secret-bearer\"}"));
+    Manager->StopCapture();
+    TestTrue(TEXT("The identity should still be applied"), Manager->GetIdentity() == FSpaceTimeDBIdentity::FromHex(TEXT("c0ffee")));
+    Manager->Disconnect();
+
+    TArray<FSpaceTimeDBCaptureFrame> Frames;
+    TestTrue(TEXT("Capture should load"), FSpaceTimeDBCapture::Load(Path, Frames));
+    IFileManager::Get().Delete(*Path);
+
+    bool bFoundIdentity = false;
+    for (const FSpaceTimeDBCaptureFrame& Frame : Frames)
+    {
+        const FString Text(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Frame.Bytes.GetData()), Frame.Bytes.Num()).Get());
+        TestFalse(TEXT("No captured frame should hold the token"), Text.Contains(TEXT("secret-bearer")));
+
+        FSpaceTimeDBServerMessage Message;
+        if (!Frame.bOutbound && FSpaceTimeDBProtocol::DecodeJsonServerMessage(Frame.Bytes.GetData(), Frame.Bytes.Num(), Message) &&
+            Message.Type == ESpaceTimeDBMessageType::IdentityToken)
+        {
+            bFoundIdentity = true;
+            TestTrue(TEXT("The captured identity message should have an empty token"), Message.Token.IsEmpty());
+        }
+    }
+    TestTrue(TEXT("The identity message should still be captured"), bFoundIdentity);
+    return true;
+}
+
+bool FSpaceTimeDBReplayBenchmarkTest::RunTest(const FString& Parameters)
+{
+    using namespace EonCaptureTest;
+
+    // A synthetic session: identity, then transactions touching our inventory and nearby players
+    constexpr int32 NumTransactions = 500;
+    const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ReplayBenchmark.eoncap"));
+    {
+        FSpaceTimeDBCaptureWriter Writer;
+        TestTrue(TEXT("Capture should open"), Writer.Open(Path));
+        RecordText(Writer, false, TEXT("{\"type\":\"IdentityToken\",\"identity\":\"c0ffee\"}"));
+        for (int32 i = 0; i < NumTransactions; ++i)
+        {
+            RecordText(Writer, false, FString::Printf(TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[")
+                TEXT("{\"table\":\"inventory_item\",\"entry_id\":%d,\"owner_identity\":\"c0ffee\",\"item_id\":\"item_%d\",\"quantity\":%d,\"slot_index\":%d},")
+                TEXT("{\"table\":\"player\",\"identity\":\"%08x\",\"username\":\"Player\",\"position_x\":%d,\"is_online\":true}]}"),
+                i % 50, i % 10, 1 + i % 7, i % 50, i % 20 + 1, i));
+        }
+    }
+
+    TArray<FSpaceTimeDBCaptureFrame> Frames;
+    TestTrue(TEXT("Capture should load"), FSpaceTimeDBCapture::Load(Path, Frames));
+    IFileManager::Get().Delete(*Path);
+
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    FSpaceTimeDBConfig Config;
+    Config.bUseNetworkThread = false;
+    Manager->Connect(Config);
+
+    // The same listeners the game wires up: inventory from the manager, players through the cache
+    UInventoryComponent* Inventory = NewObject<UInventoryComponent>();
+    Manager->OnServerMessage.AddLambda([Inventory, Manager](const FSpaceTimeDBServerMessage& Message)
+    {
+        Inventory->ApplyServerInventoryRows(Message.InventoryItems, Manager->GetIdentity());
+    });
+
+    USpaceTimeDBTableCache* Cache = NewObject<USpaceTimeDBTableCache>();
+    Manager->OnServerMessage.AddUObject(Cache, &USpaceTimeDBTableCache::ApplyServerMessage);
+
+    FSpaceTimeDBReplayDriver Driver(MoveTemp(Frames), Loopback, 0.0f);
+    Driver.RunToEnd();
+    const FSpaceTimeDBReplayReport Report = Driver.GetReport();
+    AddInfo(FString::Printf(TEXT("Replay: %s"), *Report.ToString()));
+
+    TestTrue(TEXT("Replay should finish"), Driver.IsFinished());
+    TestEqual(TEXT("Every inbound frame should be replayed"), Report.FramesReplayed, NumTransactions + 1);
+    TestTrue(TEXT("Identity should come from the capture"), Manager->GetIdentity() == FSpaceTimeDBIdentity::FromHex(TEXT("c0ffee")));
+    TestEqual(TEXT("Inventory should hold one slot per entry"), Inventory->GetAllItems().Num(), 50);
+    TestEqual(TEXT("Cache should hold every player seen"), Cache->Players().Num(), 20);
+
+    Manager->Disconnect();
+    return true;
+}
+
+// ============================================================================
+// SPACETIMEDB NETWORK SIMULATION TESTS
+// ============================================================================
+
+bool FSpaceTimeDBNetSimTransportTest::RunTest(const FString& Parameters)
+{
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    FSpaceTimeDBNetSimTransport Sim(Loopback);
+    Sim.SetSeed(1);
+
+    FSpaceTimeDBNetSimSettings Settings;
+    Settings.LatencyMs = 100.0f;
+    Sim.SetSettingsOverride(Settings);
+
+    TArray<uint8> Received;
+    bool bCleanClose = true;
+    Sim.OnFrame.BindLambda([&Received](TArray<uint8>& Frame, bool) { Received.Add(Frame[0]); });
+    Sim.OnClosed.BindLambda([&bCleanClose](int32, const FString&, bool bWasClean) { bCleanClose = bWasClean; });
+
+    // The handshake travels the link like everything else
+    Sim.Connect();
+    TestFalse(TEXT("Connect should take the latency"), Sim.IsConnected());
+    Sim.Tick(0.05f);
+    TestFalse(TEXT("Still connecting halfway"), Sim.IsConnected());
+    Sim.Tick(0.06f);
+    TestTrue(TEXT("Connected after the latency"), Sim.IsConnected());
+
+    for (uint8 i = 0; i < 3; ++i)
+    {
+        Loopback->ServerSendBinary({ i });
+    }
+    Sim.Tick(0.05f);
+    TestEqual(TEXT("Frames should be held for the latency"), Received.Num(), 0);
+    Sim.Tick(0.06f);
+    TestEqual(TEXT("Frames should then arrive together"), Received.Num(), 3);
+    TestTrue(TEXT("In order without reordering"), Received.Num() == 3 && Received[0] == 0 && Received[2] == 2);
+
+    // 8 kbit/s moves 1000 bytes a second: a 500-byte frame takes half a second to send
+    Settings.LatencyMs = 0.0f;
+    Settings.UpKbps = 8;
+    Sim.SetSettingsOverride(Settings);
+    Loopback->GetClientFrames().Reset();
+    TArray<uint8> Large;
+    Large.SetNumZeroed(500);
+    Sim.SendBinary(Large.GetData(), Large.Num());
+    Sim.Tick(0.4f);
+    TestEqual(TEXT("Throttled frame should still be sending"), Loopback->GetClientFrames().Num(), 0);
+    Sim.Tick(0.2f);
+    TestEqual(TEXT("Throttled frame should arrive"), Loopback->GetClientFrames().Num(), 1);
+
+    // With jitter and reordering, some frames overtake earlier ones
+    Settings = FSpaceTimeDBNetSimSettings();
+    Settings.JitterMs = 200.0f;
+    Settings.ReorderPercent = 100.0f;
+    Sim.SetSettingsOverride(Settings);
+    Received.Reset();
+    for (uint8 i = 0; i < 50; ++i)
+    {
+        Loopback->ServerSendBinary({ i });
+    }
+    Sim.Tick(1.0f);
+    TestEqual(TEXT("Every reordered frame should arrive"), Received.Num(), 50);
+    bool bReordered = false;
+    for (int32 i = 1; i < Received.Num(); ++i)
+    {
+        bReordered |= Received[i] < Received[i - 1];
+    }
+    TestTrue(TEXT("Some frames should arrive out of order"), bReordered);
+
+    // A simulated drop loses what is in flight and is reported as unclean
+    Settings = FSpaceTimeDBNetSimSettings();
+    Settings.LatencyMs = 100.0f;
+    Sim.SetSettingsOverride(Settings);
+    Loopback->ServerSendBinary({ 99 });
+    Sim.SimulateDisconnect();
+    TestFalse(TEXT("Dropped connection should be down"), Sim.IsConnected());
+    TestFalse(TEXT("Drop should be unclean"), bCleanClose);
+    TestEqual(TEXT("In-flight frames should be lost"), Sim.GetNumInFlight(), 0);
+    TestEqual(TEXT("Drop should be counted"), Sim.GetNumSimulatedDisconnects(), 1);
+
+    return true;
+}
+
+bool FSpaceTimeDBNetSimSyncTest::RunTest(const FString& Parameters)
+{
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+
+    // Stand-in server: answers every position update with the player row it would write
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    int32 PositionCalls = 0;
+    Loopback->OnClientFrame.BindLambda([&Loopback, &PositionCalls](TArray<uint8>& Frame, bool)
+    {
+        FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Frame.GetData()), Frame.Num());
+        if (FString(Text.Length(), Text.Get()).Contains(TEXT("update_player_position")))
+        {
+            Loopback->ServerSendText(FString::Printf(
+                TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"player\",\"identity\":\"bb\",\"username\":\"b\",\"position_x\":%d,\"is_online\":true}]}"),
+                PositionCalls++));
+        }
+    });
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    FSpaceTimeDBConfig Config;
+    Config.bUseNetworkThread = false;
+    Config.bBatchOutgoingCalls = false;
+    Manager->Connect(Config);
+
+    FSpaceTimeDBNetSimTransport* Sim = Manager->GetNetSim();
+    TestNotNull(TEXT("Connections should be wrapped in the simulator"), Sim);
+    if (!Sim)
+    {
+        return false;
+    }
+
+    // Cellular conditions without random drops, so the run is comparable between builds
+    FSpaceTimeDBNetSimSettings Settings;
+    TestTrue(TEXT("3G profile should exist"), FSpaceTimeDBNetSimSettings::FindProfile(TEXT("3G"), Settings));
+    Settings.DisconnectsPerMinute = 0.0f;
+    Settings.ReorderPercent = 0.0f;
+    Sim->SetSettingsOverride(Settings);
+    Sim->SetSeed(7);
+
+    // 10 Hz position sync for 6 simulated seconds; the sim clock is the test's clock
+    constexpr int32 NumUpdates = 60;
+    constexpr float Step = 0.1f;
+    double SimTime = 0.0;
+    TArray<double> SentAt;
+    TArray<double> RoundTrips;
+    int32 LastX = -1;
+    bool bInOrder = true;
+    Manager->OnPlayerRow.AddLambda([&](const FSpaceTimeDBPlayerRow& Row, ESpaceTimeDBRowOp)
+    {
+        const int32 X = static_cast<int32>(Row.Position.X);
+        bInOrder &= X == LastX + 1;
+        LastX = X;
+        if (SentAt.IsValidIndex(X))
+        {
+            RoundTrips.Add(SimTime - SentAt[X]);
+        }
+    });
+
+    const double CpuStart = FPlatformTime::Seconds();
+    for (int32 Tick = 0; Tick < NumUpdates * 10 && RoundTrips.Num() < NumUpdates; ++Tick)
+    {
+        if (SentAt.Num() < NumUpdates)
+        {
+            SentAt.Add(SimTime);
+            Manager->UpdatePlayerPosition(FVector::ZeroVector, FRotator::ZeroRotator);
+        }
+        SimTime += Step;
+        Sim->Tick(Step);
+    }
+    const double CpuMs = (FPlatformTime::Seconds() - CpuStart) * 1000.0;
+
+    double MeanRtt = 0.0;
+    for (double Rtt : RoundTrips)
+    {
+        MeanRtt += Rtt / FMath::Max(RoundTrips.Num(), 1);
+    }
+    AddInfo(FString::Printf(TEXT("3G: %d/%d updates echoed, mean RTT %.0f ms, %.2f ms CPU"),
+        RoundTrips.Num(), NumUpdates, MeanRtt * 1000.0, CpuMs));
+
+    TestEqual(TEXT("Every update should be echoed"), RoundTrips.Num(), NumUpdates);
+    TestTrue(TEXT("Echoes should arrive in order"), bInOrder);
+    TestTrue(TEXT("Round trips should include both directions of latency"), MeanRtt >= 2.0 * Settings.LatencyMs / 1000.0);
+
+    Manager->Disconnect();
+    return true;
+}
+
+bool FSpaceTimeDBSendLanesTest::RunTest(const FString& Parameters)
+{
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    FSpaceTimeDBConfig Config;
+    Config.bUseNetworkThread = false;
+    Config.bBatchOutgoingCalls = false;
+    Config.BackpressureBufferedBytes = 1024;
+    Manager->Connect(Config);
+
+    FSpaceTimeDBNetSimTransport* Sim = Manager->GetNetSim();
+    TestNotNull(TEXT("Connections should be wrapped in the simulator"), Sim);
+    if (!Sim)
+    {
+        return false;
+    }
+
+    // A 1 KB/s uplink that position updates alone can fill
+    FSpaceTimeDBNetSimSettings Settings;
+    Settings.UpKbps = 8;
+    Sim->SetSettingsOverride(Settings);
+
+    for (int32 i = 0; i < 50 && !Manager->GetNetStats().bBackpressure; ++i)
+    {
+        Manager->UpdatePlayerPosition(FVector(i, 0, 0), FRotator::ZeroRotator);
+    }
+    TestTrue(TEXT("A full uplink should raise backpressure"), Manager->GetNetStats().bBackpressure);
+    TestTrue(TEXT("The backlog should be reported"), Manager->GetNetStats().BufferedBytesOut >= Config.BackpressureBufferedBytes);
+
+    // Positions are held and replaced; the pickup still goes straight to the socket
+    const int32 SentBefore = Manager->GetNetStats().TotalMessagesOut;
+    for (int32 i = 0; i < 5; ++i)
+    {
+        Manager->UpdatePlayerPosition(FVector(1000 + i, 0, 0), FRotator::ZeroRotator);
+    }
+    TestEqual(TEXT("Held positions should not be sent"), Manager->GetNetStats().TotalMessagesOut, SentBefore);
+    // The call that found the link full was held too, so five were replaced
+    TestEqual(TEXT("Older held positions should be dropped"), Manager->GetNetStats().StaleTelemetryDropped, 5);
+    TestEqual(TEXT("Held positions should stay queued as one call"), Manager->GetNetStats().QueuedReducerCalls, 1);
+
+    Manager->CollectWorldItem(7);
+    TestEqual(TEXT("A critical call should not wait behind telemetry"), Manager->GetNetStats().TotalMessagesOut, SentBefore + 1);
+
+    // Once the link drains, the newest position goes out and nothing else
+    Loopback->GetClientFrames().Reset();
+    Sim->Tick(60.0f);
+    TestEqual(TEXT("The link should drain"), Manager->GetNetStats().BufferedBytesOut, 0);
+    Manager->FlushOutgoingCalls();
+    TestFalse(TEXT("Backpressure should clear"), Manager->GetNetStats().bBackpressure);
+    TestEqual(TEXT("Only the newest held position should be sent"), Manager->GetNetStats().TotalMessagesOut, SentBefore + 2);
+    Sim->Tick(5.0f);
+    if (Loopback->GetClientFrames().Num() > 0)
+    {
+        const TArray<uint8>& Bytes = Loopback->GetClientFrames().Last().Bytes;
+        FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        TestTrue(TEXT("The sent position should be the newest"), FString(Text.Length(), Text.Get()).Contains(TEXT("1004")));
+    }
+
+    Manager->Disconnect();
+    return true;
+}
+
+// ============================================================================
+// BOT SWARM TESTS
+// ============================================================================
+
+bool FEonBotSwarmTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumBots = 4;
+    constexpr float Step = 0.05f;
+
+    FEonBotSwarmConfig Config;
+    Config.NumBots = NumBots;
+    Config.Connection.bBatchOutgoingCalls = false;
+    Config.PositionHz = 10.0f;
+    Config.ActionInterval = 0.5f;
+    Config.ConnectsPerSecond = 1000.0f;
+    FEonBotSwarm Swarm(Config);
+
+    // Stand-in server: one loopback per bot. Replies are queued and delivered
+    // between ticks, as a real server would answer after the frame is sent.
+    TArray<TSharedRef<FSpaceTimeDBLoopbackTransport>> Loopbacks;
+    TArray<TPair<int32, FString>> Outbox;
+    int32 PositionCalls = 0;
+    int32 InventoryCalls = 0;
+    for (int32 i = 0; i < NumBots; ++i)
+    {
+        TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+        Loopback->OnClientFrame.BindLambda([i, &Outbox, &PositionCalls, &InventoryCalls, bIdentitySent = false](TArray<uint8>& Frame, bool) mutable
+        {
+            FUTF8ToTCHAR Utf8(reinterpret_cast<const ANSICHAR*>(Frame.GetData()), Frame.Num());
+            const FString Text(Utf8.Length(), Utf8.Get());
+            const FString BotIdentity = FString::Printf(TEXT("b%d"), i);
+
+            if (!bIdentitySent)
+            {
+                Outbox.Emplace(i, FString::Printf(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"%s\",\"token\":\"t\"}"), *BotIdentity));
+                bIdentitySent = true;
+            }
+            if (Text.Contains(TEXT("create_instance")))
+            {
+                for (int32 Bot = 0; Bot < NumBots; ++Bot)
+                {
+                    Outbox.Emplace(Bot, TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"instance\",\"instance_id\":7,\"name\":\"botswarm\",\"max_players\":4,\"is_public\":true}]}"));
+                }
+            }
+            else if (Text.Contains(TEXT("join_instance")))
+            {
+                Outbox.Emplace(i, FString::Printf(TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"player\",\"identity\":\"%s\",\"instance_id\":7,\"is_online\":true}]}"), *BotIdentity));
+            }
+            else if (Text.Contains(TEXT("update_player_position")))
+            {
+                ++PositionCalls;
+                for (int32 Bot = 0; Bot < NumBots; ++Bot)
+                {
+                    Outbox.Emplace(Bot, FString::Printf(TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"player\",\"identity\":\"%s\",\"instance_id\":7,\"is_online\":true}]}"), *BotIdentity));
+                }
+            }
+            else if (Text.Contains(TEXT("add_item_to_inventory")) || Text.Contains(TEXT("use_consumable")))
+            {
+                ++InventoryCalls;
+            }
+        });
+        Loopbacks.Add(Loopback);
+    }
+    Swarm.SetTransportFactory([&Loopbacks](int32 BotIndex, const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport>
+    {
+        return Loopbacks[BotIndex];
+    });
+
+    Swarm.Start();
+    auto Run = [&](float Seconds)
+    {
+        for (float Elapsed = 0.0f; Elapsed < Seconds; Elapsed += Step)
+        {
+            Swarm.Tick(Step);
+            for (TPair<int32, FString>& Reply : TArray<TPair<int32, FString>>(MoveTemp(Outbox)))
+            {
+                Loopbacks[Reply.Key]->ServerSendText(Reply.Value);
+            }
+        }
+    };
+
+    // Connect, register, create and join
+    Run(0.5f);
+    TestTrue(TEXT("Bots should find the instance bot 0 created"), Swarm.GetTargetInstance() == TOptional<uint64>(7));
+    for (int32 i = 0; i < NumBots; ++i)
+    {
+        TestTrue(FString::Printf(TEXT("Bot %d should be in the instance"), i), Swarm.GetManager(i)->IsInInstance());
+    }
+
+    Swarm.TakeIntervalReport();
+    PositionCalls = 0;
+    Run(2.0f);
+    const FEonBotSwarmReport Report = Swarm.TakeIntervalReport();
+    AddInfo(Report.ToString());
+
+    // 4 bots x 10 Hz x 2 s, allowing a tick either side
+    TestTrue(TEXT("Position updates should follow PositionHz"), FMath::Abs(PositionCalls - 80) <= NumBots);
+    TestTrue(TEXT("Bots should use their inventory"), InventoryCalls >= NumBots);
+    TestEqual(TEXT("Every bot should count as connected"), Report.NumConnected, NumBots);
+    TestTrue(TEXT("Each client should receive every bot's position"), Report.PlayerRowsPerClientPerSecond >= 0.9 * NumBots * Config.PositionHz);
+
+    Swarm.Stop();
+    TestFalse(TEXT("Stop should close every connection"), Loopbacks[0]->IsConnected());
+    return true;
+}
+
+// ============================================================================
+// LATENCY PROBE TESTS
+// ============================================================================
+
+bool FSpaceTimeDBLatencyProbeTest::RunTest(const FString& Parameters)
+{
+    FSpaceTimeDBLatencyPercentiles Empty = FSpaceTimeDBLatencyPercentiles::FromSamples({});
+    TestEqual(TEXT("No samples"), Empty.Samples, 0);
+
+    TArray<double> Samples;
+    for (int32 i = 100; i >= 1; --i)
+    {
+        Samples.Add(i);
+    }
+    const FSpaceTimeDBLatencyPercentiles Percentiles = FSpaceTimeDBLatencyPercentiles::FromSamples(Samples);
+    TestEqual(TEXT("Samples"), Percentiles.Samples, 100);
+    TestEqual(TEXT("Mean"), Percentiles.MeanMs, 50.5);
+    TestEqual(TEXT("p50"), Percentiles.P50Ms, 51.0);
+    TestEqual(TEXT("p90"), Percentiles.P90Ms, 91.0);
+    TestEqual(TEXT("p99"), Percentiles.P99Ms, 100.0);
+    TestEqual(TEXT("Max"), Percentiles.MaxMs, 100.0);
+
+    // Matching: a repeat is not motion, a skipped send is never received, and
+    // display waits for the interpolated position to arrive
+    double Now = 0.0;
+    FSpaceTimeDBLatencyProbe& Probe = FSpaceTimeDBLatencyProbe::Get();
+    Probe.SetClock([&Now]() { return Now; });
+    Probe.Begin();
+
+    const FSpaceTimeDBIdentity Sender = FSpaceTimeDBIdentity::FromHex(TEXT("a1"));
+    const int32 Observer = 0;
+    Probe.NoteSent(Sender, FVector3f(100.0f, 0.0f, 0.0f));
+    Probe.NoteSent(Sender, FVector3f(100.0f, 0.0f, 0.0f));
+    Now = 0.1;
+    Probe.NoteSent(Sender, FVector3f(200.0f, 0.0f, 0.0f));
+    Now = 0.2;
+    Probe.NoteSent(Sender, FVector3f(300.0f, 0.0f, 0.0f));
+
+    Now = 0.25;
+    Probe.NoteReceived(&Observer, Sender, FVector3f(100.0f, 0.0f, 0.0f));
+    Probe.NoteDisplayed(&Observer, Sender, FVector(50.0, 0.0, 0.0));
+    Now = 0.35;
+    Probe.NoteReceived(&Observer, Sender, FVector3f(300.0f, 0.0f, 0.0f));
+    Now = 0.5;
+    Probe.NoteDisplayed(&Observer, Sender, FVector(299.0, 0.0, 0.0));
+
+    const FSpaceTimeDBLatencyReport Report = Probe.End();
+    Probe.SetClock(nullptr);
+    AddInfo(Report.ToString());
+
+    TestEqual(TEXT("Repeats should not count as sends"), Report.Sent, 3);
+    TestEqual(TEXT("The skipped send should not be received"), Report.Received, 2);
+    TestEqual(TEXT("Receive p50"), Report.ToReceive.P50Ms, 250.0, 0.001);
+    TestEqual(TEXT("Only the position reached counts as displayed"), Report.Displayed, 1);
+    TestEqual(TEXT("The overtaken position counts as superseded"), Report.Superseded, 1);
+    TestEqual(TEXT("Display latency runs from the send"), Report.ToDisplay.MaxMs, 300.0, 0.001);
+    TestFalse(TEXT("End should stop the probe"), FSpaceTimeDBLatencyProbe::IsActive());
+    return true;
+}
+
+bool FSpaceTimeDBMotionToDisplayTest::RunTest(const FString& Parameters)
+{
+    // Two clients in one process, each with its own connection, cache and
+    // PlayerSyncComponent, and a stand-in server relaying positions between them
+    struct FClient
+    {
+        USpaceTimeDBManager* Manager = nullptr;
+        USpaceTimeDBTableCache* Cache = nullptr;
+        UPlayerSyncComponent* Sync = nullptr;
+        TSharedPtr<FSpaceTimeDBLoopbackTransport> Loopback;
+    };
+
+    const FString Identities[] = { TEXT("a1"), TEXT("b2") };
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    TArray<FClient> Clients;
+    TArray<TPair<int32, FString>> Outbox;
+
+    auto PlayerRow = [](const FString& Identity, float X, float Y)
+    {
+        return FString::Printf(TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"player\",\"identity\":\"%s\",\"username\":\"%s\",")
+            TEXT("\"instance_id\":7,\"position_x\":%f,\"position_y\":%f,\"position_z\":0,\"is_online\":true}]}"), *Identity, *Identity, X, Y);
+    };
+
+    FSpaceTimeDBNetSimSettings Settings;
+    FSpaceTimeDBNetSimSettings::FindProfile(TEXT("LTE"), Settings);
+    Settings.DisconnectsPerMinute = 0.0f;
+
+    for (int32 i = 0; i < 2; ++i)
+    {
+        FClient& Client = Clients.AddDefaulted_GetRef();
+        Client.Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+        Client.Cache = NewObject<USpaceTimeDBTableCache>(GameInstance);
+        Client.Manager->OnServerMessage.AddUObject(Client.Cache, &USpaceTimeDBTableCache::ApplyServerMessage);
+
+        TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+        Client.Loopback = Loopback;
+        const FString Identity = Identities[i];
+        Loopback->OnClientFrame.BindLambda([&Outbox, &PlayerRow, Identity](TArray<uint8>& Frame, bool)
+        {
+            FUTF8ToTCHAR Utf8(reinterpret_cast<const ANSICHAR*>(Frame.GetData()), Frame.Num());
+            TSharedPtr<FJsonObject> Call;
+            FString Reducer;
+            const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Utf8.Length(), Utf8.Get()));
+            if (!FJsonSerializer::Deserialize(Reader, Call) || !Call.IsValid() ||
+                !Call->TryGetStringField(TEXT("call"), Reducer) || Reducer != TEXT("update_player_position"))
+            {
+                return;
+            }
+
+            // The server writes the row, and every subscriber to the instance gets it
+            const TArray<TSharedPtr<FJsonValue>>& Args = Call->GetArrayField(TEXT("args"));
+            const FString Row = PlayerRow(Identity, FCString::Atof(*Args[0]->AsString()), FCString::Atof(*Args[1]->AsString()));
+            Outbox.Emplace(0, Row);
+            Outbox.Emplace(1, Row);
+        });
+        Client.Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+        FSpaceTimeDBConfig Config;
+        Config.bUseNetworkThread = false;
+        Config.bBatchOutgoingCalls = false;
+        Client.Manager->Connect(Config);
+        if (FSpaceTimeDBNetSimTransport* Sim = Client.Manager->GetNetSim())
+        {
+            Sim->SetSettingsOverride(Settings);
+            Sim->SetSeed(11 + i);
+        }
+
+        Client.Sync = NewObject<UPlayerSyncComponent>(GameInstance);
+        Client.Sync->Bind(Client.Cache, Client.Manager);
+    }
+
+    double SimTime = 0.0;
+    constexpr float Step = 1.0f / 60.0f;
+    auto Advance = [&]()
+    {
+        SimTime += Step;
+        for (TPair<int32, FString>& Reply : TArray<TPair<int32, FString>>(MoveTemp(Outbox)))
+        {
+            Clients[Reply.Key].Loopback->ServerSendText(Reply.Value);
+        }
+        for (FClient& Client : Clients)
+        {
+            if (FSpaceTimeDBNetSimTransport* Sim = Client.Manager->GetNetSim())
+            {
+                Sim->Tick(Step);
+            }
+            Client.Sync->InterpolatePlayers(Step);
+        }
+    };
+
+    // Identities, then both players online at the origin
+    for (int32 i = 0; i < 2; ++i)
+    {
+        Clients[i].Loopback->ServerSendText(FString::Printf(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"%s\",\"token\":\"t\"}"), *Identities[i]));
+        Outbox.Emplace(0, PlayerRow(Identities[i], 0.0f, 0.0f));
+        Outbox.Emplace(1, PlayerRow(Identities[i], 0.0f, 0.0f));
+    }
+    for (int32 Frame = 0; Frame < 60; ++Frame)
+    {
+        Advance();
+    }
+    TestEqual(TEXT("B should see A"), Clients[1].Sync->GetPlayerCount(), 1);
+
+    FSpaceTimeDBLatencyProbe& Probe = FSpaceTimeDBLatencyProbe::Get();
+    Probe.SetClock([&SimTime]() { return SimTime; });
+    Probe.Begin();
+
+    // A walks in 3 m strides, stopping for a second at each, and syncs at the
+    // controller's 10 Hz like AEonPlayerController::PositionSyncInterval
+    constexpr int32 NumStrides = 8;
+    constexpr float SyncInterval = 0.1f;
+    float SinceSync = 0.0f;
+    for (int32 Frame = 0; Frame < NumStrides * 60; ++Frame)
+    {
+        SinceSync += Step;
+        if (SinceSync >= SyncInterval)
+        {
+            SinceSync = 0.0f;
+            const float X = 300.0f * (Frame / 60 + 1);
+            Clients[0].Manager->UpdatePlayerPosition(FVector(X, 0.0, 0.0), FRotator::ZeroRotator);
+        }
+        Advance();
+    }
+
+    const FSpaceTimeDBLatencyReport Report = Probe.End();
+    Probe.SetClock(nullptr);
+    AddInfo(FString::Printf(TEXT("LTE, 10 Hz sync: %s"), *Report.ToString()));
+
+    TestEqual(TEXT("Each stride is one motion"), Report.Sent, NumStrides);
+    TestEqual(TEXT("B should receive every stride"), Report.Received, NumStrides);
+    TestEqual(TEXT("B should display every stride"), Report.Displayed, NumStrides);
+    TestTrue(TEXT("Receive latency covers both directions"), Report.ToReceive.P50Ms >= 2.0 * Settings.LatencyMs);
+    TestTrue(TEXT("Display latency adds interpolation"), Report.ToDisplay.P50Ms > Report.ToReceive.P50Ms);
+    TestTrue(TEXT("B's view of A should have arrived"), Clients[1].Sync->GetDisplayLocation(FSpaceTimeDBIdentity::FromHex(TEXT("a1"))).IsSet());
+
+    for (FClient& Client : Clients)
+    {
+        Client.Sync->Unbind();
+        Client.Manager->Disconnect();
+    }
+    return true;
+}
+
+// ============================================================================
+// LOCAL AUTHORITY TESTS
+// ============================================================================
+
+bool FSpaceTimeDBLocalReducerParityTest::RunTest(const FString& Parameters)
+{
+    using FAuthority = FSpaceTimeDBLocalAuthority;
+
+    const FSpaceTimeDBIdentity Me = FSpaceTimeDBIdentity::FromHex(TEXT("c0ffee"));
+    const FSpaceTimeDBIdentity Other = FSpaceTimeDBIdentity::FromHex(TEXT("beef"));
+
+    FAuthority::FStore Store;
+    FSpaceTimeDBItemDefinitionRow Potion;
+    Potion.ItemId = TEXT("health_potion");
+    Potion.ItemType = TEXT("consumable");
+    Potion.MaxStack = 10;
+    Store.ItemDefinitions.Add(Potion.ItemId, Potion);
+    FSpaceTimeDBItemDefinitionRow Sword;
+    Sword.ItemId = TEXT("iron_sword");
+    Sword.ItemType = TEXT("weapon");
+    Sword.MaxStack = 1;
+    Store.ItemDefinitions.Add(Sword.ItemId, Sword);
+
+    FSpaceTimeDBPlayerRow Player;
+    Player.Identity = Me;
+    Player.Health = 40.0f;
+    Player.MaxHealth = 100.0f;
+    Store.Player = Player;
+
+    // add_item_to_inventory: stacks onto the existing entry, clamped at max_stack
+    FAuthority::AddItemToInventory(Store, Me, TEXT("health_potion"), 3, 1);
+    FAuthority::AddItemToInventory(Store, Me, TEXT("health_potion"), 20, 2);
+    TestEqual(TEXT("Potions should share one stack"), Store.Inventory.Num(), 1);
+    TestEqual(TEXT("Stack should clamp at max_stack"), Store.Inventory.FindRef(1).Quantity, 10u);
+
+    FAuthority::AddItemToInventory(Store, Me, TEXT("iron_sword"), 1, 3);
+    TestEqual(TEXT("New item should take the first free slot"), Store.Inventory.FindRef(3).SlotIndex, 1u);
+    FAuthority::AddItemToInventory(Store, Me, TEXT("unknown_item"), 1, 4);
+    TestFalse(TEXT("Items without a definition should be rejected"), Store.Inventory.Contains(4));
+
+    // use_consumable: heals up to max_health and spends one
+    FAuthority::UseConsumable(Store, Me, 1);
+    FAuthority::UseConsumable(Store, Me, 1);
+    TestEqual(TEXT("Health should cap at max_health"), Store.Player->Health, 100.0f);
+    TestEqual(TEXT("Each use should spend one potion"), Store.Inventory.FindRef(1).Quantity, 8u);
+    FAuthority::UseConsumable(Store, Me, 3);
+    TestTrue(TEXT("Non-consumables should not be used"), Store.Inventory.Contains(3));
+
+    // remove_item_from_inventory: owner only, and removing the whole stack deletes it
+    FAuthority::RemoveItemFromInventory(Store, Other, 1, 8);
+    TestEqual(TEXT("Other players' items should be untouched"), Store.Inventory.FindRef(1).Quantity, 8u);
+    FAuthority::RemoveItemFromInventory(Store, Me, 3, 5);
+    TestFalse(TEXT("Removing at least the quantity should delete the row"), Store.Inventory.Contains(3));
+
+    // collect_world_item: once only, stacking like an add
+    FSpaceTimeDBWorldItemRow Pickup;
+    Pickup.WorldItemId = 7;
+    Pickup.ItemId = TEXT("health_potion");
+    Pickup.Quantity = 5;
+    Store.WorldItems.Add(Pickup.WorldItemId, Pickup);
+    FAuthority::CollectWorldItem(Store, Me, 7, 5);
+    FAuthority::CollectWorldItem(Store, Me, 7, 6);
+    TestTrue(TEXT("World item should be collected"), Store.WorldItems.FindRef(7).bIsCollected);
+    TestEqual(TEXT("Collected items should stack and clamp"), Store.Inventory.FindRef(1).Quantity, 10u);
+    TestEqual(TEXT("A second collect should do nothing"), Store.Inventory.Num(), 1);
+
+    // toggle_interactable: only rows that exist
+    FSpaceTimeDBInteractableRow Door;
+    Door.InteractableId = TEXT("door_1");
+    Store.Interactables.Add(Door.InteractableId, Door);
+    FAuthority::ToggleInteractable(Store, TEXT("door_1"));
+    FAuthority::ToggleInteractable(Store, TEXT("door_2"));
+    TestTrue(TEXT("Toggle should flip is_active"), Store.Interactables.FindRef(TEXT("door_1")).bIsActive);
+    TestFalse(TEXT("Toggle should not create rows"), Store.Interactables.Contains(TEXT("door_2")));
+
+    return true;
+}
+
+bool FSpaceTimeDBLocalAuthorityReconcileTest::RunTest(const FString& Parameters)
+{
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    auto LastFrameText = [&Loopback]() -> FString
+    {
+        if (Loopback->GetClientFrames().Num() == 0)
+        {
+            return FString();
+        }
+        const TArray<uint8>& Bytes = Loopback->GetClientFrames().Last().Bytes;
+        FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        return FString(Text.Length(), Text.Get());
+    };
+
+    TArray<FSpaceTimeDBInventoryRow> Seen;
+    Manager->OnInventoryRow.AddLambda([&Seen](const FSpaceTimeDBInventoryRow& Row, ESpaceTimeDBRowOp) { Seen.Add(Row); });
+
+    // Offline: the call runs at once against the default item definitions
+    Manager->SetLocalAuthority(true);
+    Manager->AddItemToInventory(TEXT("health_potion"), 2);
+    TestEqual(TEXT("The new row should be visible before any server"), Seen.Num(), 1);
+    const uint64 LocalEntryId = Seen.Num() > 0 ? Seen[0].EntryId : 0;
+    TestTrue(TEXT("The row should carry a local entry id"), LocalEntryId >= FSpaceTimeDBLocalAuthority::LocalEntryIdBase);
+    TestEqual(TEXT("The call should wait for a connection"), Manager->GetLocalAuthority()->GetNumUnsentCalls(), 1);
+
+    FSpaceTimeDBConfig Config;
+    Config.Host = TEXT("loopback://test");
+    Config.bUseNetworkThread = false;
+    Config.bBatchOutgoingCalls = false;
+    Manager->Connect(Config);
+    Loopback->GetClientFrames().Reset();
+    Loopback->ServerSendText(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"c0ffee\",\"token\":\"t\"}"));
+
+    // The held call goes out once the server has told us who we are
+    const FString CallFrame = LastFrameText();
+    TestTrue(TEXT("The queued call should be sent"), CallFrame.Contains(TEXT("add_item_to_inventory")));
+    const int32 RequestIdAt = CallFrame.Find(TEXT("\"request_id\":"));
+    const uint32 RequestId = RequestIdAt != INDEX_NONE ? FCString::Atoi(*CallFrame + RequestIdAt + 13) : 0;
+
+    // The server answers with its own entry id; listeners keep the local one
+    Seen.Reset();
+    Loopback->ServerSendText(FString::Printf(TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"inventory_item\",\"entry_id\":41,\"owner_identity\":\"c0ffee\",\"item_id\":\"health_potion\",\"quantity\":2,\"slot_index\":0}],\"request_id\":%u,\"caller_identity\":\"c0ffee\"}"), RequestId));
+    TestEqual(TEXT("The answered call should be confirmed"), Manager->GetLocalAuthority()->GetNumPendingCalls(), 0);
+    TestTrue(TEXT("The confirmed row should keep its local id"), !Seen.ContainsByPredicate([](const FSpaceTimeDBInventoryRow& Row) { return Row.EntryId == 41; }));
+
+    // Later calls naming the local id reach the server with its id
+    Loopback->GetClientFrames().Reset();
+    Manager->UseConsumable(static_cast<int64>(LocalEntryId));
+    const FString UseFrame = LastFrameText();
+    TestTrue(TEXT("use_consumable should be sent"), UseFrame.Contains(TEXT("use_consumable")));
+    TestTrue(TEXT("The server's entry id should be sent"), UseFrame.Contains(TEXT("[41]")));
+    TestEqual(TEXT("The use should show at once"), Manager->GetLocalAuthority()->GetPredicted().Inventory.FindRef(41).Quantity, 1u);
+
+    Manager->Disconnect();
+    return true;
+}
+
+bool FSpaceTimeDBLocalAuthorityOfflineQueueTest::RunTest(const FString& Parameters)
+{
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+    Manager->SetLocalAuthority(true);
+
+    FSpaceTimeDBConfig Config;
+    Config.Host = TEXT("loopback://test");
+    Config.bUseNetworkThread = false;
+    Config.MaxQueuedCallsWhileDisconnected = 2;
+    Manager->Connect(Config);
+    Loopback->ServerSendText(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"c0ffee\",\"token\":\"t\"}"));
+
+    // The local call is handed to the manager and waits there for the batch flush
+    Manager->AddItemToInventory(TEXT("health_potion"), 2);
+    TestEqual(TEXT("The local call should be queued"), Manager->GetQueuedCallCount(), 1);
+    TestEqual(TEXT("The authority should count it as handed over"), Manager->GetLocalAuthority()->GetNumUnsentCalls(), 0);
+
+    // Offline, other calls push the queue past its bound
+    Loopback->ServerClose(TEXT("test"), false);
+    Manager->CallReducer(EonReducers::JoinInstance, 1);
+    Manager->CallReducer(EonReducers::JoinInstance, 2);
+    TestEqual(TEXT("The authority should hold the evicted call again"), Manager->GetLocalAuthority()->GetNumUnsentCalls(), 1);
+    TestEqual(TEXT("The call should still be pending"), Manager->GetLocalAuthority()->GetNumPendingCalls(), 1);
+
+    // The next connection sends it instead of rolling it back
+    Loopback->GetClientFrames().Reset();
+    Manager->Connect(Config);
+    Loopback->ServerSendText(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"c0ffee\",\"token\":\"t\"}"));
+    Manager->FlushOutgoingCalls();
+    bool bSent = false;
+    for (const FSpaceTimeDBLoopbackTransport::FFrame& Frame : Loopback->GetClientFrames())
+    {
+        FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Frame.Bytes.GetData()), Frame.Bytes.Num());
+        bSent |= FString(Text.Length(), Text.Get()).Contains(TEXT("add_item_to_inventory"));
+    }
+    TestTrue(TEXT("The held call should go out on reconnect"), bSent);
+
+    Manager->Disconnect();
+    return true;
+}
+
+// ============================================================================
+// CLOCK SYNC TESTS
+// ============================================================================
+
+bool FSpaceTimeDBClockSyncFilterTest::RunTest(const FString& Parameters)
+{
+    // The server's clock is ahead by an epoch and runs 100 ppm fast
+    auto ServerClock = [](double Local) { return 1.7e9 + 0.25 + Local * (1.0 + 100e-6); };
+
+    // 20 ms each way, plus queueing on half of the legs
+    FRandomStream Random(42);
+    auto Leg = [&Random]() { return 0.02 + (Random.FRand() < 0.5 ? Random.FRand() * 0.3 : 0.0); };
+
+    FSpaceTimeDBClockSync Clock;
+    TestFalse(TEXT("No samples, no estimate"), Clock.IsSynchronized());
+
+    for (double Local = 1000.0; Local < 1300.0; Local += 0.1)
+    {
+        const double Up = Leg();
+        const double Down = Leg();
+        Clock.AddSample(Local, Local + Up + Down, static_cast<int64>(ServerClock(Local + Up) * 1e6));
+
+        if (Local < 1005.0)
+        {
+            TestEqual(TEXT("Drift should wait for a long enough span"), Clock.GetDriftPpm(), 0.0);
+        }
+    }
+
+    TestTrue(TEXT("Samples should synchronize the clock"), Clock.IsSynchronized());
+    TestTrue(TEXT("Buckets should bound the samples kept"), Clock.GetNumSamples() <= 150);
+    TestTrue(TEXT("Server time should be within 2 ms"), FMath::Abs(Clock.ToServerTime(1300.0) - ServerClock(1300.0)) < 0.002);
+    TestTrue(TEXT("Drift should be close to 100 ppm"), FMath::Abs(Clock.GetDriftPpm() - 100.0) < 20.0);
+    TestTrue(TEXT("Uncertainty should come from the unqueued round trips"), FMath::Abs(Clock.GetUncertaintySeconds() - 0.02) < 0.001);
+    TestTrue(TEXT("Local and server time should convert both ways"), FMath::Abs(Clock.ToLocalTime(Clock.ToServerTime(1234.5)) - 1234.5) < 1e-6);
+
+    return true;
+}
+
+bool FSpaceTimeDBClockSyncManagerTest::RunTest(const FString& Parameters)
+{
+    // Both ways the JSON protocol may date a transaction
+    FSpaceTimeDBServerMessage Decoded;
+    const FTCHARToUTF8 Bare(TEXT("{\"type\":\"TransactionUpdate\",\"timestamp\":1700000000123456,\"updates\":[]}"));
+    TestTrue(TEXT("A bare timestamp should decode"), FSpaceTimeDBProtocol::DecodeJsonServerMessage(reinterpret_cast<const uint8*>(Bare.Get()), Bare.Length(), Decoded));
+    TestEqual(TEXT("Bare timestamp"), Decoded.TimestampMicros, static_cast<int64>(1700000000123456));
+    Decoded = FSpaceTimeDBServerMessage();
+    const FTCHARToUTF8 Wrapped(TEXT("{\"type\":\"TransactionUpdate\",\"timestamp\":{\"__timestamp_micros_since_unix_epoch__\":1700000000123456},\"updates\":[]}"));
+    TestTrue(TEXT("A wrapped timestamp should decode"), FSpaceTimeDBProtocol::DecodeJsonServerMessage(reinterpret_cast<const uint8*>(Wrapped.Get()), Wrapped.Length(), Decoded));
+    TestEqual(TEXT("Wrapped timestamp"), Decoded.TimestampMicros, static_cast<int64>(1700000000123456));
+
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    // Stand-in server whose clock is an hour ahead; it answers position updates with our row's last_seen
+    constexpr double ServerAheadSeconds = 3600.0;
+    Loopback->OnClientFrame.BindLambda([&Loopback](TArray<uint8>& Frame, bool)
+    {
+        FUTF8ToTCHAR Utf8(reinterpret_cast<const ANSICHAR*>(Frame.GetData()), Frame.Num());
+        const FString Text(Utf8.Length(), Utf8.Get());
+        const int32 RequestIdAt = Text.Find(TEXT("\"request_id\":"));
+        if (!Text.Contains(TEXT("update_player_position")) || RequestIdAt == INDEX_NONE)
+        {
+            return;
+        }
+        const int64 ServerMicros = static_cast<int64>((FDateTime::UtcNow().ToUnixTimestampDecimal() + ServerAheadSeconds) * 1e6);
+        Loopback->ServerSendText(FString::Printf(
+            TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[{\"table\":\"player\",\"identity\":\"c0ffee\",\"username\":\"a\",\"last_seen\":%lld}],\"request_id\":%d}"),
+            ServerMicros, FCString::Atoi(*Text + RequestIdAt + 13)));
+    });
+
+    FSpaceTimeDBConfig Config;
+    Config.Host = TEXT("loopback://test");
+    Config.bUseNetworkThread = false;
+    Config.bBatchOutgoingCalls = false;
+    Manager->Connect(Config);
+    Loopback->ServerSendText(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"c0ffee\",\"token\":\"t\"}"));
+
+    TestFalse(TEXT("No round trip yet"), Manager->IsClockSynchronized());
+    TestTrue(TEXT("Unsynchronized server time should be our UTC clock"), FMath::Abs(Manager->GetServerTime() - FDateTime::UtcNow().ToUnixTimestampDecimal()) < 1.0);
+
+    Manager->UpdatePlayerPosition(FVector::ZeroVector, FRotator::ZeroRotator);
+    TestTrue(TEXT("An answered position update should synchronize the clock"), Manager->IsClockSynchronized());
+    TestTrue(TEXT("Server time should run an hour ahead"), FMath::Abs(Manager->GetServerTime() - FDateTime::UtcNow().ToUnixTimestampDecimal() - ServerAheadSeconds) < 1.0);
+    TestEqual(TEXT("Stats should count the sample"), Manager->GetNetStats().ClockSamples, 1);
+
+    // A server timestamp from a second ago lands a second ago on the local clock
+    const int64 SecondAgo = static_cast<int64>((Manager->GetServerTime() - 1.0) * 1e6);
+    TestTrue(TEXT("Server timestamps should convert to local time"), FMath::Abs(FPlatformTime::Seconds() - Manager->ServerTimeToLocal(SecondAgo) - 1.0) < 0.01);
+
+    Manager->Disconnect();
+    return true;
+}
+
+// ============================================================================
+// ENDPOINT TESTS
+// ============================================================================
+
+namespace
+{
+    // Stand-in host: answers every subscribe with an empty transaction update
+    void AnswerSubscribes(FSpaceTimeDBLoopbackTransport* Loopback)
+    {
+        Loopback->OnClientFrame.BindLambda([Loopback](TArray<uint8>& Frame, bool)
+        {
+            FUTF8ToTCHAR Utf8(reinterpret_cast<const ANSICHAR*>(Frame.GetData()), Frame.Num());
+            if (FString(Utf8.Length(), Utf8.Get()).Contains(TEXT("\"subscribe\"")))
+            {
+                Loopback->ServerSendText(TEXT("{\"type\":\"TransactionUpdate\",\"updates\":[]}"));
+            }
+        });
+    }
+}
+
+bool FSpaceTimeDBEndpointProbeTest::RunTest(const FString& Parameters)
+{
+    // Two stand-ins 20 ms and 80 ms away, one refusing connections and one that never answers
+    const TArray<FString> Hosts = { TEXT("loopback://slow"), TEXT("loopback://refusing"), TEXT("loopback://fast"), TEXT("loopback://silent") };
+    TArray<TSharedRef<FSpaceTimeDBNetSimTransport>> Sims;
+    FSpaceTimeDBTransportFactory Factory = [&Sims](const FSpaceTimeDBTransportParams& Params) -> TSharedRef<ISpaceTimeDBTransport>
+    {
+        TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+        if (Params.Url.StartsWith(TEXT("loopback://refusing")))
+        {
+            Loopback->SetAcceptConnections(false);
+            return Loopback;
+        }
+        if (Params.Url.StartsWith(TEXT("loopback://silent")))
+        {
+            return Loopback;
+        }
+
+        AnswerSubscribes(&Loopback.Get());
+        FSpaceTimeDBNetSimSettings Settings;
+        Settings.LatencyMs = Params.Url.StartsWith(TEXT("loopback://fast")) ? 20.0f : 80.0f;
+        TSharedRef<FSpaceTimeDBNetSimTransport> Sim = MakeShared<FSpaceTimeDBNetSimTransport>(Loopback);
+        Sim->SetSettingsOverride(Settings);
+        Sims.Add(Sim);
+        return Sim;
+    };
+
+    double SimTime = 0.0;
+    int32 Completions = 0;
+    FSpaceTimeDBEndpointProbe Probe(Hosts, TEXT("eon"), false, Factory);
+    Probe.SetClock([&SimTime]() { return SimTime; });
+    Probe.SetTimeout(0.5);
+    Probe.OnComplete = [&Completions]() { ++Completions; };
+    Probe.Start();
+    TestFalse(TEXT("Delayed hosts should still be probing"), Probe.IsDone());
+
+    for (int32 Step = 0; Step < 100 && !Probe.IsDone(); ++Step)
+    {
+        SimTime += 0.01;
+        for (const TSharedRef<FSpaceTimeDBNetSimTransport>& Sim : Sims)
+        {
+            Sim->Tick(0.01f);
+        }
+        Probe.Tick();
+    }
+
+    TestTrue(TEXT("The probe should finish"), Probe.IsDone());
+    TestEqual(TEXT("Completion should be reported once"), Completions, 1);
+
+    const TArray<FSpaceTimeDBEndpointResult>& Results = Probe.GetResults();
+    TestTrue(TEXT("The fast host should be healthy"), Results[2].bHealthy);
+    TestTrue(TEXT("Its handshake should take one link delay"), FMath::Abs(Results[2].HandshakeMs - 20.0) <= 15.0);
+    TestTrue(TEXT("Its round trip should take two"), FMath::Abs(Results[2].RoundTripMs - 40.0) <= 15.0);
+    TestFalse(TEXT("A refusing host should be unhealthy"), Results[1].bHealthy);
+    TestFalse(TEXT("A silent host should be unhealthy"), Results[3].bHealthy);
+    TestEqual(TEXT("A silent host should time out"), Results[3].Error, FString(TEXT("Timed out")));
+
+    const TArray<FString> Expected = { TEXT("loopback://fast"), TEXT("loopback://slow"), TEXT("loopback://refusing"), TEXT("loopback://silent") };
+    TestTrue(TEXT("Healthy hosts should rank fastest first, then the rest in order"), Probe.GetRanking() == Expected);
+    return true;
+}
+
+bool FSpaceTimeDBEndpointFailoverTest::RunTest(const FString& Parameters)
+{
+    const FString CacheName = TEXT("EndpointFailoverTest.json");
+    const FString CachePath = FSpaceTimeDBEndpointList::ResolveCachePath(CacheName);
+    IFileManager::Get().Delete(*CachePath);
+
+    // Host a refuses; b and c both answer at once
+    TMap<FString, int32> Connections;
+    FSpaceTimeDBTransportFactory Factory = [&Connections](const FSpaceTimeDBTransportParams& Params) -> TSharedRef<ISpaceTimeDBTransport>
+    {
+        FString Host;
+        Params.Url.Split(TEXT("/database/"), &Host, nullptr);
+        Connections.FindOrAdd(Host)++;
+
+        TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+        Loopback->SetAcceptConnections(Host != TEXT("loopback://a"));
+        AnswerSubscribes(&Loopback.Get());
+        return Loopback;
+    };
+
+    FSpaceTimeDBConfig Config;
+    Config.Host = TEXT("loopback://a");
+    Config.CandidateHosts = { TEXT("loopback://b"), TEXT("loopback://c") };
+    Config.FailoverAfterErrors = 1;
+    Config.EndpointCacheFile = CacheName;
+    Config.bUseNetworkThread = false;
+    Config.bBatchOutgoingCalls = false;
+
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    Manager->SetTransportFactory(Factory);
+    Manager->Connect(Config);
+
+    TestEqual(TEXT("Every candidate should be probed"), Manager->GetEndpointProbeResults().Num(), 3);
+    TestTrue(TEXT("The manager should connect to a healthy host"), Manager->IsConnected());
+    const TArray<FString> Ranking = Manager->GetEndpointRanking();
+    TestEqual(TEXT("The refusing host should rank last"), Ranking.Last(), FString(TEXT("loopback://a")));
+    TestEqual(TEXT("The best host should be in use"), Manager->GetCurrentHost(), Ranking[0]);
+    TestTrue(TEXT("The ranking should be cached"), FPaths::FileExists(CachePath));
+
+    // One unclean drop is enough to move on to the next best host
+    if (Manager->GetNetSim())
+    {
+        Manager->GetNetSim()->SimulateDisconnect();
+        TestEqual(TEXT("A failing host should give way to the next best"), Manager->GetCurrentHost(), Ranking[1]);
+    }
+    Manager->Disconnect();
+
+    // The next session trusts the cached ranking, failover included, and probes nothing
+    Connections.Reset();
+    USpaceTimeDBManager* NextSession = NewObject<USpaceTimeDBManager>(GameInstance);
+    NextSession->SetTransportFactory(Factory);
+    NextSession->Connect(Config);
+    TestEqual(TEXT("The cached best host should be used"), NextSession->GetCurrentHost(), Ranking[1]);
+    TestEqual(TEXT("Only one host should be contacted"), Connections.Num(), 1);
+    TestEqual(TEXT("Only one connection should be opened"), Connections.FindRef(Ranking[1]), 1);
+    TestTrue(TEXT("Nothing should have been probed"), NextSession->GetEndpointProbeResults().IsEmpty());
+    NextSession->Disconnect();
+
+    IFileManager::Get().Delete(*CachePath);
+    return true;
+}
+
+// ============================================================================
+// POSITION SYNC TESTS
+// ============================================================================
+
+bool FEonDeadReckoningTest::RunTest(const FString& Parameters)
+{
+    FEonDeadReckoning Motion;
+    Motion.AddSample(FVector::ZeroVector, FRotator::ZeroRotator, 100.0);
+    Motion.AddSample(FVector(100.0, 0.0, 0.0), FRotator::ZeroRotator, 100.5);
+    TestTrue(TEXT("Velocity should come from the last two samples"), Motion.GetVelocity().Equals(FVector(200.0, 0.0, 0.0)));
+    TestTrue(TEXT("Motion should carry on between samples"), Motion.PredictLocation(100.75).Equals(FVector(150.0, 0.0, 0.0)));
+    TestTrue(TEXT("Extrapolation should stop after a while"), Motion.PredictLocation(102.0).Equals(FVector(200.0, 0.0, 0.0)));
+
+    // A reordered row is older than what is shown and changes nothing
+    Motion.AddSample(FVector(999.0, 0.0, 0.0), FRotator::ZeroRotator, 100.4);
+    TestTrue(TEXT("Older samples should be ignored"), Motion.PredictLocation(100.5).Equals(FVector(100.0, 0.0, 0.0)));
+
+    // The first step after standing still says nothing about speed
+    Motion.AddSample(FVector(200.0, 0.0, 0.0), FRotator::ZeroRotator, 105.0);
+    TestTrue(TEXT("Samples far apart should give no velocity"), Motion.PredictLocation(105.25).Equals(FVector(200.0, 0.0, 0.0)));
+
+    FEonDeadReckoning Undated;
+    Undated.AddSample(FVector::ZeroVector, FRotator::ZeroRotator, 0.0);
+    Undated.AddSample(FVector(50.0, 0.0, 0.0), FRotator::ZeroRotator, 0.0);
+    TestTrue(TEXT("Rows without last_seen should be held"), Undated.PredictLocation(1000.0).Equals(FVector(50.0, 0.0, 0.0)));
+    return true;
+}
+
+bool FEonPositionSyncGateTest::RunTest(const FString& Parameters)
+{
+    // Ten seconds standing still at 10 Hz: only the first sample and the keepalives go out
+    FEonPositionSyncGate Idle;
+    for (int32 i = 0; i < 100; ++i)
+    {
+        Idle.ShouldSend(FVector(10.0, 20.0, 0.0), FRotator(0.0, 90.0, 0.0), 1000.0 + i * 0.1);
+    }
+    TestTrue(TEXT("An idle player should send about one update per keepalive"), Idle.GetNumSent() >= 5 && Idle.GetNumSent() <= 6);
+    TestEqual(TEXT("Every other sample should be suppressed"), Idle.GetNumSuppressed(), 100 - Idle.GetNumSent());
+    TestTrue(TEXT("Turning should be sent"), Idle.ShouldSend(FVector(10.0, 20.0, 0.0), FRotator(0.0, 100.0, 0.0), 1009.95));
+
+    // Walking at 3 m/s: a receiver fed only what was sent never strays past the tolerance
+    FEonPositionSyncGate Walking;
+    FEonDeadReckoning Receiver;
+    int32 Samples = 0;
+    for (double Time = 0.0; Time <= 3.0; Time += 0.1, ++Samples)
+    {
+        const FVector Position(300.0 * Time, 0.0, 0.0);
+        if (Walking.ShouldSend(Position, FRotator::ZeroRotator, 2000.0 + Time))
+        {
+            Receiver.AddSample(Position, FRotator::ZeroRotator, 2000.0 + Time);
+        }
+        TestTrue(TEXT("The receiver's view should stay within tolerance"),
+            FVector::Dist(Receiver.PredictLocation(2000.0 + Time), Position) <= Walking.PositionTolerance + 0.01);
+    }
+    TestTrue(TEXT("Steady walking should need a fraction of the samples"), Walking.GetNumSent() * 3 < Samples);
+    TestEqual(TEXT("Sent and suppressed should cover every sample"), Walking.GetNumSent() + Walking.GetNumSuppressed(), Samples);
+    return true;
+}
+
+// ============================================================================
+// TRANSFORM CODEC TESTS
+// ============================================================================
+
+bool FEonTransformCodecRoundTripTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(25);
+    const FVector Origin(51200.0, -20480.0, 300.0);
+    double WorstPosition = 0.0;
+    double WorstYaw = 0.0;
+    double WorstPitch = 0.0;
+
+    for (int32 i = 0; i < 10000; ++i)
+    {
+        const FVector Position = Origin + FVector(Random.FRandRange(-2.0e6, 2.0e6), Random.FRandRange(-2.0e6, 2.0e6), Random.FRandRange(-5.0e5, 5.0e5));
+        const FRotator Rotation(Random.FRandRange(-90.0, 90.0), Random.FRandRange(-540.0, 540.0), 0.0);
+
+        const FEonCompactTransform Compact = FEonTransformCodec::Encode(Position, Rotation, Origin);
+        FVector DecodedPosition;
+        FRotator DecodedRotation;
+        FEonTransformCodec::Decode(Compact, DecodedPosition, DecodedRotation, Origin);
+
+        const FVector PositionError = (DecodedPosition - Position).GetAbs();
+        WorstPosition = FMath::Max(WorstPosition, PositionError.GetMax());
+        WorstYaw = FMath::Max(WorstYaw, FMath::Abs(FRotator::NormalizeAxis(DecodedRotation.Yaw - Rotation.Yaw)));
+        WorstPitch = FMath::Max(WorstPitch, FMath::Abs(DecodedRotation.Pitch - Rotation.Pitch));
+    }
+
+    AddInfo(FString::Printf(TEXT("Worst error: position %.4f cm, yaw %.5f deg, pitch %.5f deg"),
+        WorstPosition, WorstYaw, WorstPitch));
+    // Doubles on the way in carry a little rounding of their own
+    constexpr double Slack = 1e-6;
+    TestTrue(TEXT("Position error should be at most half a step"), WorstPosition <= FEonTransformCodec::MaxPositionErrorCm + Slack);
+    TestTrue(TEXT("Yaw error should be at most half a step"), WorstYaw <= FEonTransformCodec::MaxYawErrorDegrees + Slack);
+    TestTrue(TEXT("Pitch error should be at most half a step"), WorstPitch <= FEonTransformCodec::MaxPitchErrorDegrees + Slack);
+
+    // Out of range values clamp to the edge rather than wrapping around
+    const FVector Far = FEonTransformCodec::DecodePosition(FEonTransformCodec::EncodePosition(FVector(1.0e9, -1.0e9, 1.0e9)));
+    TestTrue(TEXT("Far positions should clamp"), Far.X > 2.0e6 && Far.Y < -2.0e6 && Far.Z > 5.0e5);
+    TestEqual(TEXT("Roll should not be sent"), FEonTransformCodec::DecodeOrientation(FEonTransformCodec::EncodeOrientation(FRotator(10.0, 20.0, 30.0))).Roll, 0.0);
+
+    // Server/eonserver/src/lib.rs unpacks these same words in its tests; change both together
+    TestEqual(TEXT("Origin position word"), FEonTransformCodec::EncodePosition(FVector::ZeroVector), 9223380832949895168ull);
+    TestEqual(TEXT("Position word"), FEonTransformCodec::EncodePosition(FVector(12345.67, -8910.11, 215.5)), 9227180707764252730ull);
+    TestEqual(TEXT("Clamped position word"), FEonTransformCodec::EncodePosition(FVector(1.0e9, -1.0e9, 1.0e9)), 18446726481527701503ull);
+    TestEqual(TEXT("Edge position word"), FEonTransformCodec::EncodePosition(FVector(-2097152.4, 2097151.2, -524288.0)), 17592181850112ull);
+    TestEqual(TEXT("Level orientation word"), FEonTransformCodec::EncodeOrientation(FRotator::ZeroRotator), 2147483648u);
+    TestEqual(TEXT("Orientation word"), FEonTransformCodec::EncodeOrientation(FRotator(-12.5, 137.25, 0.0)), 1849188762u);
+    TestEqual(TEXT("Looking up, yaw -90"), FEonTransformCodec::EncodeOrientation(FRotator(90.0, -90.0, 0.0)), 4294950912u);
+    TestEqual(TEXT("Looking down, yaw 359.99"), FEonTransformCodec::EncodeOrientation(FRotator(-90.0, 359.99, 0.0)), 65534u);
+
+    // Arguments on the wire: u64 + u32, against 24 bytes for six floats
+    const FEonCompactTransform AtOrigin = FEonTransformCodec::Encode(FVector::ZeroVector, FRotator::ZeroRotator);
+    TArray<uint8> Empty;
+    TArray<uint8> Frame;
+    FSpaceTimeDBProtocol::EncodeReducerCallBinary(EonReducers::UpdatePlayerTransform.Name, {}, 1, Empty);
+    FSpaceTimeDBProtocol::EncodeReducerCallBinary(EonReducers::UpdatePlayerTransform.Name,
+        EonReducers::UpdatePlayerTransform.MakeArgs(AtOrigin.Position, AtOrigin.Orientation), 1, Frame);
+    TestEqual(TEXT("A compact update should carry 12 bytes of arguments"), Frame.Num() - Empty.Num(), 12);
+    return true;
+}
+
+bool FEonTransformCodecReducerTest::RunTest(const FString& Parameters)
+{
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    FSpaceTimeDBConfig Config;
+    Config.bUseNetworkThread = false;
+    Config.bBatchOutgoingCalls = false;
+    Config.bCompactTransforms = true;
+    Manager->Connect(Config);
+    Loopback->GetClientFrames().Reset();
+
+    const FVector Position(12345.67, -8910.11, 215.5);
+    const FRotator Rotation(-12.5, 137.25, 0.0);
+    Manager->UpdatePlayerPosition(Position, Rotation);
+    TestEqual(TEXT("One call should be sent"), Loopback->GetClientFrames().Num(), 1);
+    if (Loopback->GetClientFrames().Num() != 1)
+    {
+        return false;
+    }
+
+    // The call goes out as update_player_transform and unpacks to the same transform
+    const TArray<uint8>& Bytes = Loopback->GetClientFrames()[0].Bytes;
+    FUTF8ToTCHAR Utf8(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+    TSharedPtr<FJsonObject> Call;
+    FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(Utf8.Length(), Utf8.Get())), Call);
+    if (!TestTrue(TEXT("The call should be JSON"), Call.IsValid()))
+    {
+        return false;
+    }
+    TestEqual(TEXT("Positions should use the compact reducer"), Call->GetStringField(TEXT("call")), FString(TEXT("update_player_transform")));
+    const TArray<TSharedPtr<FJsonValue>>& Args = Call->GetArrayField(TEXT("args"));
+    if (!TestEqual(TEXT("Position and orientation should be the only arguments"), Args.Num(), 2))
+    {
+        return false;
+    }
+
+    FEonCompactTransform Compact;
+    Compact.Position = FCString::Strtoui64(*Args[0]->AsString(), nullptr, 10);
+    Compact.Orientation = static_cast<uint32>(FCString::Strtoui64(*Args[1]->AsString(), nullptr, 10));
+    FVector DecodedPosition;
+    FRotator DecodedRotation;
+    FEonTransformCodec::Decode(Compact, DecodedPosition, DecodedRotation);
+    TestTrue(TEXT("The sent position should round-trip"), DecodedPosition.Equals(Position, FEonTransformCodec::MaxPositionErrorCm + 1e-6));
+    TestTrue(TEXT("The sent yaw should round-trip"), FMath::Abs(DecodedRotation.Yaw - Rotation.Yaw) <= FEonTransformCodec::MaxYawErrorDegrees + 1e-6);
+    TestTrue(TEXT("The sent pitch should round-trip"), FMath::Abs(DecodedRotation.Pitch - Rotation.Pitch) <= FEonTransformCodec::MaxPitchErrorDegrees + 1e-6);
+
+    Manager->Disconnect();
+    return true;
+}
+
+bool FEonTransformCodecLatencyProbeTest::RunTest(const FString& Parameters)
+{
+    UGameInstance* GameInstance = NewObject<UGameInstance>();
+    USpaceTimeDBManager* Manager = NewObject<USpaceTimeDBManager>(GameInstance);
+    TSharedRef<FSpaceTimeDBLoopbackTransport> Loopback = MakeShared<FSpaceTimeDBLoopbackTransport>();
+    Manager->SetTransportFactory([Loopback](const FSpaceTimeDBTransportParams&) -> TSharedRef<ISpaceTimeDBTransport> { return Loopback; });
+
+    FSpaceTimeDBConfig Config;
+    Config.bUseNetworkThread = false;
+    Config.bBatchOutgoingCalls = false;
+    Config.bCompactTransforms = true;
+    Manager->Connect(Config);
+    Loopback->ServerSendText(TEXT("{\"type\":\"IdentityToken\",\"identity\":\"a1\",\"token\":\"t\"}"));
+    Loopback->GetClientFrames().Reset();
+
+    double SimTime = 0.0;
+    FSpaceTimeDBLatencyProbe& Probe = FSpaceTimeDBLatencyProbe::Get();
+    Probe.SetClock([&SimTime]() { return SimTime; });
+    Probe.Begin();
+
+    // Off the 1 cm grid, so the row peers receive differs from what was passed in
+    const FVector Positions[] = { FVector(100.37, -20.62, 0.2), FVector(400.81, -20.62, 0.2), FVector(700.49, 15.5, 0.2) };
+    for (const FVector& Position : Positions)
+    {
+        Manager->UpdatePlayerPosition(Position, FRotator::ZeroRotator);
+        SimTime += 0.05;
+
+        // The server stores the unpacked position as floats and sends that row to every peer
+        const TArray<uint8>& Bytes = Loopback->GetClientFrames().Last().Bytes;
+        FUTF8ToTCHAR Utf8(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        TSharedPtr<FJsonObject> Call;
+        FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(Utf8.Length(), Utf8.Get())), Call);
+        if (!TestTrue(TEXT("The call should be JSON"), Call.IsValid()))
+        {
+            Probe.End();
+            Probe.SetClock(nullptr);
+            return false;
+        }
+        const uint64 Packed = FCString::Strtoui64(*Call->GetArrayField(TEXT("args"))[0]->AsString(), nullptr, 10);
+        Probe.NoteReceived(this, Manager->GetIdentity(), FVector3f(FEonTransformCodec::DecodePosition(Packed)));
+    }
+
+    const FSpaceTimeDBLatencyReport Report = Probe.End();
+    Probe.SetClock(nullptr);
+    AddInfo(FString::Printf(TEXT("Compact transforms: %s"), *Report.ToString()));
+
+    TestEqual(TEXT("Each move should be sent"), Report.Sent, 3);
+    TestEqual(TEXT("Each quantized row should match its send"), Report.Received, 3);
+    TestTrue(TEXT("Receive latency should be the simulated delay"), FMath::IsNearlyEqual(Report.ToReceive.P50Ms, 50.0, 1.0));
+
+    Manager->Disconnect();
+    return true;
+}
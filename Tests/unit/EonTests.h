@@ -157,3 +157,219 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInteractionScanTest,
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInteractionPromptTest,
     "Eon.Interaction.Prompt",
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// SPACETIMEDB PROTOCOL TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBProtocolEncodeTest,
+    "Eon.SpaceTimeDB.Protocol.EncodeCost",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBProtocolDecodeTest,
+    "Eon.SpaceTimeDB.Protocol.DecodeCost",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBJsonReaderTest,
+    "Eon.SpaceTimeDB.Protocol.JsonReader",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBRequestIdTest,
+    "Eon.SpaceTimeDB.Protocol.RequestId",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBTypedReducerTest,
+    "Eon.SpaceTimeDB.Protocol.TypedReducer",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBSchemaTest,
+    "Eon.SpaceTimeDB.Protocol.Schema",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBIdentityTest,
+    "Eon.SpaceTimeDB.Protocol.Identity",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBNetWorkerTest,
+    "Eon.SpaceTimeDB.NetWorker.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBCallBatchingTest,
+    "Eon.SpaceTimeDB.NetWorker.Batching",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// SPACETIMEDB TABLE CACHE TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBTableCacheDeltaTest,
+    "Eon.SpaceTimeDB.TableCache.Deltas",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBTableCacheSnapshotTest,
+    "Eon.SpaceTimeDB.TableCache.Snapshot",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBTableCacheTimeSliceTest,
+    "Eon.SpaceTimeDB.TableCache.TimeSliced",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBTableCacheFrameBudgetTest,
+    "Eon.SpaceTimeDB.TableCache.FrameBudget",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBTableCacheResyncTest,
+    "Eon.SpaceTimeDB.TableCache.Resync",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBTableCacheStringKeyTest,
+    "Eon.SpaceTimeDB.TableCache.StringKeys",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBInventoryBatchTest,
+    "Eon.SpaceTimeDB.Inventory.BatchApply",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBInventoryResnapshotTest,
+    "Eon.SpaceTimeDB.Inventory.Resnapshot",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// SPACETIMEDB SUBSCRIPTION TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBSubscriptionScopeTest,
+    "Eon.SpaceTimeDB.Subscriptions.InstanceScope",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// SPACETIMEDB CONNECTION TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBReconnectBackoffTest,
+    "Eon.SpaceTimeDB.Connection.ReconnectBackoff",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBLoopbackTransportTest,
+    "Eon.SpaceTimeDB.Connection.Loopback",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// SPACETIMEDB CAPTURE TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBCaptureRoundTripTest,
+    "Eon.SpaceTimeDB.Capture.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBCaptureRedactTest,
+    "Eon.SpaceTimeDB.Capture.RedactsToken",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBReplayBenchmarkTest,
+    "Eon.SpaceTimeDB.Capture.ReplayBenchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// SPACETIMEDB NETWORK SIMULATION TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBNetSimTransportTest,
+    "Eon.SpaceTimeDB.NetSim.Transport",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBNetSimSyncTest,
+    "Eon.SpaceTimeDB.NetSim.Sync",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBSendLanesTest,
+    "Eon.SpaceTimeDB.NetSim.SendLanes",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// BOT SWARM TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEonBotSwarmTest,
+    "Eon.SpaceTimeDB.BotSwarm.Loopback",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// LATENCY PROBE TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBLatencyProbeTest,
+    "Eon.SpaceTimeDB.LatencyProbe.Percentiles",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBMotionToDisplayTest,
+    "Eon.SpaceTimeDB.LatencyProbe.MotionToDisplay",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// LOCAL AUTHORITY TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBLocalReducerParityTest,
+    "Eon.SpaceTimeDB.LocalAuthority.ReducerParity",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBLocalAuthorityReconcileTest,
+    "Eon.SpaceTimeDB.LocalAuthority.Reconcile",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBLocalAuthorityOfflineQueueTest,
+    "Eon.SpaceTimeDB.LocalAuthority.OfflineQueue",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// CLOCK SYNC TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBClockSyncFilterTest,
+    "Eon.SpaceTimeDB.ClockSync.Filter",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBClockSyncManagerTest,
+    "Eon.SpaceTimeDB.ClockSync.Manager",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// ENDPOINT TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBEndpointProbeTest,
+    "Eon.SpaceTimeDB.Endpoints.Probe",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceTimeDBEndpointFailoverTest,
+    "Eon.SpaceTimeDB.Endpoints.Failover",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// POSITION SYNC TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEonDeadReckoningTest,
+    "Eon.PositionSync.DeadReckoning",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEonPositionSyncGateTest,
+    "Eon.PositionSync.Gate",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// ============================================================================
+// TRANSFORM CODEC TESTS
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEonTransformCodecRoundTripTest,
+    "Eon.TransformCodec.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEonTransformCodecReducerTest,
+    "Eon.TransformCodec.Reducer",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEonTransformCodecLatencyProbeTest,
+    "Eon.TransformCodec.LatencyProbe",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)